@@ -4,14 +4,18 @@
 #include <core/NodePath.hpp>
 #include <core/Vector2.hpp>
 #include <core/Vector3.hpp>
+#include <gen/Camera.hpp>
 #include <gen/Engine.hpp>
 #include <gen/Input.hpp>
 #include <gen/InputEventAction.hpp>
 #include <gen/MainLoop.hpp>
+#include <gen/RayCast.hpp>
 #include <gen/SceneTree.hpp>
 #include <gen/Object.hpp>
 #include <gen/Viewport.hpp>
 
+#include "memory/allocation_tracker.h"
+
 namespace gast {
 
 namespace {
@@ -29,10 +33,58 @@ jmethodID GastManager::on_render_input_hover_ = nullptr;
 jmethodID GastManager::on_render_input_press_ = nullptr;
 jmethodID GastManager::on_render_input_release_ = nullptr;
 jmethodID GastManager::on_render_input_scroll_ = nullptr;
-
-GastManager::GastManager() = default;
+jmethodID GastManager::on_render_input_gesture_ = nullptr;
+jmethodID GastManager::on_gast_node_ready_ = nullptr;
+jmethodID GastManager::on_texture_budget_decision_ = nullptr;
+
+GastManager::GastManager()
+        : gesture_recognizer_([this](const GestureEvent &gesture_event) {
+              on_render_input_gesture(gesture_event);
+          }),
+          scroll_engine_([this](const ScrollEvent &scroll_event) {
+              on_render_input_scroll(scroll_event.gast_node, scroll_event.node_path,
+                                     scroll_event.pointer_id, scroll_event.position.x,
+                                     scroll_event.position.y, scroll_event.delta.x,
+                                     scroll_event.delta.y, scroll_event.capture_timestamp_nanos);
+          }),
+          texture_memory_budget_([this](const TextureBudgetDecision &decision) {
+              on_texture_budget_decision(decision);
+          }) {
+    growth_watchdog_.add_gauge("gast_nodes", []() {
+        return GastNode::get_live_instance_count();
+    });
+    growth_watchdog_.add_gauge("gast_node_reusable_pool", [this]() {
+        return static_cast<int64_t>(reusable_pool_.size());
+    });
+    growth_watchdog_.add_gauge("gast_node_registry", [this]() {
+        return static_cast<int64_t>(node_registry_.size());
+    });
+    growth_watchdog_.add_gauge("gast_node_requests", [this]() {
+        return static_cast<int64_t>(gast_node_requests_.size());
+    });
+    growth_watchdog_.add_gauge("ray_cast_captures", [this]() {
+        return static_cast<int64_t>(ray_cast_captures_.size());
+    });
+    growth_watchdog_.add_gauge("texture_memory_records", [this]() {
+        return static_cast<int64_t>(texture_memory_budget_.get_record_count());
+    });
+    growth_watchdog_.add_gauge("input_subscriptions", [this]() {
+        return static_cast<int64_t>(input_subscribed_nodes_.size());
+    });
+    growth_watchdog_.add_gauge("gesture_pointers", [this]() {
+        return static_cast<int64_t>(gesture_recognizer_.get_pointer_count());
+    });
+    growth_watchdog_.add_gauge("scroll_pointers", [this]() {
+        return static_cast<int64_t>(scroll_engine_.get_pointer_count());
+    });
+    growth_watchdog_.add_gauge("frame_arena_bytes", [this]() {
+        return static_cast<int64_t>(frame_arena_.get_capacity());
+    });
+}
 
 GastManager::~GastManager() {
+    fail_gast_node_requests();
+    texture_atlases_.clear();
     reusable_pool_.clear();
 }
 
@@ -53,14 +105,24 @@ void GastManager::delete_singleton_instance() {
 
 void GastManager::gdn_initialize(GastLoader *gast_loader) {
     ALOG_ASSERT(gast_loader_ == nullptr, "Gast is already initialized.");
+#ifdef GAST_ASYNC_LOG_SINK
+    AsyncLogSink::start();
+#endif
     gdn_initialized_ = true;
     gast_loader_ = gast_loader;
 }
 
 void GastManager::gdn_shutdown() {
+    // Fail the in-flight requests while their nodes and the listeners are still reachable.
+    if (singleton_instance_) {
+        singleton_instance_->fail_gast_node_requests();
+    }
     gdn_initialized_ = false;
     gast_loader_ = nullptr;
     delete_singleton_instance();
+#ifdef GAST_ASYNC_LOG_SINK
+    AsyncLogSink::stop();
+#endif
 }
 
 void GastManager::jni_initialize(JNIEnv *env, jobject callback) {
@@ -82,24 +144,37 @@ void GastManager::register_callback(JNIEnv *env, jobject callback) {
     ALOG_ASSERT(callback_class != nullptr, "Invalid value for callback.");
 
     on_render_input_action_ = env->GetMethodID(callback_class, "onRenderInputAction",
-                                               "(Ljava/lang/String;IF)V");
+                                               "(Ljava/lang/String;IFJ)V");
     ALOG_ASSERT(on_render_input_action_ != nullptr, "Unable to find onRenderInputAction");
 
     on_render_input_hover_ = env->GetMethodID(callback_class, "onRenderInputHover",
-                                              "(Ljava/lang/String;Ljava/lang/String;FF)V");
+                                              "(Ljava/lang/String;Ljava/lang/String;FFJ)V");
     ALOG_ASSERT(on_render_input_hover_ != nullptr, "Unable to find onRenderInputHover");
 
     on_render_input_press_ = env->GetMethodID(callback_class, "onRenderInputPress",
-                                              "(Ljava/lang/String;Ljava/lang/String;FF)V");
+                                              "(Ljava/lang/String;Ljava/lang/String;FFJ)V");
     ALOG_ASSERT(on_render_input_press_ != nullptr, "Unable to find onRenderInputPress");
 
     on_render_input_release_ = env->GetMethodID(callback_class, "onRenderInputRelease",
-                                                "(Ljava/lang/String;Ljava/lang/String;FF)V");
+                                                "(Ljava/lang/String;Ljava/lang/String;FFJ)V");
     ALOG_ASSERT(on_render_input_release_ != nullptr, "Unable to find onRenderInputRelease");
 
     on_render_input_scroll_ = env->GetMethodID(callback_class, "onRenderInputScroll",
-                                               "(Ljava/lang/String;Ljava/lang/String;FFFF)V");
+                                               "(Ljava/lang/String;Ljava/lang/String;FFFFJ)V");
     ALOG_ASSERT(on_render_input_scroll_ != nullptr, "Unable to find onRenderInputScroll");
+
+    on_render_input_gesture_ = env->GetMethodID(callback_class, "onRenderInputGesture",
+                                                "(Ljava/lang/String;Ljava/lang/String;IFFFFJ)V");
+    ALOG_ASSERT(on_render_input_gesture_ != nullptr, "Unable to find onRenderInputGesture");
+
+    on_gast_node_ready_ = env->GetMethodID(callback_class, "onGastNodeReady", "(JJ)V");
+    ALOG_ASSERT(on_gast_node_ready_ != nullptr, "Unable to find onGastNodeReady");
+
+    on_texture_budget_decision_ = env->GetMethodID(callback_class, "onTextureBudgetDecision",
+                                                   "(JIII)V");
+    ALOG_ASSERT(on_texture_budget_decision_ != nullptr, "Unable to find onTextureBudgetDecision");
+
+    env->DeleteLocalRef(callback_class);
 }
 
 void GastManager::unregister_callback(JNIEnv *env) {
@@ -111,13 +186,16 @@ void GastManager::unregister_callback(JNIEnv *env) {
         on_render_input_press_ = nullptr;
         on_render_input_release_ = nullptr;
         on_render_input_scroll_ = nullptr;
+        on_render_input_gesture_ = nullptr;
+        on_gast_node_ready_ = nullptr;
+        on_texture_budget_decision_ = nullptr;
     }
 }
 
 void GastManager::update_node_visibility(const String &node_path, bool visible) {
     auto *node = Object::cast_to<Spatial>(get_node(node_path));
     if (!node) {
-        ALOGE("Unable to find target node with path %s", get_node_tag(node_path));
+        ALOGE("Unable to find target node with path %s", get_node_tag(node_path).get_data());
         return;
     }
 
@@ -127,17 +205,42 @@ void GastManager::update_node_visibility(const String &node_path, bool visible)
 GastNode *GastManager::get_gast_node(const godot::String &node_path) {
     auto *gast_node = Object::cast_to<GastNode>(get_node(node_path));
     if (!gast_node || !gast_node->is_in_group(kGastNodeGroupName)) {
-        ALOGW("Unable to find a GastNode node with path %s", get_node_tag(node_path));
+        ALOGW("Unable to find a GastNode node with path %s",
+              get_node_tag(node_path).get_data());
         return nullptr;
     }
 
     return gast_node;
 }
 
+int GastManager::create_texture_atlas(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        ALOGE("Invalid texture atlas dimensions: %dx%d", width, height);
+        return kInvalidTextureAtlasId;
+    }
+
+    int atlas_id = next_texture_atlas_id_++;
+    texture_atlases_[atlas_id] = std::make_unique<TextureAtlas>(width, height);
+    return atlas_id;
+}
+
+void GastManager::release_texture_atlas(int atlas_id) {
+    texture_atlases_.erase(atlas_id);
+}
+
+TextureAtlas *GastManager::get_texture_atlas(int atlas_id) {
+    auto it = texture_atlases_.find(atlas_id);
+    if (it == texture_atlases_.end()) {
+        ALOGW("Unable to find texture atlas %d", atlas_id);
+        return nullptr;
+    }
+    return it->second.get();
+}
+
 Node *GastManager::get_node(const godot::String &node_path) {
     // First search by treating the given argument as a node path since it's more efficient.
     if (node_path.empty()) {
-        ALOGE("Invalid node path argument: %s", get_node_tag(node_path));
+        ALOGE("Invalid node path argument: %s", get_node_tag(node_path).get_data());
         return nullptr;
     }
 
@@ -159,16 +262,7 @@ Node *GastManager::get_node(const godot::String &node_path) {
     return node;
 }
 
-GastNode
-*GastManager::acquire_and_bind_gast_node(const godot::String &parent_node_path, bool empty_parent) {
-    ALOGV("Retrieving node's parent with path %s", get_node_tag(parent_node_path));
-    Node *parent_node = get_node(parent_node_path);
-    if (!parent_node) {
-        ALOGE("Unable to retrieve parent node with path %s",
-              get_node_tag(parent_node_path));
-        return nullptr;
-    }
-
+GastNode *GastManager::create_or_reuse_gast_node() {
     GastNode *gast_node;
 
     // Check if we have one already setup in the reusable pool, otherwise create a new one.
@@ -185,6 +279,20 @@ GastNode
         reusable_pool_.pop_back();
     }
 
+    return gast_node;
+}
+
+bool GastManager::attach_gast_node(GastNode *gast_node, const String &parent_node_path,
+                                   bool empty_parent) {
+    ALOGV("Retrieving node's parent with path %s",
+          get_node_tag(parent_node_path).get_data());
+    Node *parent_node = get_node(parent_node_path);
+    if (!parent_node) {
+        ALOGE("Unable to retrieve parent node with path %s",
+              get_node_tag(parent_node_path).get_data());
+        return false;
+    }
+
     if (gast_node->get_parent() != nullptr) {
         ALOGV("Removing Gast node parent.");
         gast_node->get_parent()->remove_child(gast_node);
@@ -196,27 +304,193 @@ GastNode
     }
     parent_node->add_child(gast_node);
     gast_node->set_owner(parent_node);
+    return true;
+}
+
+GastNode *
+GastManager::acquire_and_bind_gast_node(const godot::String &parent_node_path, bool empty_parent) {
+    if (!get_node(parent_node_path)) {
+        ALOGE("Unable to retrieve parent node with path %s",
+              get_node_tag(parent_node_path).get_data());
+        return nullptr;
+    }
 
+    GastNode *gast_node = create_or_reuse_gast_node();
+    gast_node->setup_material();
+    attach_gast_node(gast_node, parent_node_path, empty_parent);
     return gast_node;
 }
 
+int64_t GastManager::request_gast_node(const String &parent_node_path, bool empty_parent,
+                                       bool high_priority) {
+    GastNodeRequest request = {next_gast_node_request_id_++, parent_node_path, empty_parent,
+                               high_priority, kCreateNode, nullptr};
+    if (high_priority) {
+        // Insert after the other high priority requests.
+        auto it = gast_node_requests_.begin();
+        while (it != gast_node_requests_.end() && it->high_priority) {
+            it++;
+        }
+        gast_node_requests_.insert(it, request);
+    } else {
+        gast_node_requests_.push_back(request);
+    }
+    return request.id;
+}
+
+void GastManager::cancel_gast_node_request(int64_t request_id) {
+    for (auto it = gast_node_requests_.begin(); it != gast_node_requests_.end(); it++) {
+        if (it->id == request_id) {
+            if (it->gast_node) {
+                unbind_and_release_gast_node(it->gast_node);
+            }
+            gast_node_requests_.erase(it);
+            return;
+        }
+    }
+}
+
+void GastManager::process_gast_node_requests() {
+    int64_t start_time = get_monotonic_time_nanos();
+    int steps_count = 0;
+    while (!gast_node_requests_.empty()) {
+        GastNodeRequest &request = gast_node_requests_.front();
+        // At least one step is run per frame so the requests always make progress.
+        if (!request.high_priority && steps_count > 0 &&
+            get_monotonic_time_nanos() - start_time >= gast_node_request_budget_nanos_) {
+            break;
+        }
+
+        steps_count++;
+        if (run_gast_node_request_step(request)) {
+            GastNodeRequest completed_request = request;
+            gast_node_requests_.pop_front();
+            on_gast_node_request_completed(completed_request);
+        }
+    }
+}
+
+bool GastManager::run_gast_node_request_step(GastNodeRequest &request) {
+    if (request.next_step != kCreateNode && !request.gast_node) {
+        // The node was freed while the request was in flight.
+        return true;
+    }
+
+    switch (request.next_step) {
+        case kCreateNode:
+            request.gast_node = create_or_reuse_gast_node();
+            request.next_step = kSetupMaterial;
+            return false;
+
+        case kSetupMaterial:
+            request.gast_node->setup_material();
+            request.next_step = kAttachNode;
+            return false;
+
+        case kAttachNode:
+            if (!attach_gast_node(request.gast_node, request.parent_node_path,
+                                  request.empty_parent)) {
+                unbind_and_release_gast_node(request.gast_node);
+                request.gast_node = nullptr;
+            }
+            return true;
+    }
+    return true;
+}
+
+void GastManager::on_gast_node_request_completed(const GastNodeRequest &request) {
+    if (gast_loader_) {
+        String node_path = request.gast_node ? String(request.gast_node->get_path()) : String("");
+        gast_loader_->emitGastNodeReady(request.id, node_path);
+    }
+
+    if (callback_instance_ && on_gast_node_ready_) {
+        JNIEnv *env = godot::android_api->godot_android_get_env();
+        env->CallVoidMethod(callback_instance_, on_gast_node_ready_, (jlong) request.id,
+                            (jlong) reinterpret_cast<intptr_t>(request.gast_node));
+    }
+}
+
+void GastManager::fail_gast_node_requests() {
+    while (!gast_node_requests_.empty()) {
+        GastNodeRequest request = gast_node_requests_.front();
+        gast_node_requests_.pop_front();
+        if (request.gast_node) {
+            // Not moved to the reusable pool, which doesn't outlive the manager.
+            if (request.gast_node->get_parent() != nullptr) {
+                request.gast_node->get_parent()->remove_child(request.gast_node);
+            }
+            request.gast_node->queue_free();
+            request.gast_node = nullptr;
+        }
+        on_gast_node_request_completed(request);
+    }
+}
+
 void GastManager::unbind_and_release_gast_node(GastNode *gast_node) {
     // Remove the Gast node from its parent and move it to the reusable pool.
     if (!gast_node) {
         return;
     }
 
+    texture_memory_budget_.remove_texture(gast_node);
+    input_subscribed_nodes_.erase(gast_node);
+    gast_node->clear_static_snapshot();
+    gast_node->unbind_from_shared_texture();
+    gast_node->release_shared_texture_nodes();
+
+    // Release the atlas region the node is bound to, if any.
+    if (gast_node->is_bound_to_texture_atlas()) {
+        for (auto &texture_atlas : texture_atlases_) {
+            texture_atlas.second->release_region(gast_node);
+        }
+    }
+
     // Remove the Gast node from its parent.
     if (gast_node->get_parent() != nullptr) {
         gast_node->get_parent()->remove_child(gast_node);
         gast_node->set_owner(nullptr);
     }
 
-    // Move the Gast node to the reusable pool.
+    // Move the Gast node to the reusable pool, or free it if the pool is full so a burst of
+    // releases doesn't retain its nodes for the app lifetime.
+    if (reusable_pool_.size() >= kMaxReusablePoolSize) {
+        ALOGV("Reusable pool full, freeing the Gast node.");
+        gast_node->queue_free();
+        return;
+    }
     reusable_pool_.push_back(gast_node);
 }
 
 void GastManager::on_process() {
+    frame_arena_.reset();
+    AllocationTracker::on_frame();
+
+    updated_pixels_per_frame_ = pending_updated_pixels_.exchange(0);
+
+    if (!gast_node_requests_.empty()) {
+        process_gast_node_requests();
+    }
+
+    int64_t timestamp_nanos = get_monotonic_time_nanos();
+    if (gesture_detection_enabled_) {
+        // Time based gestures (e.g: long press) are detected on frame boundaries.
+        gesture_recognizer_.on_frame(timestamp_nanos);
+    }
+    scroll_engine_.on_frame(timestamp_nanos);
+    growth_watchdog_.on_frame(timestamp_nanos);
+
+    if (texture_memory_budget_.should_evaluate(timestamp_nanos)) {
+        evaluate_texture_memory_budget(timestamp_nanos);
+    }
+
+    if (picking_mode_ == kBvhPicking) {
+        pick_ray_casts(timestamp_nanos);
+    } else if (input_sampling_mode_ == kRenderFrameSampling) {
+        sample_ray_casts(timestamp_nanos);
+    }
+    record_input_sample_age();
+
     // Check if one of the monitored input actions was dispatched.
     if (input_actions_to_monitor_.empty()) {
         return;
@@ -235,81 +509,392 @@ void GastManager::on_process() {
         }
 
         if (press_state != kInvalid) {
-            on_render_input_action(action, press_state, input->get_action_strength(action));
+            on_render_input_action(action, press_state, input->get_action_strength(action),
+                                   timestamp_nanos);
         }
     }
 }
 
-void GastManager::on_render_input_action(const String &action, InputPressState press_state, float strength) {
+void GastManager::on_render_input_action(const String &action, InputPressState press_state,
+                                         float strength, int64_t capture_timestamp_nanos) {
     if (callback_instance_ && on_render_input_action_) {
         JNIEnv *env = godot::android_api->godot_android_get_env();
-        env->CallVoidMethod(callback_instance_, on_render_input_action_,
-                            string_to_jstring(env, action), press_state, strength);
+        ScopedLocalRef<jstring> action_ref(env, string_to_jstring(env, action));
+        call_input_callback(env, on_render_input_action_, capture_timestamp_nanos,
+                            action_ref.get(), press_state, strength);
     }
 }
 
-void GastManager::on_render_input_hover(const String &node_path, const String &pointer_id,
-                                        float x_percent,
-                                        float y_percent) {
+void GastManager::on_render_input_gesture(const GestureEvent &gesture_event) {
+    if (gast_loader_) {
+        gast_loader_->emitGestureEvent(gesture_event.node_path, gesture_event.pointer_id,
+                                       gesture_event.type, gesture_event.position.x,
+                                       gesture_event.position.y, gesture_event.velocity.x,
+                                       gesture_event.velocity.y);
+    }
+
+    if (callback_instance_ && on_render_input_gesture_ &&
+        has_input_subscribers(gesture_event.gast_node)) {
+        JNIEnv *env = godot::android_api->godot_android_get_env();
+        ScopedLocalRef<jstring> node_path_ref(env,
+                                              string_to_jstring(env, gesture_event.node_path));
+        ScopedLocalRef<jstring> pointer_id_ref(env,
+                                               string_to_jstring(env, gesture_event.pointer_id));
+        call_input_callback(env, on_render_input_gesture_, gesture_event.timestamp_nanos,
+                            node_path_ref.get(), pointer_id_ref.get(), gesture_event.type,
+                            gesture_event.position.x, gesture_event.position.y,
+                            gesture_event.velocity.x, gesture_event.velocity.y);
+    }
+}
+
+void GastManager::evaluate_texture_memory_budget(int64_t timestamp_nanos) {
+    Vector3 camera_position;
+    auto *scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (scene_tree && scene_tree->get_root() && scene_tree->get_root()->get_camera()) {
+        camera_position = scene_tree->get_root()->get_camera()->get_global_transform().origin;
+    }
+
+    texture_memory_budget_.evaluate(node_registry_, camera_position, timestamp_nanos,
+                                    frame_arena_);
+}
+
+void GastManager::set_picking_mode(PickingMode picking_mode) {
+    if (picking_mode_ == picking_mode) {
+        return;
+    }
+
+    // The ray casts captured under the previous mode are released.
+    const std::vector<GastNode *> &registered_nodes = node_registry_.get_nodes();
+    FrameVector<GastNode *> gast_nodes(registered_nodes.begin(), registered_nodes.end(),
+                                       FrameArenaAllocator<GastNode *>(frame_arena_));
+    for (GastNode *gast_node : gast_nodes) {
+        gast_node->release_captured_ray_casts();
+    }
+    ray_cast_captures_.clear();
+    picking_mode_ = picking_mode;
+    last_input_sample_timestamp_nanos_ = 0;
+}
+
+void GastManager::set_input_sampling_mode(InputSamplingMode input_sampling_mode) {
+    if (input_sampling_mode_ == input_sampling_mode) {
+        return;
+    }
+
+    // Both modes run the same per-node input logic, so the captured ray casts carry over.
+    input_sampling_mode_ = input_sampling_mode;
+    last_input_sample_timestamp_nanos_ = 0;
+}
+
+void GastManager::on_gast_node_destroyed(GastNode *gast_node,
+                                         const std::vector<GastNode *> &shared_texture_nodes) {
+    // Don't use get_singleton_instance(), which would recreate the instance during the shutdown.
+    GastManager *gast_manager = singleton_instance_;
+    if (!gast_manager) {
+        return;
+    }
+
+    // The nodes sharing the destroyed node's texture revert to their own. Their shader refresh
+    // goes through get_singleton_instance(), only valid while the GDNative side is initialized.
+    if (gdn_initialized_) {
+        for (GastNode *shared_texture_node : shared_texture_nodes) {
+            shared_texture_node->on_shared_texture_source_destroyed();
+        }
+    }
+
+    gast_manager->texture_memory_budget_.remove_texture(gast_node);
+    gast_manager->input_subscribed_nodes_.erase(gast_node);
+
+    for (auto &request : gast_manager->gast_node_requests_) {
+        if (request.gast_node == gast_node) {
+            request.gast_node = nullptr;
+        }
+    }
+
+    // Return the atlas region to its atlas, which would otherwise leak the slot.
+    if (gast_node->is_bound_to_texture_atlas()) {
+        for (auto &texture_atlas : gast_manager->texture_atlases_) {
+            texture_atlas.second->release_region(gast_node);
+        }
+    }
+}
+
+void GastManager::on_ray_cast_captures_released(GastNode *gast_node) {
+    for (auto it = ray_cast_captures_.begin(); it != ray_cast_captures_.end();) {
+        if (it->second == gast_node) {
+            it = ray_cast_captures_.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+RayCastFilter &GastManager::update_ray_cast_filter() {
+    int64_t physics_frame = Engine::get_singleton()->get_physics_frames();
+    if (!ray_cast_filter_.is_up_to_date(physics_frame)) {
+        auto *scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+        ray_cast_filter_.update(
+                scene_tree ? scene_tree->get_nodes_in_group(kGastRayCasterGroupName) : Array(),
+                physics_frame);
+        last_input_sample_timestamp_nanos_ = get_monotonic_time_nanos();
+    }
+    return ray_cast_filter_;
+}
+
+bool GastManager::pick(const Vector3 &ray_origin, const Vector3 &ray_direction,
+                       float max_distance, GastNodePickResult *result) {
+    if (!result || ray_direction.length_squared() == 0 || max_distance <= 0) {
+        return false;
+    }
+
+    // The nodes moved earlier in the frame haven't been notified yet, so their transforms are read
+    // back before the refit.
+    refresh_registry_global_transforms();
+    node_bvh_.update(node_registry_);
+    if (!node_bvh_.pick(ray_origin, ray_direction.normalized(), max_distance, result)) {
+        return false;
+    }
+
+    result->uv = result->gast_node->get_relative_collision_point(result->position);
+    return true;
+}
+
+void GastManager::refresh_registry_global_transforms() {
+    const std::vector<GastNode *> &nodes = node_registry_.get_nodes();
+    const std::vector<Transform> &global_transforms = node_registry_.get_global_transforms();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        Transform global_transform = nodes[i]->get_global_transform();
+        // Only the moved nodes are marked dirty, to keep the refit incremental.
+        if (global_transform != global_transforms[i]) {
+            node_registry_.update_global_transform(*nodes[i], global_transform);
+        }
+    }
+}
+
+void GastManager::pick_ray_casts(int64_t capture_timestamp_nanos) {
+    auto *scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!scene_tree) {
+        return;
+    }
+
+    Array gast_ray_casts = scene_tree->get_nodes_in_group(kGastRayCasterGroupName);
+    if (gast_ray_casts.empty()) {
+        return;
+    }
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemScene);
+    node_bvh_.update(node_registry_);
+    last_input_sample_timestamp_nanos_ = capture_timestamp_nanos;
+
+    for (int i = 0; i < gast_ray_casts.size(); i++) {
+        RayCast *ray_cast = Object::cast_to<RayCast>(gast_ray_casts[i]);
+        if (!ray_cast || !ray_cast->is_enabled()) {
+            continue;
+        }
+
+        // The pointer ray spans the ray cast's `cast_to` vector, so the pick distance is
+        // normalized to [0, 1].
+        Transform global_transform = ray_cast->get_global_transform();
+        Vector3 origin = global_transform.origin;
+        Vector3 direction = global_transform.xform(ray_cast->get_cast_to()) - origin;
+
+        // Same mask / layer check as the RayCastFilter, for parity with the physics picking.
+        GastNodePickResult pick_result;
+        bool hit = node_bvh_.pick(origin, direction, 1.0f, &pick_result,
+                                  ray_cast->get_collision_mask());
+
+        // The node capturing the ray cast has precedence.
+        int64_t ray_cast_id = ray_cast->get_instance_id();
+        auto capture = ray_cast_captures_.find(ray_cast_id);
+        if (capture != ray_cast_captures_.end()) {
+            GastNode *captor = capture->second;
+            bool hits_captor = hit && pick_result.gast_node == captor;
+            if (captor->process_ray_cast_collision(*ray_cast, hits_captor, hit,
+                                                   pick_result.position, pick_result.normal,
+                                                   capture_timestamp_nanos)) {
+                continue;
+            }
+            ray_cast_captures_.erase(capture);
+        }
+
+        if (hit && pick_result.gast_node->process_ray_cast_collision(
+                *ray_cast, true, true, pick_result.position, pick_result.normal,
+                capture_timestamp_nanos)) {
+            ray_cast_captures_[ray_cast_id] = pick_result.gast_node;
+        }
+    }
+}
+
+void GastManager::sample_ray_casts(int64_t capture_timestamp_nanos) {
+    auto *scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+    if (!scene_tree) {
+        return;
+    }
+
+    Array gast_ray_casts = scene_tree->get_nodes_in_group(kGastRayCasterGroupName);
+    if (gast_ray_casts.empty()) {
+        return;
+    }
+
+    // Resolve the ray casts against their current transforms, rather than waiting for the next
+    // physics frame to pick up the latest controllers poses.
+    // This accesses the physics direct space state from the main thread, outside of the physics
+    // step. That's safe in Godot 3, where the 3D physics server always steps on the main thread
+    // (only the 2D server supports the multi-threaded model), and on_process() is never invoked
+    // from within the physics step, when the space is locked.
+    for (int i = 0; i < gast_ray_casts.size(); i++) {
+        RayCast *ray_cast = Object::cast_to<RayCast>(gast_ray_casts[i]);
+        if (ray_cast && ray_cast->is_enabled()) {
+            ray_cast->force_raycast_update();
+        }
+    }
+    ray_cast_filter_.update(gast_ray_casts, kUnboundPhysicsFrame);
+    last_input_sample_timestamp_nanos_ = capture_timestamp_nanos;
+
+    // The input handlers may add or remove nodes, and the registry removal swaps its entries, so
+    // iterate over a copy of the nodes. The nodes added along the way are sampled on the next
+    // frame, and the ones removed (and possibly freed) are skipped.
+    const std::vector<GastNode *> &registered_nodes = node_registry_.get_nodes();
+    FrameVector<GastNode *> gast_nodes(registered_nodes.begin(), registered_nodes.end(),
+                                       FrameArenaAllocator<GastNode *>(frame_arena_));
+    uint64_t layout_version = node_registry_.get_layout_version();
+    for (GastNode *gast_node : gast_nodes) {
+        if (node_registry_.get_layout_version() != layout_version &&
+            !node_registry_.contains(gast_node)) {
+            continue;
+        }
+        gast_node->sample_ray_casts(ray_cast_filter_, capture_timestamp_nanos);
+    }
+}
+
+void GastManager::record_input_sample_age() {
+    if (last_input_sample_timestamp_nanos_ == 0) {
+        return;
+    }
+
+    int64_t sample_age_nanos = get_monotonic_time_nanos() - last_input_sample_timestamp_nanos_;
+    if (sample_age_nanos > kMaxInputSampleAgeNanos) {
+        return;
+    }
+
+    InputLatencyStage stage =
+            picking_mode_ == kBvhPicking || input_sampling_mode_ == kRenderFrameSampling
+            ? kInputLatencyStageRenderFrameSampleAge
+            : kInputLatencyStagePhysicsTickSampleAge;
+    input_latency_tracker_.record(stage, sample_age_nanos);
+}
+
+void GastManager::on_texture_budget_decision(const TextureBudgetDecision &decision) {
+    if (gast_loader_) {
+        gast_loader_->emitTextureBudgetDecision(decision.gast_node->get_path(), decision.action,
+                                                decision.width, decision.height);
+    }
+
+    if (callback_instance_ && on_texture_budget_decision_) {
+        JNIEnv *env = godot::android_api->godot_android_get_env();
+        env->CallVoidMethod(callback_instance_, on_texture_budget_decision_,
+                            (jlong) reinterpret_cast<intptr_t>(decision.gast_node),
+                            decision.action, decision.width, decision.height);
+    }
+}
+
+void GastManager::on_render_input_hover(const GastNode *gast_node, const String &node_path,
+                                        const String &pointer_id, float x_percent,
+                                        float y_percent, int64_t capture_timestamp_nanos) {
     if (gast_loader_) {
         gast_loader_->emitHoverEvent(node_path, pointer_id, x_percent, y_percent);
     }
 
-    if (callback_instance_ && on_render_input_hover_) {
+    if (gesture_detection_enabled_) {
+        gesture_recognizer_.on_hover(gast_node, node_path, pointer_id,
+                                     Vector2(x_percent, y_percent), capture_timestamp_nanos);
+    }
+
+    if (callback_instance_ && on_render_input_hover_ && has_input_subscribers(gast_node)) {
         JNIEnv *env = godot::android_api->godot_android_get_env();
-        env->CallVoidMethod(callback_instance_, on_render_input_hover_,
-                            string_to_jstring(env, node_path), string_to_jstring(env, pointer_id),
-                            x_percent, y_percent);
+        ScopedLocalRef<jstring> node_path_ref(env, string_to_jstring(env, node_path));
+        ScopedLocalRef<jstring> pointer_id_ref(env, string_to_jstring(env, pointer_id));
+        call_input_callback(env, on_render_input_hover_, capture_timestamp_nanos,
+                            node_path_ref.get(), pointer_id_ref.get(), x_percent, y_percent);
     }
 }
 
-void GastManager::on_render_input_press(const String &node_path, const String &pointer_id,
-                                        float x_percent,
-                                        float y_percent) {
+void GastManager::on_render_input_press(const GastNode *gast_node, const String &node_path,
+                                        const String &pointer_id, float x_percent,
+                                        float y_percent, int64_t capture_timestamp_nanos) {
     if (gast_loader_) {
         gast_loader_->emitPressEvent(node_path, pointer_id, x_percent, y_percent);
     }
 
-    if (callback_instance_ && on_render_input_press_) {
+    if (gesture_detection_enabled_) {
+        gesture_recognizer_.on_press(gast_node, node_path, pointer_id,
+                                     Vector2(x_percent, y_percent), capture_timestamp_nanos);
+    }
+
+    if (callback_instance_ && on_render_input_press_ && has_input_subscribers(gast_node)) {
         JNIEnv *env = godot::android_api->godot_android_get_env();
-        env->CallVoidMethod(callback_instance_, on_render_input_press_,
-                            string_to_jstring(env, node_path), string_to_jstring(env, pointer_id),
-                            x_percent, y_percent);
+        ScopedLocalRef<jstring> node_path_ref(env, string_to_jstring(env, node_path));
+        ScopedLocalRef<jstring> pointer_id_ref(env, string_to_jstring(env, pointer_id));
+        call_input_callback(env, on_render_input_press_, capture_timestamp_nanos,
+                            node_path_ref.get(), pointer_id_ref.get(), x_percent, y_percent);
     }
 }
 
-void GastManager::on_render_input_release(const String &node_path, const String &pointer_id,
-                                          float x_percent,
-                                          float y_percent) {
+void GastManager::on_render_input_release(const GastNode *gast_node, const String &node_path,
+                                          const String &pointer_id, float x_percent,
+                                          float y_percent, int64_t capture_timestamp_nanos) {
     if (gast_loader_) {
         gast_loader_->emitReleaseEvent(node_path, pointer_id, x_percent, y_percent);
     }
 
-    if (callback_instance_ && on_render_input_release_) {
+    if (gesture_detection_enabled_) {
+        gesture_recognizer_.on_release(gast_node, node_path, pointer_id,
+                                       Vector2(x_percent, y_percent), capture_timestamp_nanos);
+    }
+
+    if (callback_instance_ && on_render_input_release_ && has_input_subscribers(gast_node)) {
         JNIEnv *env = godot::android_api->godot_android_get_env();
-        env->CallVoidMethod(callback_instance_, on_render_input_release_,
-                            string_to_jstring(env, node_path), string_to_jstring(env, pointer_id),
-                            x_percent, y_percent);
+        ScopedLocalRef<jstring> node_path_ref(env, string_to_jstring(env, node_path));
+        ScopedLocalRef<jstring> pointer_id_ref(env, string_to_jstring(env, pointer_id));
+        call_input_callback(env, on_render_input_release_, capture_timestamp_nanos,
+                            node_path_ref.get(), pointer_id_ref.get(), x_percent, y_percent);
     }
 }
 
-void GastManager::on_render_input_scroll(const godot::String &node_path,
-                                         const godot::String &pointer_id, float x_percent,
+void GastManager::on_render_input_scroll(const GastNode *gast_node, const String &node_path,
+                                         const String &pointer_id, float x_percent,
                                          float y_percent, float horizontal_delta,
-                                         float vertical_delta) {
+                                         float vertical_delta, int64_t capture_timestamp_nanos) {
     if (gast_loader_) {
         gast_loader_->emitScrollEvent(node_path, pointer_id, x_percent, y_percent, horizontal_delta,
                                       vertical_delta);
     }
 
-    if (callback_instance_ && on_render_input_scroll_) {
+    if (callback_instance_ && on_render_input_scroll_ && has_input_subscribers(gast_node)) {
         JNIEnv *env = godot::android_api->godot_android_get_env();
-        env->CallVoidMethod(callback_instance_, on_render_input_scroll_,
-                            string_to_jstring(env, node_path), string_to_jstring(env, pointer_id),
-                            x_percent, y_percent, horizontal_delta, vertical_delta);
+        ScopedLocalRef<jstring> node_path_ref(env, string_to_jstring(env, node_path));
+        ScopedLocalRef<jstring> pointer_id_ref(env, string_to_jstring(env, pointer_id));
+        call_input_callback(env, on_render_input_scroll_, capture_timestamp_nanos,
+                            node_path_ref.get(), pointer_id_ref.get(), x_percent, y_percent,
+                            horizontal_delta, vertical_delta);
     }
 }
 
+void GastManager::on_render_input_scroll_action(const GastNode *gast_node,
+                                                const String &node_path,
+                                                const String &pointer_id, float x_percent,
+                                                float y_percent, float horizontal_strength,
+                                                float vertical_strength,
+                                                int64_t capture_timestamp_nanos) {
+    scroll_engine_.on_scroll(gast_node, node_path, pointer_id, Vector2(x_percent, y_percent),
+                             Vector2(horizontal_strength, vertical_strength),
+                             capture_timestamp_nanos);
+}
+
+void GastManager::on_render_input_scroll_released(const String &node_path,
+                                                  const String &pointer_id) {
+    scroll_engine_.on_scroll_released(node_path, pointer_id);
+}
+
 bool GastManager::update_gast_node_parent(GastNode *node,
                                           const String &new_parent_node_path, bool empty_parent) {
     if (!node) {
@@ -330,7 +915,7 @@ bool GastManager::update_gast_node_parent(GastNode *node,
     Node *new_parent = get_node(new_parent_node_path);
     if (!new_parent) {
         ALOGW("Unable to retrieve new parent node with path %s",
-              get_node_tag(new_parent_node_path));
+              get_node_tag(new_parent_node_path).get_data());
         return false;
     }
 
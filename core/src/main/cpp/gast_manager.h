@@ -6,11 +6,27 @@
 #include <core/Vector3.hpp>
 #include <gen/Node.hpp>
 #include <gen/Spatial.hpp>
+#include <atomic>
+#include <deque>
 #include <jni.h>
 #include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
 
 #include "gdn/gast_loader.h"
 #include "gdn/gast_node.h"
+#include "input/gesture_recognizer.h"
+#include "input/input_latency_tracker.h"
+#include "input/scroll_engine.h"
+#include "memory/frame_arena.h"
+#include "memory/growth_watchdog.h"
+#include "scene/gast_node_bvh.h"
+#include "scene/gast_node_registry.h"
+#include "scene/ray_cast_filter.h"
+#include "texture/texture_atlas.h"
+#include "texture/texture_memory_budget.h"
 #include "utils.h"
 
 namespace gast {
@@ -21,6 +37,17 @@ using namespace godot;
 // Name of the group containing the RayCast nodes that interact with the Gast nodes.
 const char *kGastRayCasterGroupName = "gast_ray_caster";
 
+constexpr int kInvalidTextureAtlasId = 0;
+
+constexpr int64_t kInvalidGastNodeRequestId = 0;
+// Default per-frame time budget for the asynchronous Gast node requests.
+constexpr int64_t kDefaultGastNodeRequestBudgetNanos = 2000000;
+// Released Gast nodes past this count are freed instead of being pooled for reuse.
+constexpr size_t kMaxReusablePoolSize = 8;
+// Pointer samples older than this aren't recorded in the sample age latency stages, e.g: when no
+// ray cast or collidable Gast node is left in the scene.
+constexpr int64_t kMaxInputSampleAgeNanos = 100 * 1000000LL;
+
 /// Mirrors src/main/java/org/godotengine/plugin/gast/input/GastInputListener#InputPressState
 enum InputPressState {
     kInvalid = -1,
@@ -28,8 +55,27 @@ enum InputPressState {
     kPressed = 1,
     kJustReleased = 2
 };
+
 }  // namespace
 
+/// Mirrors src/main/java/org/godotengine/plugin/gast/GastManager#PickingMode
+enum PickingMode {
+    // The ray casts are resolved by the physics engine, and processed by each Gast node.
+    kPhysicsPicking = 0,
+    // The ray casts are resolved against the Gast nodes bounding volume hierarchy, once per
+    // rendered frame. Occluders other than the Gast nodes are ignored.
+    kBvhPicking = 1,
+};
+
+/// Mirrors src/main/java/org/godotengine/plugin/gast/GastManager#InputSamplingMode
+enum InputSamplingMode {
+    // The ray casts are sampled by each Gast node on every physics frame.
+    kPhysicsTickSampling = 0,
+    // The ray casts are sampled once per rendered frame, from their latest transforms. Only
+    // applies to kPhysicsPicking: kBvhPicking always samples once per rendered frame.
+    kRenderFrameSampling = 1,
+};
+
 class GastManager {
 public:
     static GastManager *get_singleton_instance();
@@ -44,17 +90,40 @@ public:
 
     void on_process();
 
-    void on_render_input_hover(const String &node_path, const String &pointer_id, float x_percent,
-                               float y_percent);
-
-    void on_render_input_press(const String &node_path, const String &pointer_id, float x_percent,
-                               float y_percent);
-
-    void on_render_input_release(const String &node_path, const String &pointer_id, float x_percent,
-                                 float y_percent);
-
-    void on_render_input_scroll(const String &node_path, const String &pointer_id, float x_percent,
-                                float y_percent, float horizontal_delta, float vertical_delta);
+    /// The input events carry the monotonic timestamp (see get_monotonic_time_nanos()) at which
+    /// the input was captured, i.e: when the ray casts or input events were sampled. It's
+    /// forwarded to the Kotlin listeners, and used to measure the input latency.
+    /// `gast_node` is the node the event is dispatched for, at `node_path`.
+    void on_render_input_hover(const GastNode *gast_node, const String &node_path,
+                               const String &pointer_id, float x_percent, float y_percent,
+                               int64_t capture_timestamp_nanos);
+
+    void on_render_input_press(const GastNode *gast_node, const String &node_path,
+                               const String &pointer_id, float x_percent, float y_percent,
+                               int64_t capture_timestamp_nanos);
+
+    void on_render_input_release(const GastNode *gast_node, const String &node_path,
+                                 const String &pointer_id, float x_percent, float y_percent,
+                                 int64_t capture_timestamp_nanos);
+
+    void on_render_input_scroll(const GastNode *gast_node, const String &node_path,
+                                const String &pointer_id, float x_percent, float y_percent,
+                                float horizontal_delta, float vertical_delta,
+                                int64_t capture_timestamp_nanos);
+
+    /// Report the scroll action strengths held by the given pointer. The scroll engine turns
+    /// them into at most one scroll event per frame.
+    void on_render_input_scroll_action(const GastNode *gast_node, const String &node_path,
+                                       const String &pointer_id, float x_percent,
+                                       float y_percent, float horizontal_strength,
+                                       float vertical_strength, int64_t capture_timestamp_nanos);
+
+    /// Report that the given pointer no longer holds a scroll action.
+    void on_render_input_scroll_released(const String &node_path, const String &pointer_id);
+
+    void set_scroll_settings(const ScrollSettings &settings) {
+        scroll_engine_.set_settings(settings);
+    }
 
     /// Create a Gast node with the given parent node and set it up.
     /// @return The newly created Gast node
@@ -67,6 +136,22 @@ public:
     bool update_gast_node_parent(GastNode *gast_node, const String &new_parent_node_path,
                                    bool empty_parent);
 
+    /// Asynchronously create a Gast node with the given parent node and set it up.
+    ///
+    /// The construction steps are spread over frames within the per-frame time budget. High
+    /// priority requests skip ahead of the queue and complete on the next frame regardless of the
+    /// budget. Completion is signaled to GDScript and Kotlin along with the request id.
+    /// @return Id of the request
+    int64_t request_gast_node(const String &parent_node_path, bool empty_parent,
+                              bool high_priority);
+
+    /// Cancel the given request. No-op if the request has already completed.
+    void cancel_gast_node_request(int64_t request_id);
+
+    void set_gast_node_request_budget_nanos(int64_t budget_nanos) {
+        gast_node_request_budget_nanos_ = budget_nanos;
+    }
+
     void reset_monitored_input_actions() {
         input_actions_to_monitor_.clear();
     }
@@ -75,11 +160,120 @@ public:
         input_actions_to_monitor_.push_back(input_action);
     }
 
+    /// Reset the input subscriptions mirrored from the Kotlin listeners registry.
+    /// @param has_unscoped_listeners Whether some Kotlin listeners receive the input events of all
+    /// nodes. If not, the input events are only forwarded for the subscribed nodes.
+    void reset_input_subscriptions(bool has_unscoped_listeners) {
+        has_unscoped_input_listeners_ = has_unscoped_listeners;
+        input_subscribed_nodes_.clear();
+    }
+
+    /// Subscribe the given node, which is tracked by identity so the subscription survives its
+    /// renames and reparenting.
+    void add_input_subscribed_node(const GastNode *gast_node) {
+        input_subscribed_nodes_.insert(gast_node);
+    }
+
+    /// Enable / disable the native gesture detection stage on behalf of the Kotlin listeners.
+    void set_jni_gesture_detection_enabled(bool enabled) {
+        jni_gesture_detection_enabled_ = enabled;
+        update_gesture_detection();
+    }
+
+    /// Enable / disable the native gesture detection stage on behalf of the GDScript listeners.
+    void set_gdn_gesture_detection_enabled(bool enabled) {
+        gdn_gesture_detection_enabled_ = enabled;
+        update_gesture_detection();
+    }
+
+    bool is_gesture_detection_enabled() const {
+        return gesture_detection_enabled_;
+    }
+
     void update_node_visibility(const String &node_path, bool visible);
 
     GastNode *get_gast_node(const String &node_path);
 
+    /// Create a texture atlas with the given dimensions.
+    /// @return Id of the newly created atlas, or kInvalidTextureAtlasId on failure.
+    int create_texture_atlas(int width, int height);
+
+    /// Release the given texture atlas. The nodes bound to it revert to their own texture.
+    void release_texture_atlas(int atlas_id);
+
+    TextureAtlas *get_texture_atlas(int atlas_id);
+
+    TextureMemoryBudget &get_texture_memory_budget() {
+        return texture_memory_budget_;
+    }
+
+    /// Registry of the hot state of the Gast nodes in the scene tree.
+    GastNodeRegistry &get_node_registry() {
+        return node_registry_;
+    }
+
+    /// Select how the ray casts in the kGastRayCasterGroupName group are resolved.
+    void set_picking_mode(PickingMode picking_mode);
+
+    PickingMode get_picking_mode() const {
+        return picking_mode_;
+    }
+
+    /// Select how often the ray casts are sampled for the physics picking mode.
+    void set_input_sampling_mode(InputSamplingMode input_sampling_mode);
+
+    InputSamplingMode get_input_sampling_mode() const {
+        return input_sampling_mode_;
+    }
+
+    /// Record pixels updated in the Gast nodes textures. Can be invoked from any thread.
+    void record_updated_pixels(int64_t pixels) {
+        pending_updated_pixels_ += pixels;
+    }
+
+    /// Number of Gast nodes texture pixels updated during the last frame.
+    int64_t get_updated_pixels_per_frame() const {
+        return updated_pixels_per_frame_;
+    }
+
+    /// Find the closest visible, collidable Gast node hit by the ray from `ray_origin` along
+    /// `ray_direction`, within `max_distance`. The query runs synchronously against the nodes'
+    /// current transforms and sizes, without going through the physics engine, so it doesn't
+    /// wait for the next physics frame. The distance is in world units.
+    /// @return true on hit, with `result` filled appropriately.
+    bool pick(const Vector3 &ray_origin, const Vector3 &ray_direction, float max_distance,
+              GastNodePickResult *result);
+
+    /// Pre-filter of the (ray cast, Gast node) pairs for the physics picking mode, as last
+    /// updated. Reading it has no side effect, so it's safe for the stats getters.
+    const RayCastFilter &get_ray_cast_filter() const {
+        return ray_cast_filter_;
+    }
+
+    /// Latencies of the native input stages.
+    InputLatencyTracker &get_input_latency_tracker() {
+        return input_latency_tracker_;
+    }
+
+    /// Watchdog of the long lived Gast resources, sampled on each frame.
+    const GrowthWatchdog &get_growth_watchdog() const {
+        return growth_watchdog_;
+    }
+
+    /// Invoked when the given node releases its captured ray casts.
+    void on_ray_cast_captures_released(GastNode *gast_node);
+
+    /// Invoked from the destructor of the given node, which may be freed along its scene or by
+    /// queue_free() rather than through unbind_and_release_gast_node(). Drops the state still
+    /// keyed by the node, and refreshes the nodes which were sharing its texture. No-op if the
+    /// singleton instance doesn't exist.
+    static void on_gast_node_destroyed(GastNode *gast_node,
+                                       const std::vector<GastNode *> &shared_texture_nodes);
+
 private:
+    // Only the nodes' _physics_process updates the ray cast filter.
+    friend class GastNode;
+
     static void delete_singleton_instance();
 
     static void register_callback(JNIEnv *env, jobject callback);
@@ -100,16 +294,132 @@ private:
         }
     }
 
-    void on_render_input_action(const String &action, InputPressState press_state, float strength);
+    void on_render_input_action(const String &action, InputPressState press_state, float strength,
+                                int64_t capture_timestamp_nanos);
+
+    void on_render_input_gesture(const GestureEvent &gesture_event);
+
+    void on_texture_budget_decision(const TextureBudgetDecision &decision);
+
+    void evaluate_texture_memory_budget(int64_t timestamp_nanos);
+
+    // Resolve the ray casts against the Gast nodes bounding volume hierarchy.
+    void pick_ray_casts(int64_t capture_timestamp_nanos);
+
+    // Update the registry with the nodes' current global transforms. The registry is otherwise
+    // only updated on NOTIFICATION_TRANSFORM_CHANGED, which is deferred to the end of the frame.
+    void refresh_registry_global_transforms();
+
+    // Resolve the ray casts from their latest transforms, and run the Gast nodes input logic.
+    // Used for kRenderFrameSampling.
+    void sample_ray_casts(int64_t capture_timestamp_nanos);
+
+    // Record the age of the latest pointer sample for the rendered frame.
+    void record_input_sample_age();
+
+    // Invoke the given input callback on the Kotlin side, and record the latency of the native
+    // input stages.
+    template<typename... Args>
+    void call_input_callback(JNIEnv *env, jmethodID callback, int64_t capture_timestamp_nanos,
+                             Args... args) {
+        int64_t dispatch_timestamp_nanos = get_monotonic_time_nanos();
+        input_latency_tracker_.record(kInputLatencyStageNativeDispatch,
+                                      dispatch_timestamp_nanos - capture_timestamp_nanos);
+        env->CallVoidMethod(callback_instance_, callback, args..., (jlong) capture_timestamp_nanos);
+        input_latency_tracker_.record(kInputLatencyStageJniCallback,
+                                      get_monotonic_time_nanos() - dispatch_timestamp_nanos);
+    }
+
+    // Whether the input events for the given node should be forwarded to the Kotlin listeners.
+    inline bool has_input_subscribers(const GastNode *gast_node) const {
+        return has_unscoped_input_listeners_ ||
+               input_subscribed_nodes_.find(gast_node) != input_subscribed_nodes_.end();
+    }
+
+    inline void update_gesture_detection() {
+        bool enabled = jni_gesture_detection_enabled_ || gdn_gesture_detection_enabled_;
+        if (gesture_detection_enabled_ == enabled) {
+            return;
+        }
+        gesture_detection_enabled_ = enabled;
+        gesture_recognizer_.reset();
+    }
 
     Node *get_node(const String &node_path);
 
+    // Bring the ray cast filter up to date with the 'gast_ray_caster' group on the first access of
+    // each physics frame. For kRenderFrameSampling, it's instead updated once per rendered frame
+    // by sample_ray_casts().
+    RayCastFilter &update_ray_cast_filter();
+
+    GastNode *create_or_reuse_gast_node();
+
+    bool attach_gast_node(GastNode *gast_node, const String &parent_node_path, bool empty_parent);
+
+    enum GastNodeRequestStep {
+        kCreateNode,
+        kSetupMaterial,
+        kAttachNode,
+    };
+
+    struct GastNodeRequest {
+        int64_t id;
+        String parent_node_path;
+        bool empty_parent;
+        bool high_priority;
+        GastNodeRequestStep next_step;
+        GastNode *gast_node;
+    };
+
+    void process_gast_node_requests();
+
+    // Run the next construction step of the given request. Returns true when it's complete.
+    bool run_gast_node_request_step(GastNodeRequest &request);
+
+    void on_gast_node_request_completed(const GastNodeRequest &request);
+
+    // Complete the in-flight requests with a failure, freeing the nodes they hold.
+    void fail_gast_node_requests();
+
     GastManager();
 
     ~GastManager();
 
+    // Released Gast nodes kept for reuse, up to kMaxReusablePoolSize.
     std::list<GastNode *> reusable_pool_;
+    GastNodeRegistry node_registry_;
+    PickingMode picking_mode_ = kPhysicsPicking;
+    InputSamplingMode input_sampling_mode_ = kPhysicsTickSampling;
+    // Timestamp of the latest ray casts sampling, or 0 if none was taken in the current mode.
+    int64_t last_input_sample_timestamp_nanos_ = 0;
+    GastNodeBvh node_bvh_;
+    RayCastFilter ray_cast_filter_;
+    // Transient containers of the frame (ray cast sampling, texture budget ranking), reset at the
+    // start of on_process().
+    FrameArena frame_arena_;
+    // Gast node capturing each ray cast, keyed by the ray cast instance id. Only used for
+    // kBvhPicking.
+    std::map<int64_t, GastNode *> ray_cast_captures_;
+    // Pixels updated since the last frame, recorded from the producers threads.
+    std::atomic<int64_t> pending_updated_pixels_{0};
+    int64_t updated_pixels_per_frame_ = 0;
+    std::map<int, std::unique_ptr<TextureAtlas>> texture_atlases_;
+    int next_texture_atlas_id_ = kInvalidTextureAtlasId + 1;
+    std::deque<GastNodeRequest> gast_node_requests_;
+    int64_t next_gast_node_request_id_ = kInvalidGastNodeRequestId + 1;
+    int64_t gast_node_request_budget_nanos_ = kDefaultGastNodeRequestBudgetNanos;
     std::list<String> input_actions_to_monitor_;
+    bool has_unscoped_input_listeners_ = true;
+    std::set<const GastNode *> input_subscribed_nodes_;
+
+    bool gesture_detection_enabled_ = false;
+    bool jni_gesture_detection_enabled_ = false;
+    bool gdn_gesture_detection_enabled_ = false;
+    GestureRecognizer gesture_recognizer_;
+    ScrollEngine scroll_engine_;
+    TextureMemoryBudget texture_memory_budget_;
+    GrowthWatchdog growth_watchdog_;
+    InputLatencyTracker input_latency_tracker_;
 
     static GastManager *singleton_instance_;
     static GastLoader *gast_loader_;
@@ -122,6 +432,9 @@ private:
     static jmethodID on_render_input_press_;
     static jmethodID on_render_input_release_;
     static jmethodID on_render_input_scroll_;
+    static jmethodID on_render_input_gesture_;
+    static jmethodID on_gast_node_ready_;
+    static jmethodID on_texture_budget_decision_;
 };
 }  // namespace gast
 
@@ -1,5 +1,6 @@
 #include "gast_loader.h"
 #include <gast_manager.h>
+#include <memory/allocation_tracker.h>
 
 namespace gast {
 
@@ -8,6 +9,13 @@ const char *kHoverInputEvent = "hover_input_event";
 const char *kPressInputEvent = "press_input_event";
 const char *kReleaseInputEvent = "release_input_event";
 const char *kScrollInputEvent = "scroll_input_event";
+const char *kGestureInputEvent = "gesture_input_event";
+const char *kBatchedInputEvents = "batched_input_events";
+const char *kGastNodeReady = "gast_node_ready";
+const char *kTextureBudgetDecision = "texture_budget_decision";
+
+// Rate at which the input signals connections are polled, when not explicitly refreshed.
+constexpr int kSignalConnectionsPollIntervalFrames = 60;
 }
 
 GastLoader::GastLoader() {}
@@ -21,6 +29,33 @@ void GastLoader::_register_methods() {
     register_method("initialize", &GastLoader::initialize);
     register_method("shutdown", &GastLoader::shutdown);
     register_method("on_process", &GastLoader::on_process);
+    register_method("refresh_signal_connections", &GastLoader::refresh_signal_connections);
+    register_method("set_gesture_detection_enabled", &GastLoader::set_gesture_detection_enabled);
+    register_method("request_gast_node", &GastLoader::request_gast_node);
+    register_method("cancel_gast_node_request", &GastLoader::cancel_gast_node_request);
+    register_method("set_gast_node_request_budget_nanos",
+                    &GastLoader::set_gast_node_request_budget_nanos);
+    register_method("set_texture_memory_budget", &GastLoader::set_texture_memory_budget);
+    register_method("get_texture_memory_usage", &GastLoader::get_texture_memory_usage);
+    register_method("get_texture_memory_decisions", &GastLoader::get_texture_memory_decisions);
+    register_method("set_scroll_settings", &GastLoader::set_scroll_settings);
+    register_method("get_updated_pixels_per_frame", &GastLoader::get_updated_pixels_per_frame);
+    register_method("set_picking_mode", &GastLoader::set_picking_mode);
+    register_method("get_picking_mode", &GastLoader::get_picking_mode);
+    register_method("set_input_sampling_mode", &GastLoader::set_input_sampling_mode);
+    register_method("get_input_sampling_mode", &GastLoader::get_input_sampling_mode);
+    register_method("pick", &GastLoader::pick);
+    register_method("get_tested_ray_cast_pairs_per_frame",
+                    &GastLoader::get_tested_ray_cast_pairs_per_frame);
+    register_method("get_culled_ray_cast_pairs_per_frame",
+                    &GastLoader::get_culled_ray_cast_pairs_per_frame);
+    register_method("get_heap_allocations_per_frame",
+                    &GastLoader::get_heap_allocations_per_frame);
+    register_method("get_heap_allocations_per_subsystem",
+                    &GastLoader::get_heap_allocations_per_subsystem);
+    register_method("get_growing_resources", &GastLoader::get_growing_resources);
+    register_method("get_input_latency_stats", &GastLoader::get_input_latency_stats);
+    register_method("reset_input_latency_stats", &GastLoader::reset_input_latency_stats);
 
     // Register signals
     Dictionary common_event_args;
@@ -38,6 +73,35 @@ void GastLoader::_register_methods() {
     scroll_event_args[Variant("vertical_delta")] = Variant(Variant::REAL);
 
     register_signal<GastLoader>(kScrollInputEvent, scroll_event_args);
+
+    Dictionary gesture_event_args = Dictionary(common_event_args);
+    gesture_event_args[Variant("gesture_type")] = Variant(Variant::INT);
+    gesture_event_args[Variant("x_velocity")] = Variant(Variant::REAL);
+    gesture_event_args[Variant("y_velocity")] = Variant(Variant::REAL);
+
+    register_signal<GastLoader>(kGestureInputEvent, gesture_event_args);
+
+    // Hover, press, release and scroll events of a frame, delivered in a single signal. Event i is
+    // described by event_types[i], node_paths[i], event_origin_ids[i] and
+    // values[4 * i .. 4 * i + 3] (x_percent, y_percent, horizontal_delta, vertical_delta).
+    Dictionary batched_input_events_args;
+    batched_input_events_args[Variant("event_types")] = Variant(Variant::POOL_INT_ARRAY);
+    batched_input_events_args[Variant("node_paths")] = Variant(Variant::POOL_STRING_ARRAY);
+    batched_input_events_args[Variant("event_origin_ids")] = Variant(Variant::POOL_STRING_ARRAY);
+    batched_input_events_args[Variant("values")] = Variant(Variant::POOL_REAL_ARRAY);
+    register_signal<GastLoader>(kBatchedInputEvents, batched_input_events_args);
+
+    Dictionary gast_node_ready_args;
+    gast_node_ready_args[Variant("request_id")] = Variant(Variant::INT);
+    gast_node_ready_args[Variant("node_path")] = Variant(Variant::STRING);
+    register_signal<GastLoader>(kGastNodeReady, gast_node_ready_args);
+
+    Dictionary texture_budget_decision_args;
+    texture_budget_decision_args[Variant("node_path")] = Variant(Variant::STRING);
+    texture_budget_decision_args[Variant("action")] = Variant(Variant::INT);
+    texture_budget_decision_args[Variant("width")] = Variant(Variant::INT);
+    texture_budget_decision_args[Variant("height")] = Variant(Variant::INT);
+    register_signal<GastLoader>(kTextureBudgetDecision, texture_budget_decision_args);
 }
 
 void GastLoader::initialize() {
@@ -49,30 +113,281 @@ void GastLoader::shutdown() {
 }
 
 void GastLoader::on_process() {
+    frame_++;
+    if (signal_connections_dirty_ ||
+        ++frames_since_signal_connections_update_ >= kSignalConnectionsPollIntervalFrames) {
+        update_signal_connections();
+    }
     GastManager::get_singleton_instance()->on_process();
+
+    // The events of the physics frames and of this frame are delivered together.
+    flush_batched_input_events();
+}
+
+void GastLoader::refresh_signal_connections() {
+    signal_connections_dirty_ = true;
+}
+
+void GastLoader::update_signal_connections() {
+    signal_connections_dirty_ = false;
+    frames_since_signal_connections_update_ = 0;
+    update_signal_connection(kHoverInputEvent, hover_event_connection_);
+    update_signal_connection(kPressInputEvent, press_event_connection_);
+    update_signal_connection(kReleaseInputEvent, release_event_connection_);
+    update_signal_connection(kScrollInputEvent, scroll_event_connection_);
+    update_signal_connection(kBatchedInputEvents, batched_events_connection_);
+}
+
+void GastLoader::update_signal_connection(const char *signal,
+                                          InputSignalConnection &connection) {
+    connection.connected = !get_signal_connection_list(signal).empty();
+    connection.update_frame = frame_;
+}
+
+bool GastLoader::is_input_signal_connected(const char *signal,
+                                           InputSignalConnection &connection) {
+    if (!connection.connected && connection.update_frame != frame_) {
+        update_signal_connection(signal, connection);
+    }
+    return connection.connected;
+}
+
+void GastLoader::add_batched_input_event(BatchedInputEventType event_type,
+                                         const String &node_path, const String &event_origin_id,
+                                         float x_percent, float y_percent, float horizontal_delta,
+                                         float vertical_delta) {
+    if (!is_input_signal_connected(kBatchedInputEvents, batched_events_connection_)) {
+        return;
+    }
+
+    batched_event_types_.append(event_type);
+    batched_node_paths_.append(node_path);
+    batched_event_origin_ids_.append(event_origin_id);
+    batched_event_values_.append(x_percent);
+    batched_event_values_.append(y_percent);
+    batched_event_values_.append(horizontal_delta);
+    batched_event_values_.append(vertical_delta);
+    batched_events_count_++;
+}
+
+void GastLoader::flush_batched_input_events() {
+    if (batched_events_count_ == 0) {
+        return;
+    }
+
+    emit_signal(kBatchedInputEvents, batched_event_types_, batched_node_paths_,
+                batched_event_origin_ids_, batched_event_values_);
+
+    batched_event_types_.resize(0);
+    batched_node_paths_.resize(0);
+    batched_event_origin_ids_.resize(0);
+    batched_event_values_.resize(0);
+    batched_events_count_ = 0;
+}
+
+void GastLoader::set_gesture_detection_enabled(bool enabled) {
+    GastManager::get_singleton_instance()->set_gdn_gesture_detection_enabled(enabled);
+}
+
+int64_t GastLoader::request_gast_node(const String parent_node_path, bool empty_parent,
+                                      bool high_priority) {
+    return GastManager::get_singleton_instance()->request_gast_node(parent_node_path, empty_parent,
+                                                                    high_priority);
+}
+
+void GastLoader::cancel_gast_node_request(int64_t request_id) {
+    GastManager::get_singleton_instance()->cancel_gast_node_request(request_id);
+}
+
+void GastLoader::set_gast_node_request_budget_nanos(int64_t budget_nanos) {
+    GastManager::get_singleton_instance()->set_gast_node_request_budget_nanos(budget_nanos);
+}
+
+void GastLoader::set_texture_memory_budget(int64_t budget_bytes) {
+    GastManager::get_singleton_instance()->get_texture_memory_budget().set_budget_bytes(
+            budget_bytes);
+}
+
+int64_t GastLoader::get_texture_memory_usage() {
+    return GastManager::get_singleton_instance()->get_texture_memory_budget().get_usage_bytes();
+}
+
+void GastLoader::set_scroll_settings(float speed, float acceleration,
+                                     float max_acceleration_multiplier, float fling_friction) {
+    ScrollSettings settings;
+    settings.speed = speed;
+    settings.acceleration = acceleration;
+    settings.max_acceleration_multiplier = max_acceleration_multiplier;
+    settings.fling_friction = fling_friction;
+    GastManager::get_singleton_instance()->set_scroll_settings(settings);
+}
+
+int64_t GastLoader::get_updated_pixels_per_frame() {
+    return GastManager::get_singleton_instance()->get_updated_pixels_per_frame();
+}
+
+int64_t GastLoader::get_tested_ray_cast_pairs_per_frame() {
+    return GastManager::get_singleton_instance()->get_ray_cast_filter()
+            .get_tested_pairs_per_frame();
+}
+
+int64_t GastLoader::get_culled_ray_cast_pairs_per_frame() {
+    return GastManager::get_singleton_instance()->get_ray_cast_filter()
+            .get_culled_pairs_per_frame();
+}
+
+int64_t GastLoader::get_heap_allocations_per_frame() {
+    return AllocationTracker::get_allocations_per_frame();
+}
+
+Dictionary GastLoader::get_heap_allocations_per_subsystem() {
+    Dictionary allocations;
+    for (int i = 0; i < kAllocationSubsystemCount; i++) {
+        auto subsystem = static_cast<AllocationSubsystem>(i);
+        Array counters;
+        counters.append(AllocationTracker::get_allocations_per_frame(subsystem));
+        counters.append(AllocationTracker::get_total_allocations(subsystem));
+        allocations[AllocationTracker::get_subsystem_name(subsystem)] = counters;
+    }
+    return allocations;
+}
+
+Dictionary GastLoader::get_input_latency_stats() {
+    const InputLatencyTracker &tracker =
+            GastManager::get_singleton_instance()->get_input_latency_tracker();
+    Dictionary latency_stats;
+    for (int i = 0; i < kInputLatencyStageCount; i++) {
+        auto stage = static_cast<InputLatencyStage>(i);
+        Dictionary stage_stats;
+        stage_stats["p50"] = tracker.get_percentile_nanos(stage, 50);
+        stage_stats["p90"] = tracker.get_percentile_nanos(stage, 90);
+        stage_stats["p99"] = tracker.get_percentile_nanos(stage, 99);
+        stage_stats["count"] = tracker.get_sample_count(stage);
+        latency_stats[InputLatencyTracker::get_stage_name(stage)] = stage_stats;
+    }
+    return latency_stats;
+}
+
+void GastLoader::reset_input_latency_stats() {
+    GastManager::get_singleton_instance()->get_input_latency_tracker().reset();
+}
+
+PoolStringArray GastLoader::get_growing_resources() {
+    PoolStringArray growing_resources;
+    for (const char *name : GastManager::get_singleton_instance()->get_growth_watchdog()
+            .get_growing_gauges()) {
+        growing_resources.append(String(name));
+    }
+    return growing_resources;
+}
+
+void GastLoader::set_picking_mode(int picking_mode) {
+    if (picking_mode != kPhysicsPicking && picking_mode != kBvhPicking) {
+        ALOGE("Invalid picking mode %d", picking_mode);
+        return;
+    }
+    GastManager::get_singleton_instance()->set_picking_mode(
+            static_cast<PickingMode>(picking_mode));
+}
+
+int GastLoader::get_picking_mode() {
+    return GastManager::get_singleton_instance()->get_picking_mode();
+}
+
+void GastLoader::set_input_sampling_mode(int input_sampling_mode) {
+    if (input_sampling_mode != kPhysicsTickSampling &&
+        input_sampling_mode != kRenderFrameSampling) {
+        ALOGE("Invalid input sampling mode %d", input_sampling_mode);
+        return;
+    }
+    GastManager::get_singleton_instance()->set_input_sampling_mode(
+            static_cast<InputSamplingMode>(input_sampling_mode));
+}
+
+int GastLoader::get_input_sampling_mode() {
+    return GastManager::get_singleton_instance()->get_input_sampling_mode();
+}
+
+Dictionary GastLoader::pick(Vector3 ray_origin, Vector3 ray_direction, float max_distance) {
+    Dictionary pick_result;
+    GastNodePickResult result;
+    if (GastManager::get_singleton_instance()->pick(ray_origin, ray_direction, max_distance,
+                                                    &result)) {
+        pick_result["node"] = result.gast_node;
+        pick_result["node_path"] = result.gast_node->get_path();
+        pick_result["uv"] = result.uv;
+        pick_result["distance"] = result.distance;
+        pick_result["position"] = result.position;
+        pick_result["normal"] = result.normal;
+    }
+    return pick_result;
+}
+
+Array GastLoader::get_texture_memory_decisions() {
+    Array decisions;
+    for (const auto &decision :
+            GastManager::get_singleton_instance()->get_texture_memory_budget().get_decisions()) {
+        Dictionary decision_info;
+        decision_info["node_path"] = decision.gast_node->get_path();
+        decision_info["action"] = decision.action;
+        decision_info["width"] = decision.width;
+        decision_info["height"] = decision.height;
+        decisions.append(decision_info);
+    }
+    return decisions;
 }
 
 void
 GastLoader::emitHoverEvent(const String &node_path, const String &event_origin_id, float x_percent,
                            float y_percent) {
-    emit_signal(kHoverInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    add_batched_input_event(kBatchedHoverEvent, node_path, event_origin_id, x_percent, y_percent);
+    if (is_input_signal_connected(kHoverInputEvent, hover_event_connection_)) {
+        emit_signal(kHoverInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    }
 }
 
 void
 GastLoader::emitPressEvent(const String &node_path, const String &event_origin_id, float x_percent,
                            float y_percent) {
-    emit_signal(kPressInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    add_batched_input_event(kBatchedPressEvent, node_path, event_origin_id, x_percent, y_percent);
+    if (is_input_signal_connected(kPressInputEvent, press_event_connection_)) {
+        emit_signal(kPressInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    }
 }
 
 void GastLoader::emitReleaseEvent(const String &node_path, const String &event_origin_id,
                                   float x_percent, float y_percent) {
-    emit_signal(kReleaseInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    add_batched_input_event(kBatchedReleaseEvent, node_path, event_origin_id, x_percent,
+                            y_percent);
+    if (is_input_signal_connected(kReleaseInputEvent, release_event_connection_)) {
+        emit_signal(kReleaseInputEvent, node_path, event_origin_id, x_percent, y_percent);
+    }
 }
 
 void
 GastLoader::emitScrollEvent(const String &node_path, const String &event_origin_id, float x_percent,
                             float y_percent, float horizontal_delta, float vertical_delta) {
-    emit_signal(kScrollInputEvent, node_path, event_origin_id, x_percent, y_percent,
-                horizontal_delta, vertical_delta);
+    add_batched_input_event(kBatchedScrollEvent, node_path, event_origin_id, x_percent, y_percent,
+                            horizontal_delta, vertical_delta);
+    if (is_input_signal_connected(kScrollInputEvent, scroll_event_connection_)) {
+        emit_signal(kScrollInputEvent, node_path, event_origin_id, x_percent, y_percent,
+                    horizontal_delta, vertical_delta);
+    }
+}
+
+void GastLoader::emitGestureEvent(const String &node_path, const String &event_origin_id,
+                                  int gesture_type, float x_percent, float y_percent,
+                                  float x_velocity, float y_velocity) {
+    emit_signal(kGestureInputEvent, node_path, event_origin_id, x_percent, y_percent,
+                gesture_type, x_velocity, y_velocity);
+}
+
+void GastLoader::emitGastNodeReady(int64_t request_id, const String &node_path) {
+    emit_signal(kGastNodeReady, request_id, node_path);
+}
+
+void GastLoader::emitTextureBudgetDecision(const String &node_path, int action, int width,
+                                           int height) {
+    emit_signal(kTextureBudgetDecision, node_path, action, width, height);
 }
 }
@@ -1,7 +1,9 @@
 #ifndef GAST_LOADER_H
 #define GAST_LOADER_H
 
+#include <core/Array.hpp>
 #include <core/Godot.hpp>
+#include <core/PoolArrays.hpp>
 #include <core/String.hpp>
 #include <gen/Reference.hpp>
 
@@ -11,6 +13,14 @@ namespace {
 using namespace godot;
 }  // namespace
 
+/// Type of the events delivered by the batched input events signal.
+enum BatchedInputEventType {
+    kBatchedHoverEvent = 0,
+    kBatchedPressEvent = 1,
+    kBatchedReleaseEvent = 2,
+    kBatchedScrollEvent = 3,
+};
+
 // Loader for GastManager. The 'initialize()' method must be invoked for
 // GastManager to be properly setup.
 class GastLoader : public Reference {
@@ -33,6 +43,87 @@ public:
 
     void on_process();
 
+    // Take the input signals disconnections into account on the next frame. Otherwise they're
+    // only polled periodically. Connections are always picked up right away.
+    void refresh_signal_connections();
+
+    // Enable / disable the emission of the gesture input signal
+    void set_gesture_detection_enabled(bool enabled);
+
+    // Asynchronously create a Gast node under the given parent. Completion is signaled via the
+    // 'gast_node_ready' signal.
+    int64_t request_gast_node(const String parent_node_path, bool empty_parent,
+                              bool high_priority);
+
+    void cancel_gast_node_request(int64_t request_id);
+
+    void set_gast_node_request_budget_nanos(int64_t budget_nanos);
+
+    void emitGastNodeReady(int64_t request_id, const String &node_path);
+
+    // Set the texture memory budget in bytes. 0 disables the budget.
+    void set_texture_memory_budget(int64_t budget_bytes);
+
+    // Estimated memory used by the Gast nodes textures, in bytes.
+    int64_t get_texture_memory_usage();
+
+    // Texture budget decisions currently in effect.
+    Array get_texture_memory_decisions();
+
+    // Tune the conversion of the held scroll actions into scroll events: scroll speed at full
+    // strength (per second), acceleration of the speed multiplier (per second held), cap on the
+    // speed multiplier, and fling decay rate (per second, 0 disables the fling).
+    void set_scroll_settings(float speed, float acceleration, float max_acceleration_multiplier,
+                             float fling_friction);
+
+    // Number of Gast nodes texture pixels updated during the last frame.
+    int64_t get_updated_pixels_per_frame();
+
+    // Select how the ray casts are resolved: 0 for the physics engine, 1 for the Gast nodes
+    // bounding volume hierarchy.
+    void set_picking_mode(int picking_mode);
+
+    int get_picking_mode();
+
+    // Select how often the ray casts are sampled in the physics picking mode: 0 on every physics
+    // frame, 1 once per rendered frame.
+    void set_input_sampling_mode(int input_sampling_mode);
+
+    int get_input_sampling_mode();
+
+    // Synchronously find the closest visible, collidable Gast node hit by the given ray, within
+    // `max_distance` (world units). Returns an empty dictionary on miss, otherwise a dictionary
+    // with the hit 'node', its 'node_path', the 'uv' coordinates (as reported in the input
+    // events), and the hit 'distance', 'position' and 'normal'.
+    Dictionary pick(Vector3 ray_origin, Vector3 ray_direction, float max_distance);
+
+    // Number of (ray cast, Gast node) pairs tested / culled by the ray cast pre-filter during the
+    // last physics frame.
+    int64_t get_tested_ray_cast_pairs_per_frame();
+
+    int64_t get_culled_ray_cast_pairs_per_frame();
+
+    // Number of heap allocations made by the Gast code during the last frame, excluding the ones
+    // made by the engine (e.g: String temporaries). Always 0 unless built with
+    // GAST_ALLOCATION_TRACKING.
+    int64_t get_heap_allocations_per_frame();
+
+    // Heap allocations per subsystem name, as [allocations during the last frame, allocations
+    // since startup]. Always 0 unless built with GAST_ALLOCATION_TRACKING.
+    Dictionary get_heap_allocations_per_subsystem();
+
+    // Names of the Gast resources which have been growing without ever shrinking for a long
+    // period, i.e: likely leaks.
+    PoolStringArray get_growing_resources();
+
+    // Latency percentiles (p50, p90, p99, in nanoseconds) and sample count of each native input
+    // stage, measured from the input capture timestamp.
+    Dictionary get_input_latency_stats();
+
+    void reset_input_latency_stats();
+
+    void emitTextureBudgetDecision(const String &node_path, int action, int width, int height);
+
     void emitHoverEvent(const String &node_path, const String &event_origin_id, float x_percent,
                         float y_percent);
 
@@ -46,6 +137,52 @@ public:
     void emitScrollEvent(const String &node_path, const String &event_origin_id, float x_percent,
                          float y_percent,
                          float horizontal_delta, float vertical_delta);
+
+    void emitGestureEvent(const String &node_path, const String &event_origin_id, int gesture_type,
+                          float x_percent, float y_percent, float x_velocity, float y_velocity);
+
+private:
+    // Cached connection state of an input signal.
+    struct InputSignalConnection {
+        bool connected = false;
+        // Frame of the last query, -1 if the signal was never queried.
+        int64_t update_frame = -1;
+    };
+
+    // Refresh the cached signals connection state. Each query allocates the connection list, so
+    // it only runs when flagged by refresh_signal_connections() or every
+    // kSignalConnectionsPollIntervalFrames frames.
+    void update_signal_connections();
+
+    void update_signal_connection(const char *signal, InputSignalConnection &connection);
+
+    // Returns true if an event should be emitted on the given signal. A connected signal is
+    // trusted until the next poll, since emitting to a disconnected signal is harmless. A
+    // disconnected one is queried again before dropping an event, at most once per frame, so the
+    // events aren't lost while a new connection waits for the next poll.
+    bool is_input_signal_connected(const char *signal, InputSignalConnection &connection);
+
+    void add_batched_input_event(BatchedInputEventType event_type, const String &node_path,
+                                 const String &event_origin_id, float x_percent, float y_percent,
+                                 float horizontal_delta = 0, float vertical_delta = 0);
+
+    // Emit the input events batched during the frame, if any.
+    void flush_batched_input_events();
+
+    InputSignalConnection hover_event_connection_;
+    InputSignalConnection press_event_connection_;
+    InputSignalConnection release_event_connection_;
+    InputSignalConnection scroll_event_connection_;
+    InputSignalConnection batched_events_connection_;
+    bool signal_connections_dirty_ = true;
+    int frames_since_signal_connections_update_ = 0;
+    int64_t frame_ = 0;
+
+    PoolIntArray batched_event_types_;
+    PoolStringArray batched_node_paths_;
+    PoolStringArray batched_event_origin_ids_;
+    PoolRealArray batched_event_values_;
+    int batched_events_count_ = 0;
 };
 }  // namespace gast
 
@@ -7,6 +7,7 @@
 #include <core/Rect2.hpp>
 #include <core/Transform.hpp>
 #include <gen/Camera.hpp>
+#include <gen/Image.hpp>
 #include <gen/Input.hpp>
 #include <gen/InputEventScreenDrag.hpp>
 #include <gen/InputEventScreenTouch.hpp>
@@ -19,6 +20,10 @@
 #include <gen/Shape.hpp>
 #include <gen/Texture.hpp>
 #include <gen/Viewport.hpp>
+#include <algorithm>
+#include <cstring>
+
+#include "memory/allocation_tracker.h"
 
 namespace gast {
 
@@ -28,6 +33,10 @@ const int kDefaultSurfaceIndex = 0;
 const char *kGastEnableBillBoardParamName = "enable_billboard";
 const char *kGastTextureParamName = "gast_texture";
 const char *kGastGradientHeightRatioParamName = "gradient_height_ratio";
+const char *kGastUvOffsetParamName = "uv_offset";
+const char *kGastUvScaleParamName = "uv_scale";
+const char *kGastSnapshotTextureParamName = "gast_snapshot_texture";
+const char *kGastUseSnapshotParamName = "use_snapshot";
 const Vector2 kInvalidCoordinate = Vector2(-1, -1);
 const char *kCapturedGastRayCastGroupName = "captured_gast_ray_casts";
 
@@ -36,8 +45,12 @@ shader_type spatial;
 render_mode unshaded, depth_draw_opaque, specular_disabled, shadows_disabled, ambient_light_disabled;
 
 uniform samplerExternalOES gast_texture;
+uniform sampler2D gast_snapshot_texture;
+uniform bool use_snapshot = false;
 uniform bool enable_billboard;
 uniform float gradient_height_ratio;
+uniform vec2 uv_offset = vec2(0.0, 0.0);
+uniform vec2 uv_scale = vec2(1.0, 1.0);
 
 void vertex() {
 	if (enable_billboard) {
@@ -46,7 +59,9 @@ void vertex() {
 }
 
 void fragment() {
-	vec4 texture_color = texture(gast_texture, UV);
+	vec2 texture_uv = uv_offset + UV * uv_scale;
+	vec4 texture_color = use_snapshot ? texture(gast_snapshot_texture, texture_uv)
+	                                  : texture(gast_texture, texture_uv);
 	float target_alpha = COLOR.a * texture_color.a;
 	if (gradient_height_ratio >= 0.05) {
 		float gradient_mask = min((1.0 - UV.y) / gradient_height_ratio, 1.0);
@@ -70,13 +85,36 @@ const char *kShaderCustomDefines = R"GAST_DEFINES(
 )GAST_DEFINES";
 }
 
+int64_t GastNode::live_instance_count = 0;
+
 GastNode::GastNode() : collidable(kDefaultCollidable), curved(kDefaultCurveValue),
                        gaze_tracking(kDefaultGazeTracking),
                        render_on_top(kDefaultRenderOnTop),
                        gradient_height_ratio(kDefaultGradientHeightRatio),
-                       mesh_size(kDefaultSize){}
+                       mesh_size(kDefaultSize), uv_rect(kDefaultUvRect) {
+    live_instance_count++;
+}
+
+GastNode::~GastNode() {
+    live_instance_count--;
 
-GastNode::~GastNode() = default;
+    // Only unlink the shared texture pointers here. Refreshing the shaders goes through the
+    // GastManager, which may be gone already, so it's left to on_gast_node_destroyed().
+    if (shared_texture_source) {
+        std::vector<GastNode *> &source_nodes = shared_texture_source->shared_texture_nodes;
+        source_nodes.erase(std::remove(source_nodes.begin(), source_nodes.end(), this),
+                           source_nodes.end());
+        shared_texture_source = nullptr;
+    }
+
+    std::vector<GastNode *> released_shared_texture_nodes;
+    released_shared_texture_nodes.swap(shared_texture_nodes);
+    for (GastNode *shared_texture_node : released_shared_texture_nodes) {
+        shared_texture_node->shared_texture_source = nullptr;
+    }
+
+    GastManager::on_gast_node_destroyed(this, released_shared_texture_nodes);
+}
 
 void GastNode::_register_methods() {
     register_method("_enter_tree", &GastNode::_enter_tree);
@@ -119,17 +157,28 @@ void GastNode::_register_methods() {
 void GastNode::_init() {
     ALOGV("Initializing GastNode class.");
 
-    // Add a CollisionShape to the static body node
-    CollisionShape *collision_shape = CollisionShape::_new();
-    add_child(collision_shape);
-
-    // Add a mesh instance to the collision shape node
-    MeshInstance *mesh_instance = MeshInstance::_new();
-    collision_shape->add_child(mesh_instance);
+    // Add a mesh instance to the static body node. The collision shape is added on demand.
+    mesh_instance = MeshInstance::_new();
+    add_child(mesh_instance);
 }
 
 void GastNode::_enter_tree() {
-    ALOGV("Entering tree for %s.", get_node_tag(*this));
+    ALOGV("Entering tree for %s.", get_node_tag(*this).get_data());
+
+    setup_material();
+    update_mesh_and_collision_shape();
+    update_render_priority();
+
+    set_notify_transform(true);
+    GastManager::get_singleton_instance()->get_node_registry().add(this);
+}
+
+void GastNode::setup_material() {
+    // The shader material and external texture are created once, and kept when the node is
+    // reparented or recycled so the texture id handed to the Android side remains valid.
+    if (shader_material_ref.is_valid()) {
+        return;
+    }
 
     // Create the shader object
     Shader *shader = Shader::_new();
@@ -137,28 +186,27 @@ void GastNode::_enter_tree() {
     shader->set_code(generate_shader_code());
 
     // Create the external texture
-    ExternalTexture *external_texture = ExternalTexture::_new();
+    external_texture_ref = Ref<ExternalTexture>(ExternalTexture::_new());
 
     // Create the shader material.
     ALOGV("Creating GAST shader material.");
     ShaderMaterial *shader_material = ShaderMaterial::_new();
     shader_material->set_shader(shader);
-    shader_material->set_shader_param(kGastTextureParamName, external_texture);
 
     shader_material_ref = Ref<ShaderMaterial>(shader_material);
-
-    update_mesh_and_collision_shape();
-    update_render_priority();
+    update_shader_texture();
+    update_shader_params();
 }
 
 void GastNode::_exit_tree() {
     ALOGV("Exiting tree.");
+    release_captured_ray_casts();
+    GastManager::get_singleton_instance()->get_node_registry().remove(this);
     reset_mesh_and_collision_shape();
 }
 
 void GastNode::reset_mesh_and_collision_shape() {
     // Unset the GAST mesh resource
-    MeshInstance *mesh_instance = get_mesh_instance();
     if (mesh_instance) {
         mesh_instance->set_mesh(Ref<Resource>());
     }
@@ -170,7 +218,7 @@ void GastNode::reset_mesh_and_collision_shape() {
 void GastNode::update_mesh_dimensions_and_collision_shape() {
     auto *mesh = get_mesh();
     if (!mesh) {
-        ALOGE("Unable to access mesh resource for %s", get_node_tag(*this));
+        ALOGE("Unable to access mesh resource for %s", get_node_tag(*this).get_data());
         return;
     }
 
@@ -201,7 +249,6 @@ void GastNode::update_mesh_and_collision_shape() {
     }
 
     ALOGV("Setting up GAST mesh resource.");
-    MeshInstance *mesh_instance = get_mesh_instance();
     if (!mesh_instance || !mesh) {
         return;
     }
@@ -237,20 +284,26 @@ Vector2 GastNode::get_size() {
 void GastNode::set_size(Vector2 size) {
     this->mesh_size = size;
     update_mesh_dimensions_and_collision_shape();
+    GastManager::get_singleton_instance()->get_node_registry().update_size(*this, size);
 }
 
 void GastNode::update_collision_shape() {
-    CollisionShape *collision_shape = get_collision_shape();
+    Mesh *mesh = get_mesh();
+    bool has_shape = collidable && mesh && is_visible_in_tree();
     if (!collision_shape) {
-        ALOGW("Unable to retrieve collision shape for %s. Aborting...", get_node_tag(*this));
-        return;
+        // Display-only nodes never carry a collision shape.
+        if (!has_shape) {
+            return;
+        }
+
+        collision_shape = CollisionShape::_new();
+        add_child(collision_shape);
     }
 
-    Mesh *mesh = get_mesh();
-    if (!is_visible_in_tree() || !collidable || !mesh) {
-        collision_shape->set_shape(Ref<Resource>());
-    } else {
+    if (has_shape) {
         collision_shape->set_shape(mesh->create_convex_shape());
+    } else {
+        collision_shape->set_shape(Ref<Resource>());
     }
 }
 
@@ -262,6 +315,169 @@ void GastNode::update_shader_params() {
 
     shader_material->set_shader_param(kGastEnableBillBoardParamName, gaze_tracking);
     shader_material->set_shader_param(kGastGradientHeightRatioParamName, gradient_height_ratio);
+    Rect2 sampled_uv_rect = get_sampled_uv_rect();
+    shader_material->set_shader_param(kGastUvOffsetParamName, sampled_uv_rect.position);
+    shader_material->set_shader_param(kGastUvScaleParamName, sampled_uv_rect.size);
+}
+
+void GastNode::update_shader_texture() {
+    ShaderMaterial *shader_material = get_shader_material();
+    if (!shader_material) {
+        return;
+    }
+
+    const GastNode &texture_source = shared_texture_source ? *shared_texture_source : *this;
+    shader_material->set_shader_param(kGastTextureParamName,
+                                      texture_source.atlas_texture_ref.is_valid()
+                                      ? texture_source.atlas_texture_ref
+                                      : texture_source.external_texture_ref);
+    shader_material->set_shader_param(kGastSnapshotTextureParamName,
+                                      texture_source.snapshot_texture_ref);
+    shader_material->set_shader_param(kGastUseSnapshotParamName,
+                                      texture_source.snapshot_texture_ref.is_valid());
+    GastManager::get_singleton_instance()->get_node_registry().update_texture_id(
+            *this, get_external_texture_id());
+
+    // Propagate the change to the nodes sharing this node's texture.
+    for (GastNode *shared_texture_node : shared_texture_nodes) {
+        shared_texture_node->update_shader_texture();
+        shared_texture_node->update_shader_params();
+    }
+}
+
+bool GastNode::bind_to_shared_texture(GastNode *source_node) {
+    // Bind to the node actually owning the texture.
+    if (source_node && source_node->shared_texture_source) {
+        source_node = source_node->shared_texture_source;
+    }
+
+    if (source_node == shared_texture_source) {
+        return true;
+    }
+
+    if (!source_node) {
+        unbind_from_shared_texture();
+        return true;
+    }
+
+    if (source_node == this || !shared_texture_nodes.empty()) {
+        ALOGW("Unable to bind %s to a shared texture: the node is a texture source.",
+              get_node_tag(*this).get_data());
+        return false;
+    }
+
+    unbind_from_shared_texture();
+    shared_texture_source = source_node;
+    source_node->shared_texture_nodes.push_back(this);
+    update_shader_texture();
+    update_shader_params();
+    return true;
+}
+
+void GastNode::unbind_from_shared_texture() {
+    if (!shared_texture_source) {
+        return;
+    }
+
+    std::vector<GastNode *> &source_nodes = shared_texture_source->shared_texture_nodes;
+    source_nodes.erase(std::remove(source_nodes.begin(), source_nodes.end(), this),
+                       source_nodes.end());
+    shared_texture_source = nullptr;
+    update_shader_texture();
+    update_shader_params();
+}
+
+void GastNode::on_shared_texture_source_destroyed() {
+    update_shader_texture();
+    update_shader_params();
+}
+
+void GastNode::release_shared_texture_nodes() {
+    // Copy the list since unbinding updates it.
+    std::vector<GastNode *> nodes = shared_texture_nodes;
+    for (GastNode *shared_texture_node : nodes) {
+        shared_texture_node->unbind_from_shared_texture();
+    }
+}
+
+bool GastNode::set_static_snapshot(const uint8_t *rgba_data, int width, int height) {
+    if (!rgba_data || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    PoolByteArray data;
+    data.resize(width * height * 4);
+    {
+        PoolByteArray::Write data_write = data.write();
+        memcpy(data_write.ptr(), rgba_data, width * height * 4);
+    }
+
+    Ref<Image> image = Ref<Image>(Image::_new());
+    image->create_from_data(width, height, false, Image::FORMAT_RGBA8, data);
+
+    Ref<ImageTexture> snapshot_texture = Ref<ImageTexture>(ImageTexture::_new());
+    snapshot_texture->create_from_image(image, Texture::FLAG_FILTER);
+
+    snapshot_texture_ref = snapshot_texture;
+    update_shader_texture();
+    return true;
+}
+
+void GastNode::clear_static_snapshot() {
+    if (snapshot_texture_ref.is_null()) {
+        return;
+    }
+
+    snapshot_texture_ref.unref();
+    update_shader_texture();
+}
+
+void GastNode::update_registry_path_hash() {
+    if (registry_index == kInvalidRegistryIndex) {
+        return;
+    }
+    GastManager::get_singleton_instance()->get_node_registry().update_path_hash(
+            *this, String(get_path()).hash());
+}
+
+uint32_t GastNode::get_registry_flags() const {
+    uint32_t flags = kGastNodeFlagNone;
+    if (collidable) {
+        flags |= kGastNodeFlagCollidable;
+    }
+    if (curved) {
+        flags |= kGastNodeFlagCurved;
+    }
+    if (gaze_tracking) {
+        flags |= kGastNodeFlagGazeTracking;
+    }
+    if (render_on_top) {
+        flags |= kGastNodeFlagRenderOnTop;
+    }
+    return flags;
+}
+
+void GastNode::update_registry_flags() {
+    GastManager::get_singleton_instance()->get_node_registry().update_flags(*this,
+                                                                            get_registry_flags());
+}
+
+void GastNode::bind_to_texture_atlas(const Ref<ExternalTexture> &atlas_texture, Rect2 uv_rect) {
+    this->atlas_texture_ref = atlas_texture;
+    this->uv_rect = uv_rect;
+    update_shader_texture();
+    update_shader_params();
+}
+
+void GastNode::unbind_from_texture_atlas() {
+    if (atlas_texture_ref.is_null()) {
+        return;
+    }
+
+    atlas_texture_ref.unref();
+    uv_rect = kDefaultUvRect;
+    update_shader_texture();
+    update_shader_params();
 }
 
 int GastNode::get_external_texture_id(int surface_index) {
@@ -286,7 +502,11 @@ void GastNode::_input_event(const godot::Object *camera,
         return;
     }
 
-    String node_path = get_path();
+    int64_t capture_timestamp_nanos = get_monotonic_time_nanos();
+    GastNode *input_target = get_input_target();
+    GastManager::get_singleton_instance()->get_texture_memory_budget().mark_used(
+            input_target, capture_timestamp_nanos);
+    String node_path = input_target->get_path();
 
     // Calculate the 2D collision point of the raycast on the Gast node.
     Vector2 relative_collision_point = get_relative_collision_point(click_position);
@@ -300,15 +520,13 @@ void GastNode::_input_event(const godot::Object *camera,
             String touch_event_id = InputEventScreenTouch::___get_class_name() +
                                     String::num_int64(touch_event->get_index());
             if (touch_event->is_pressed()) {
-                GastManager::get_singleton_instance()->on_render_input_press(node_path,
-                                                                             touch_event_id,
-                                                                             x_percent,
-                                                                             y_percent);
+                GastManager::get_singleton_instance()->on_render_input_press(
+                        input_target, node_path, touch_event_id, x_percent, y_percent,
+                        capture_timestamp_nanos);
             } else {
-                GastManager::get_singleton_instance()->on_render_input_release(node_path,
-                                                                               touch_event_id,
-                                                                               x_percent,
-                                                                               y_percent);
+                GastManager::get_singleton_instance()->on_render_input_release(
+                        input_target, node_path, touch_event_id, x_percent, y_percent,
+                        capture_timestamp_nanos);
             }
         }
     } else if (event->is_class(InputEventScreenDrag::___get_class_name())) {
@@ -316,9 +534,9 @@ void GastNode::_input_event(const godot::Object *camera,
         if (drag_event) {
             String drag_event_id = InputEventScreenDrag::___get_class_name() +
                                    String::num_int64(drag_event->get_index());
-            GastManager::get_singleton_instance()->on_render_input_hover(node_path,
-                                                                         drag_event_id, x_percent,
-                                                                         y_percent);
+            GastManager::get_singleton_instance()->on_render_input_hover(
+                    input_target, node_path, drag_event_id, x_percent, y_percent,
+                    capture_timestamp_nanos);
         }
     }
 }
@@ -327,6 +545,15 @@ void GastNode::_notification(const int64_t what) {
     switch(what) {
         case NOTIFICATION_VISIBILITY_CHANGED:
             update_collision_shape();
+            GastManager::get_singleton_instance()->get_node_registry().update_visibility(
+                    *this, is_visible_in_tree());
+            break;
+        case NOTIFICATION_TRANSFORM_CHANGED:
+            GastManager::get_singleton_instance()->get_node_registry().update_global_transform(
+                    *this, get_global_transform());
+            break;
+        case NOTIFICATION_PATH_CHANGED:
+            update_registry_path_hash();
             break;
     }
 }
@@ -350,28 +577,42 @@ void GastNode::_process(const real_t delta) {
 }
 
 void GastNode::_physics_process(const real_t delta) {
+    GastManager *gast_manager = GastManager::get_singleton_instance();
+    if (!is_collidable() || gast_manager->get_picking_mode() != kPhysicsPicking ||
+        gast_manager->get_input_sampling_mode() != kPhysicsTickSampling) {
+        return;
+    }
+
+    sample_ray_casts(gast_manager->update_ray_cast_filter(), get_monotonic_time_nanos());
+}
+
+void GastNode::sample_ray_casts(RayCastFilter &ray_cast_filter,
+                                int64_t capture_timestamp_nanos) {
     if (!is_collidable()) {
         return;
     }
 
-    // Get the list of ray casts in the group
-    Array gast_ray_casts = get_tree()->get_nodes_in_group(kGastRayCasterGroupName);
-    if (gast_ray_casts.empty()) {
+    // Get the segments of the enabled ray casts in the group
+    const std::vector<RayCastSegment> &ray_cast_segments = ray_cast_filter.get_segments();
+    if (ray_cast_segments.empty()) {
         return;
     }
 
-    NodePath node_path = get_path();
-    for (int i = 0; i < gast_ray_casts.size(); i++) {
-        RayCast *ray_cast = get_ray_cast_from_variant(gast_ray_casts[i]);
-        if (!ray_cast || !ray_cast->is_enabled()) {
+    RayCastFilter::Target target = RayCastFilter::make_target(get_global_transform(), mesh_size,
+                                                              get_collision_layer());
+    int64_t instance_id = get_instance_id();
+    for (const RayCastSegment &segment : ray_cast_segments) {
+        RayCast *ray_cast = segment.ray_cast;
+
+        // Check if the raycast has been captured by another node already.
+        bool captured = ray_cast->is_in_group(kCapturedGastRayCastGroupName);
+        if (captured && !has_captured_raycast(*ray_cast)) {
             continue;
         }
 
-        String ray_cast_path = ray_cast->get_path();
-
-        // Check if the raycast has been captured by another node already.
-        if (ray_cast->is_in_group(kCapturedGastRayCastGroupName) &&
-            !has_captured_raycast(*ray_cast)) {
+        // The ray casts captured by this node are never culled, so the press in progress keeps
+        // being tracked and the capture is released.
+        if (!captured && !ray_cast_filter.is_candidate(segment, target)) {
             continue;
         }
 
@@ -382,74 +623,121 @@ void GastNode::_physics_process(const real_t delta) {
 
         if (ray_cast->is_colliding()) {
             Node *collider = Object::cast_to<Node>(ray_cast->get_collider());
-            if (collider != nullptr && node_path == collider->get_path()) {
+            if (collider != nullptr && collider->get_instance_id() == instance_id) {
                 collides_with_node = true;
 
                 collision_point = ray_cast->get_collision_point();
                 collision_normal = ray_cast->get_collision_normal();
             }
-        } else if (has_captured_raycast(*ray_cast) &&
-                   colliding_raycast_paths[ray_cast_path]->press_in_progress) {
-            // A press was in progress when the raycast 'move off' this node. Continue faking the
-            // collision until the press is released.
-            collision_point = colliding_raycast_paths[ray_cast_path]->collision_point;
-            collision_normal = colliding_raycast_paths[ray_cast_path]->collision_normal;
-
-            // Simulate collision and update collision_point accordingly.
-            // Generate the plane defined by the collision normal and the collision point.
-            auto *collision_plane = new Plane(collision_point, collision_normal);
-
-            collides_with_node = calculate_raycast_plane_collision(*ray_cast, *collision_plane,
-                                                                   &collision_point);
         }
 
-        if (collides_with_node) {
-            std::shared_ptr<CollisionInfo> collision_info =
-                    has_captured_raycast(*ray_cast)
-                    ? colliding_raycast_paths[ray_cast_path] : std::make_shared<CollisionInfo>();
-
-            // Calculate the 2D collision point of the raycast on the Gast node.
-            Vector2 relative_collision_point = get_relative_collision_point(collision_point);
-            collision_info->press_in_progress = handle_ray_cast_input(ray_cast_path,
-                                                                      relative_collision_point);
-            collision_info->collision_normal = collision_normal;
-            collision_info->collision_point = collision_point;
+        process_ray_cast_collision(*ray_cast, collides_with_node, ray_cast->is_colliding(),
+                                   collision_point, collision_normal, capture_timestamp_nanos);
+    }
+}
 
-            // Add the raycast to the list of colliding raycasts and update its collision info.
-            colliding_raycast_paths[ray_cast_path] = collision_info;
+bool GastNode::process_ray_cast_collision(RayCast &ray_cast, bool collides_with_node,
+                                          bool ray_cast_colliding, Vector3 collision_point,
+                                          Vector3 collision_normal,
+                                          int64_t capture_timestamp_nanos) {
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemInput);
+    int64_t ray_cast_id = ray_cast.get_instance_id();
+    RayCastCollision *collision = colliding_ray_casts.find(ray_cast_id);
+
+    if (!collides_with_node && !ray_cast_colliding && collision &&
+        collision->press_in_progress) {
+        // A press was in progress when the raycast 'move off' this node. Continue faking the
+        // collision until the press is released.
+        collision_point = collision->collision_point;
+        collision_normal = collision->collision_normal;
+
+        // Simulate collision and update collision_point accordingly.
+        // Generate the plane defined by the collision normal and the collision point.
+        Plane collision_plane(collision_point, collision_normal);
+
+        collides_with_node = calculate_raycast_plane_collision(ray_cast, collision_plane,
+                                                               &collision_point);
+    }
 
-            // Add the raycast to the captured raycasts group.
-            ray_cast->add_to_group(kCapturedGastRayCastGroupName);
+    if (collides_with_node) {
+        // The path and the input actions names are only computed when the raycast starts
+        // colliding with this node. Copying them only bumps their reference counts.
+        String ray_cast_path = collision ? collision->ray_cast_path : String(ray_cast.get_path());
+        RayCastInputActions input_actions = collision
+                                            ? collision->input_actions
+                                            : get_input_actions_from_node_path(ray_cast_path);
+
+        // Calculate the 2D collision point of the raycast on the Gast node.
+        Vector2 relative_collision_point = get_relative_collision_point(collision_point);
+        bool press_in_progress = handle_ray_cast_input(ray_cast_path, input_actions,
+                                                       relative_collision_point,
+                                                       capture_timestamp_nanos);
+
+        // Add the raycast to the list of colliding raycasts and update its collision info.
+        // The entry is looked up again since the input handlers may have updated the list.
+        RayCastCollision &collision_entry = colliding_ray_casts.get_or_add(ray_cast_id,
+                                                                           ray_cast_path,
+                                                                           input_actions);
+        collision_entry.press_in_progress = press_in_progress;
+        collision_entry.collision_normal = collision_normal;
+        collision_entry.collision_point = collision_point;
+
+        // Add the raycast to the captured raycasts group.
+        ray_cast.add_to_group(kCapturedGastRayCastGroupName);
+
+        return true;
+    }
 
-            continue;
+    // Cleanup
+    if (collision) {
+        GastNode *input_target = get_input_target();
+        String node_path = input_target->get_path();
+        String ray_cast_path = collision->ray_cast_path;
+
+        // Grab the last coordinates.
+        Vector2 last_coordinate = get_relative_collision_point(collision->collision_point);
+        bool press_in_progress = collision->press_in_progress;
+
+        // Remove the raycast from this node.
+        colliding_ray_casts.remove(ray_cast_id);
+
+        if (press_in_progress) {
+            // Fire a release event.
+            GastManager::get_singleton_instance()->on_render_input_release(
+                    input_target, node_path, ray_cast_path, last_coordinate.x, last_coordinate.y,
+                    capture_timestamp_nanos);
+        } else {
+            // Fire a hover exit event.
+            GastManager::get_singleton_instance()->on_render_input_hover(
+                    input_target, node_path, ray_cast_path, last_coordinate.x, last_coordinate.y,
+                    capture_timestamp_nanos);
         }
 
-        // Cleanup
-        if (has_captured_raycast(*ray_cast)) {
-            // Grab the last coordinates.
-            Vector2 last_coordinate = get_relative_collision_point(
-                    colliding_raycast_paths[ray_cast_path]->collision_point);
-            if (colliding_raycast_paths[ray_cast_path]->press_in_progress) {
-                // Fire a release event.
-                GastManager::get_singleton_instance()->on_render_input_release(node_path,
-                                                                               ray_cast_path,
-                                                                               last_coordinate.x,
-                                                                               last_coordinate.y);
-            } else {
-                // Fire a hover exit event.
-                GastManager::get_singleton_instance()->on_render_input_hover(node_path,
-                                                                             ray_cast_path,
-                                                                             last_coordinate.x,
-                                                                             last_coordinate.y);
-            }
+        // Remove the raycast from the captured raycasts group.
+        ray_cast.remove_from_group(kCapturedGastRayCastGroupName);
+    }
+    return false;
+}
 
-            // Remove the raycast from this node.
-            colliding_raycast_paths.erase(ray_cast_path);
+void GastNode::release_captured_ray_casts() {
+    GastNode *input_target = get_input_target();
+    String node_path = input_target->get_path();
+    int64_t capture_timestamp_nanos = get_monotonic_time_nanos();
+    for (const RayCastCollision &entry : colliding_ray_casts) {
+        if (entry.press_in_progress) {
+            Vector2 last_coordinate = get_relative_collision_point(entry.collision_point);
+            GastManager::get_singleton_instance()->on_render_input_release(
+                    input_target, node_path, entry.ray_cast_path, last_coordinate.x,
+                    last_coordinate.y, capture_timestamp_nanos);
+        }
 
-            // Remove the raycast from the captured raycasts group.
-            ray_cast->remove_from_group(kCapturedGastRayCastGroupName);
+        Node *node = get_node_or_null(NodePath(entry.ray_cast_path));
+        if (node) {
+            node->remove_from_group(kCapturedGastRayCastGroupName);
         }
     }
+    colliding_ray_casts.clear();
+    GastManager::get_singleton_instance()->on_ray_cast_captures_released(this);
 }
 
 bool GastNode::calculate_raycast_plane_collision(const RayCast &raycast, const Plane &plane,
@@ -471,31 +759,39 @@ ExternalTexture *GastNode::get_external_texture(int surface_index) {
     }
 
     if (external_texture) {
-        ALOGV("Found external GastNode texture for node %s", get_node_tag(*this));
+        ALOGV("Found external GastNode texture for node %s", get_node_tag(*this).get_data());
     }
     return external_texture;
 }
 
 bool
-GastNode::handle_ray_cast_input(const String &ray_cast_path, Vector2 relative_collision_point) {
+GastNode::handle_ray_cast_input(const String &ray_cast_path,
+                                const RayCastInputActions &input_actions,
+                                Vector2 relative_collision_point, int64_t capture_timestamp_nanos) {
+    GastNode *input_target = get_input_target();
+    GastManager::get_singleton_instance()->get_texture_memory_budget().mark_used(
+            input_target, capture_timestamp_nanos);
     Input *input = Input::get_singleton();
-    String node_path = get_path();
+    String node_path = input_target->get_path();
 
     float x_percent = relative_collision_point.x;
     float y_percent = relative_collision_point.y;
 
     // Check for click actions
-    String ray_cast_click_action = get_click_action_from_node_path(ray_cast_path);
+    const String &ray_cast_click_action = input_actions.click;
     const bool press_in_progress = input->is_action_pressed(ray_cast_click_action);
     if (input->is_action_just_pressed(ray_cast_click_action)) {
-        GastManager::get_singleton_instance()->on_render_input_press(node_path, ray_cast_path,
-                                                                     x_percent, y_percent);
+        GastManager::get_singleton_instance()->on_render_input_press(
+                input_target, node_path, ray_cast_path, x_percent, y_percent,
+                capture_timestamp_nanos);
     } else if (input->is_action_just_released(ray_cast_click_action)) {
-        GastManager::get_singleton_instance()->on_render_input_release(node_path, ray_cast_path,
-                                                                       x_percent, y_percent);
+        GastManager::get_singleton_instance()->on_render_input_release(
+                input_target, node_path, ray_cast_path, x_percent, y_percent,
+                capture_timestamp_nanos);
     } else {
-        GastManager::get_singleton_instance()->on_render_input_hover(node_path, ray_cast_path,
-                                                                     x_percent, y_percent);
+        GastManager::get_singleton_instance()->on_render_input_hover(
+                input_target, node_path, ray_cast_path, x_percent, y_percent,
+                capture_timestamp_nanos);
     }
 
     // Check for scrolling actions
@@ -504,10 +800,8 @@ GastNode::handle_ray_cast_input(const String &ray_cast_path, Vector2 relative_co
     float vertical_scroll_delta = 0;
 
     // Horizontal scrolls
-    String ray_cast_horizontal_left_scroll_action = get_horizontal_left_scroll_action_from_node_path(
-            ray_cast_path);
-    String ray_cast_horizontal_right_scroll_action = get_horizontal_right_scroll_action_from_node_path(
-            ray_cast_path);
+    const String &ray_cast_horizontal_left_scroll_action = input_actions.horizontal_left_scroll;
+    const String &ray_cast_horizontal_right_scroll_action = input_actions.horizontal_right_scroll;
     if (input->is_action_pressed(ray_cast_horizontal_left_scroll_action)) {
         did_scroll = true;
         horizontal_scroll_delta = -input->get_action_strength(
@@ -519,10 +813,8 @@ GastNode::handle_ray_cast_input(const String &ray_cast_path, Vector2 relative_co
     }
 
     // Vertical scrolls
-    String ray_cast_vertical_down_scroll_action = get_vertical_down_scroll_action_from_node_path(
-            ray_cast_path);
-    String ray_cast_vertical_up_scroll_action = get_vertical_up_scroll_action_from_node_path(
-            ray_cast_path);
+    const String &ray_cast_vertical_down_scroll_action = input_actions.vertical_down_scroll;
+    const String &ray_cast_vertical_up_scroll_action = input_actions.vertical_up_scroll;
     if (input->is_action_pressed(ray_cast_vertical_down_scroll_action)) {
         did_scroll = true;
         vertical_scroll_delta = -input->get_action_strength(ray_cast_vertical_down_scroll_action);
@@ -531,11 +823,14 @@ GastNode::handle_ray_cast_input(const String &ray_cast_path, Vector2 relative_co
         vertical_scroll_delta = input->get_action_strength(ray_cast_vertical_up_scroll_action);
     }
 
+    // The scroll actions are smoothed by the scroll engine, which emits the scroll events.
     if (did_scroll) {
-        GastManager::get_singleton_instance()->on_render_input_scroll(node_path, ray_cast_path,
-                                                                      x_percent, y_percent,
-                                                                      horizontal_scroll_delta,
-                                                                      vertical_scroll_delta);
+        GastManager::get_singleton_instance()->on_render_input_scroll_action(
+                input_target, node_path, ray_cast_path, x_percent, y_percent,
+                horizontal_scroll_delta, vertical_scroll_delta, capture_timestamp_nanos);
+    } else {
+        GastManager::get_singleton_instance()->on_render_input_scroll_released(node_path,
+                                                                               ray_cast_path);
     }
 
     return press_in_progress;
@@ -568,6 +863,12 @@ Vector2 GastNode::get_relative_collision_point(Vector3 absolute_collision_point)
 
         // Adjust the y coordinate to match the Android view coordinates system.
         relative_collision_point.y = 1 - relative_collision_point.y;
+
+        // Remap to the coordinates of the sampled texture when bound to a sub-rect of it (e.g: a
+        // texture atlas), since that's the surface the producer draws into.
+        Rect2 sampled_uv_rect = get_sampled_uv_rect();
+        relative_collision_point = sampled_uv_rect.position +
+                                   relative_collision_point * sampled_uv_rect.size;
     }
 
     return relative_collision_point;
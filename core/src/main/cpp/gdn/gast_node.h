@@ -2,12 +2,14 @@
 #define GAST_NODE_H
 
 #include <core/Godot.hpp>
+#include <core/Rect2.hpp>
 #include <core/Ref.hpp>
 #include <core/Vector2.hpp>
 #include <core/Vector3.hpp>
 #include <gen/CollisionShape.hpp>
 #include <gen/ConcavePolygonShape.hpp>
 #include <gen/ExternalTexture.hpp>
+#include <gen/ImageTexture.hpp>
 #include <gen/InputEvent.hpp>
 #include <gen/MeshInstance.hpp>
 #include <gen/Mesh.hpp>
@@ -17,8 +19,11 @@
 #include <gen/Shader.hpp>
 #include <gen/ShaderMaterial.hpp>
 #include <gen/StaticBody.hpp>
-#include <map>
+#include <vector>
 
+#include "scene/gast_node_registry.h"
+#include "scene/ray_cast_collisions.h"
+#include "scene/ray_cast_filter.h"
 #include "utils.h"
 
 namespace gast {
@@ -32,6 +37,7 @@ const bool kDefaultCurveValue = false;
 const bool kDefaultGazeTracking = false;
 const bool kDefaultRenderOnTop = false;
 const float kDefaultGradientHeightRatio = 0.0f;
+const Rect2 kDefaultUvRect = Rect2(0, 0, 1, 1);
 }  // namespace
 
 /// Script for a GAST node. Enables GAST specific logic and processing.
@@ -43,6 +49,11 @@ public:
 
     ~GastNode();
 
+    /// Number of GastNode instances currently alive, including the pooled ones.
+    static int64_t get_live_instance_count() {
+        return live_instance_count;
+    }
+
     static void _register_methods();
 
     void _init();
@@ -63,12 +74,17 @@ public:
 
     int get_external_texture_id(int surface_index = kInvalidSurfaceIndex);
 
+    /// Create the shader material and external texture, if not already done. This is otherwise
+    /// done when the node enters the tree.
+    void setup_material();
+
     inline void set_collidable(bool collidable) {
         if (this->collidable == collidable) {
             return;
         }
         this->collidable = collidable;
         update_collision_shape();
+        update_registry_flags();
     }
 
     inline bool is_collidable() {
@@ -81,6 +97,7 @@ public:
         }
         this->curved = curved;
         update_mesh_and_collision_shape();
+        update_registry_flags();
     }
 
     inline bool is_curved() {
@@ -95,6 +112,7 @@ public:
         this->gaze_tracking = gaze_tracking;
         update_render_priority();
         update_shader_params();
+        update_registry_flags();
     }
 
     inline bool is_gaze_tracking() {
@@ -111,6 +129,7 @@ public:
             shader_material_ref->get_shader()->set_code(generate_shader_code());
         }
         update_render_priority();
+        update_registry_flags();
     }
 
     inline bool is_render_on_top() {
@@ -133,38 +152,83 @@ public:
         update_shader_params();
     }
 
-private:
+    /// Sample the given (shared) texture atlas through the given UV sub-rect instead of this
+    /// node's own external texture.
+    void bind_to_texture_atlas(const Ref<ExternalTexture> &atlas_texture, Rect2 uv_rect);
+
+    /// Revert to sampling this node's own external texture.
+    void unbind_from_texture_atlas();
 
-    // Tracks raycast collision info.
-    struct CollisionInfo {
-        // Tracks whether a press is in progress. If so, collision is faked via simulation
-        // when the raycast no longer collides with the node.
-        bool press_in_progress;
-        Vector3 collision_point;
-        Vector3 collision_normal;
-    };
-
-    inline CollisionShape *get_collision_shape() {
-        Node *node = get_child(0);
-        CollisionShape *collision_shape = Object::cast_to<CollisionShape>(node);
-        return collision_shape;
+    inline bool is_bound_to_texture_atlas() {
+        return atlas_texture_ref.is_valid();
     }
 
-    inline MeshInstance *get_mesh_instance() {
-        CollisionShape *collision_shape = get_collision_shape();
-        if (!collision_shape) {
-            return nullptr;
-        }
+    /// Sample the texture of the given source node instead of this node's own texture, so a
+    /// single producer and texture update feed several nodes. The input received by this node
+    /// is routed to the source node.
+    /// Returns false if this node is itself the source of a shared texture.
+    bool bind_to_shared_texture(GastNode *source_node);
+
+    /// Revert to sampling this node's own texture.
+    void unbind_from_shared_texture();
+
+    inline bool is_bound_to_shared_texture() {
+        return shared_texture_source != nullptr;
+    }
 
-        Node *node = collision_shape->get_child(0);
-        MeshInstance *mesh_instance = Object::cast_to<MeshInstance>(node);
-        return mesh_instance;
+    /// Revert the nodes sharing this node's texture to their own texture.
+    void release_shared_texture_nodes();
+
+    /// Revert to this node's own texture after the node it shared the texture of was destroyed.
+    /// The destroyed node already unlinked it.
+    void on_shared_texture_source_destroyed();
+
+    /// Display a static snapshot (RGBA8 pixels, top row first) instead of the streamed texture.
+    /// This allows the streaming surface to be released while the node is idle.
+    bool set_static_snapshot(const uint8_t *rgba_data, int width, int height);
+
+    /// Revert to displaying the streamed texture.
+    void clear_static_snapshot();
+
+    inline bool has_static_snapshot() {
+        return snapshot_texture_ref.is_valid();
     }
 
+    /// Process the collision state of the given ray cast with this node.
+    /// `ray_cast_colliding` specifies whether the ray cast collides with any node, this one
+    /// included. A ray cast pressing this node is kept captured while it hits nothing.
+    /// `capture_timestamp_nanos` is the time at which the ray cast state was sampled.
+    /// @return true if the ray cast is captured by this node
+    bool process_ray_cast_collision(RayCast &ray_cast, bool collides_with_node,
+                                    bool ray_cast_colliding, Vector3 collision_point,
+                                    Vector3 collision_normal, int64_t capture_timestamp_nanos);
+
+    /// Run the input logic for the ray casts in the given pre-filter, sampled at
+    /// `capture_timestamp_nanos`. No-op if the node isn't collidable.
+    void sample_ray_casts(RayCastFilter &ray_cast_filter, int64_t capture_timestamp_nanos);
+
+    /// Release the ray casts captured by this node, ending the presses in progress.
+    void release_captured_ray_casts();
+
+    /// Flags mirrored in the GastNodeRegistry.
+    uint32_t get_registry_flags() const;
+
+    /// Refresh the node path hash mirrored in the GastNodeRegistry, after a rename. No-op if
+    /// the node isn't registered.
+    void update_registry_path_hash();
+
+    /// Map a point on the node's quad (in global space) to the coordinates reported in the input
+    /// events, i.e: percent of the node's dimensions, remapped to the sampled texture sub-rect.
+    Vector2 get_relative_collision_point(Vector3 absolute_collision_point);
+
+private:
+    static int64_t live_instance_count;
+
+    friend class GastNodeRegistry;
+
     inline Mesh *get_mesh() {
         Mesh *mesh = nullptr;
 
-        MeshInstance *mesh_instance = get_mesh_instance();
         if (mesh_instance) {
             Ref<Mesh> mesh_ref = mesh_instance->get_mesh();
             if (mesh_ref.is_valid()) {
@@ -182,7 +246,15 @@ private:
         return ray_cast;
     }
 
-    Vector2 get_relative_collision_point(Vector3 absolute_collision_point);
+    // Node the input received by this node is dispatched for.
+    inline GastNode *get_input_target() {
+        return shared_texture_source ? shared_texture_source : this;
+    }
+
+    // Sub-rect of the sampled texture, taking texture sharing into account.
+    inline Rect2 get_sampled_uv_rect() const {
+        return shared_texture_source ? shared_texture_source->uv_rect : uv_rect;
+    }
 
     static inline String get_click_action_from_node_path(const String& node_path) {
         // Replace the '/' character with a '_' character
@@ -209,6 +281,19 @@ private:
         return node_path.replace("/", "_") + "_down_scroll";
     }
 
+    static inline RayCastInputActions get_input_actions_from_node_path(const String &node_path) {
+        RayCastInputActions input_actions;
+        input_actions.click = get_click_action_from_node_path(node_path);
+        input_actions.horizontal_left_scroll =
+                get_horizontal_left_scroll_action_from_node_path(node_path);
+        input_actions.horizontal_right_scroll =
+                get_horizontal_right_scroll_action_from_node_path(node_path);
+        input_actions.vertical_up_scroll = get_vertical_up_scroll_action_from_node_path(node_path);
+        input_actions.vertical_down_scroll =
+                get_vertical_down_scroll_action_from_node_path(node_path);
+        return input_actions;
+    }
+
     ExternalTexture *get_external_texture(int surface_index);
 
     inline ShaderMaterial *get_shader_material() {
@@ -221,7 +306,9 @@ private:
                                            Vector3 *collision_point);
 
     // Handle the raycast input. Returns true if a press is in progress.
-    bool handle_ray_cast_input(const String &ray_cast_path, Vector2 relative_collision_point);
+    bool handle_ray_cast_input(const String &ray_cast_path,
+                               const RayCastInputActions &input_actions,
+                               Vector2 relative_collision_point, int64_t capture_timestamp_nanos);
 
     void update_collision_shape();
 
@@ -235,10 +322,20 @@ private:
 
     void update_shader_params();
 
+    void update_shader_texture();
+
+    void update_registry_flags();
+
     bool has_captured_raycast(const RayCast &ray_cast) {
-        return colliding_raycast_paths.count(ray_cast.get_path()) != 0;
+        return colliding_ray_casts.contains(ray_cast.get_instance_id());
     }
 
+    // Child nodes, owned by this node. They follow it across tree changes, so the pointers remain
+    // valid for its lifetime.
+    MeshInstance *mesh_instance = nullptr;
+    // Only created once the node is collidable, see update_collision_shape().
+    CollisionShape *collision_shape = nullptr;
+
     bool collidable;
     bool curved;
     bool gaze_tracking;
@@ -246,10 +343,26 @@ private:
     float gradient_height_ratio;
     Vector2 mesh_size;
     Ref<ShaderMaterial> shader_material_ref = Ref<ShaderMaterial>();
+    Ref<ExternalTexture> external_texture_ref = Ref<ExternalTexture>();
+
+    // Texture atlas sampled instead of the node's own external texture, if any.
+    Ref<ExternalTexture> atlas_texture_ref = Ref<ExternalTexture>();
+    // Sub-rect of the sampled texture, in UV coordinates.
+    Rect2 uv_rect;
+
+    // Node whose texture is sampled instead of this node's own texture, if any.
+    GastNode *shared_texture_source = nullptr;
+    // Nodes sampling this node's texture.
+    std::vector<GastNode *> shared_texture_nodes;
+
+    // Static snapshot displayed while the node's streaming surface is released.
+    Ref<ImageTexture> snapshot_texture_ref = Ref<ImageTexture>();
+
+    // Keeps track of the raycasts colliding with this node.
+    RayCastCollisions colliding_ray_casts;
 
-    // Map used to keep track of the raycasts colliding with this node.
-    // The boolean specifies whether a `press` is currently in progress.
-    std::map<String, std::shared_ptr<CollisionInfo>> colliding_raycast_paths;
+    // Index of this node in the GastNodeRegistry, managed by the registry.
+    int registry_index = kInvalidRegistryIndex;
 };
 }  // namespace gast
 
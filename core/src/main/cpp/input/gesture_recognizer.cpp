@@ -0,0 +1,152 @@
+#include "gesture_recognizer.h"
+
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+namespace {
+constexpr int64_t kNanosPerSecond = 1000000000;
+
+// Maximum movement (in percent of the node's dimensions) before a press turns into a drag.
+constexpr float kTouchSlop = 0.02f;
+// Maximum distance (in percent of the node's dimensions) between two taps of a double tap.
+constexpr float kDoubleTapSlop = 0.05f;
+// Minimum velocity (in percent of the node's dimensions per second) for a drag end to be a fling.
+constexpr float kMinFlingVelocity = 0.5f;
+// Weight given to the latest sample when smoothing the drag velocity.
+constexpr float kVelocitySmoothingFactor = 0.6f;
+
+constexpr int64_t kLongPressTimeoutNanos = 500 * 1000000LL;
+constexpr int64_t kDoubleTapTimeoutNanos = 300 * 1000000LL;
+}  // namespace
+
+GestureRecognizer::GestureRecognizer(GestureCallback callback) : callback_(std::move(callback)) {}
+
+void GestureRecognizer::on_press(const GastNode *gast_node, const String &node_path,
+                                 const String &pointer_id, Vector2 position,
+                                 int64_t timestamp_nanos) {
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemInput);
+    auto entry = pointers_.emplace(PointerKey(node_path, pointer_id), PointerState());
+    PointerState &state = entry.first->second;
+    state.gast_node = gast_node;
+    state.pressed = true;
+    state.dragging = false;
+    state.long_pressed = false;
+    state.down_position = position;
+    state.down_timestamp_nanos = timestamp_nanos;
+    state.last_position = position;
+    state.last_timestamp_nanos = timestamp_nanos;
+    state.velocity = Vector2();
+}
+
+void GestureRecognizer::on_hover(const GastNode *gast_node, const String &node_path,
+                                 const String &pointer_id, Vector2 position,
+                                 int64_t timestamp_nanos) {
+    auto it = pointers_.find(PointerKey(node_path, pointer_id));
+    if (it == pointers_.end() || !it->second.pressed) {
+        // Only pressed pointers contribute to gestures.
+        return;
+    }
+
+    PointerState &state = it->second;
+    state.gast_node = gast_node;
+    update_velocity(state, position, timestamp_nanos);
+
+    if (!state.dragging) {
+        if (state.long_pressed || state.down_position.distance_to(position) <= kTouchSlop) {
+            return;
+        }
+        state.dragging = true;
+        emit(kDragStart, it->first, state, state.down_position, state.velocity,
+             timestamp_nanos);
+    }
+
+    emit(kDragUpdate, it->first, state, position, state.velocity, timestamp_nanos);
+}
+
+void GestureRecognizer::on_release(const GastNode *gast_node, const String &node_path,
+                                   const String &pointer_id, Vector2 position,
+                                   int64_t timestamp_nanos) {
+    auto it = pointers_.find(PointerKey(node_path, pointer_id));
+    if (it == pointers_.end() || !it->second.pressed) {
+        return;
+    }
+
+    PointerState &state = it->second;
+    state.gast_node = gast_node;
+    state.pressed = false;
+
+    if (state.dragging) {
+        update_velocity(state, position, timestamp_nanos);
+        emit(kDragEnd, it->first, state, position, state.velocity, timestamp_nanos);
+        if (state.velocity.length() >= kMinFlingVelocity) {
+            emit(kFling, it->first, state, position, state.velocity, timestamp_nanos);
+        }
+        state.has_last_tap = false;
+        return;
+    }
+
+    if (state.long_pressed) {
+        state.has_last_tap = false;
+        return;
+    }
+
+    bool is_double_tap = state.has_last_tap &&
+                         timestamp_nanos - state.last_tap_timestamp_nanos <= kDoubleTapTimeoutNanos &&
+                         state.last_tap_position.distance_to(position) <= kDoubleTapSlop;
+
+    emit(kTap, it->first, state, position, Vector2(), timestamp_nanos);
+    if (is_double_tap) {
+        emit(kDoubleTap, it->first, state, position, Vector2(), timestamp_nanos);
+        state.has_last_tap = false;
+    } else {
+        state.has_last_tap = true;
+        state.last_tap_position = position;
+        state.last_tap_timestamp_nanos = timestamp_nanos;
+    }
+}
+
+void GestureRecognizer::on_frame(int64_t timestamp_nanos) {
+    for (auto it = pointers_.begin(); it != pointers_.end();) {
+        PointerState &state = it->second;
+        if (state.pressed) {
+            if (!state.dragging && !state.long_pressed &&
+                timestamp_nanos - state.down_timestamp_nanos >= kLongPressTimeoutNanos) {
+                state.long_pressed = true;
+                emit(kLongPress, it->first, state, state.last_position, Vector2(),
+                     timestamp_nanos);
+            }
+            ++it;
+        } else if (state.has_last_tap &&
+                   timestamp_nanos - state.last_tap_timestamp_nanos <= kDoubleTapTimeoutNanos) {
+            // Keep the state around until the double tap window expires.
+            ++it;
+        } else {
+            it = pointers_.erase(it);
+        }
+    }
+}
+
+void GestureRecognizer::emit(GestureType type, const PointerKey &key,
+                             const PointerState &state, Vector2 position, Vector2 velocity,
+                             int64_t timestamp_nanos) {
+    if (callback_) {
+        callback_(GestureEvent{type, state.gast_node, key.first, key.second, position, velocity,
+                               timestamp_nanos});
+    }
+}
+
+void GestureRecognizer::update_velocity(PointerState &state, Vector2 position,
+                                        int64_t timestamp_nanos) {
+    int64_t elapsed_nanos = timestamp_nanos - state.last_timestamp_nanos;
+    if (elapsed_nanos > 0) {
+        Vector2 instant_velocity = (position - state.last_position) *
+                                   ((float) kNanosPerSecond / (float) elapsed_nanos);
+        state.velocity = instant_velocity * kVelocitySmoothingFactor +
+                         state.velocity * (1.0f - kVelocitySmoothingFactor);
+    }
+    state.last_position = position;
+    state.last_timestamp_nanos = timestamp_nanos;
+}
+
+}  // namespace gast
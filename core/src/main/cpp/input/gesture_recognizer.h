@@ -0,0 +1,105 @@
+#ifndef GESTURE_RECOGNIZER_H
+#define GESTURE_RECOGNIZER_H
+
+#include <core/String.hpp>
+#include <core/Vector2.hpp>
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace gast {
+
+namespace {
+using namespace godot;
+}  // namespace
+
+class GastNode;
+
+/// Mirrors src/main/java/org/godotengine/plugin/gast/input/GastInputListener#GestureType
+enum GestureType {
+    kTap = 0,
+    kDoubleTap = 1,
+    kLongPress = 2,
+    kDragStart = 3,
+    kDragUpdate = 4,
+    kDragEnd = 5,
+    kFling = 6
+};
+
+/// High-level gesture detected from the press / hover / release stream.
+/// Coordinates are in percent of the node's dimensions, velocities in percent per second.
+struct GestureEvent {
+    GestureType type;
+    // Node the gesture applies to, only used as an identity.
+    const GastNode *gast_node;
+    String node_path;
+    String pointer_id;
+    Vector2 position;
+    Vector2 velocity;
+    int64_t timestamp_nanos;
+};
+
+/// Tracks per-pointer state from the raycast input stream and turns it into high-level gestures
+/// (tap, double tap, long press, drag, fling).
+///
+/// Long presses are time based, so on_frame() must be invoked once per frame while the
+/// recognizer is in use.
+class GestureRecognizer {
+public:
+    using GestureCallback = std::function<void(const GestureEvent &)>;
+
+    explicit GestureRecognizer(GestureCallback callback);
+
+    void on_press(const GastNode *gast_node, const String &node_path, const String &pointer_id,
+                  Vector2 position, int64_t timestamp_nanos);
+
+    void on_hover(const GastNode *gast_node, const String &node_path, const String &pointer_id,
+                  Vector2 position, int64_t timestamp_nanos);
+
+    void on_release(const GastNode *gast_node, const String &node_path,
+                    const String &pointer_id, Vector2 position, int64_t timestamp_nanos);
+
+    void on_frame(int64_t timestamp_nanos);
+
+    /// Number of (node, pointer) pairs currently tracked.
+    size_t get_pointer_count() const {
+        return pointers_.size();
+    }
+
+    /// Drop all tracked pointer state without emitting any gesture.
+    void reset() {
+        pointers_.clear();
+    }
+
+private:
+    using PointerKey = std::pair<String, String>;
+
+    struct PointerState {
+        const GastNode *gast_node = nullptr;
+        bool pressed = false;
+        bool dragging = false;
+        bool long_pressed = false;
+        Vector2 down_position;
+        int64_t down_timestamp_nanos = 0;
+        Vector2 last_position;
+        int64_t last_timestamp_nanos = 0;
+        Vector2 velocity;
+
+        // Last completed tap, used for double tap detection.
+        bool has_last_tap = false;
+        Vector2 last_tap_position;
+        int64_t last_tap_timestamp_nanos = 0;
+    };
+
+    void emit(GestureType type, const PointerKey &key, const PointerState &state,
+              Vector2 position, Vector2 velocity, int64_t timestamp_nanos);
+
+    static void update_velocity(PointerState &state, Vector2 position, int64_t timestamp_nanos);
+
+    GestureCallback callback_;
+    std::map<PointerKey, PointerState> pointers_;
+};
+
+}  // namespace gast
+
+#endif // GESTURE_RECOGNIZER_H
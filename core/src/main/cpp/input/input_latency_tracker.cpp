@@ -0,0 +1,57 @@
+#include "input/input_latency_tracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gast {
+
+void InputLatencyTracker::record(InputLatencyStage stage, int64_t latency_nanos) {
+    int64_t bucket = std::max(int64_t(0), latency_nanos) / kLatencyBucketWidthNanos;
+    Histogram &histogram = histograms_[stage];
+    histogram.buckets[std::min(bucket, int64_t(kLatencyBucketCount - 1))]++;
+    histogram.sample_count++;
+}
+
+int64_t InputLatencyTracker::get_percentile_nanos(InputLatencyStage stage,
+                                                  float percentile) const {
+    const Histogram &histogram = histograms_[stage];
+    if (histogram.sample_count == 0) {
+        return 0;
+    }
+
+    float clamped_percentile = std::min(100.0f, std::max(0.0f, percentile));
+    auto rank = std::max(int64_t(1), static_cast<int64_t>(
+            std::ceil(clamped_percentile / 100.0f * histogram.sample_count)));
+    int64_t cumulative_count = 0;
+    for (int i = 0; i < kLatencyBucketCount; i++) {
+        cumulative_count += histogram.buckets[i];
+        if (cumulative_count >= rank) {
+            return (i + 1) * kLatencyBucketWidthNanos;
+        }
+    }
+    return kLatencyBucketCount * kLatencyBucketWidthNanos;
+}
+
+const char *InputLatencyTracker::get_stage_name(InputLatencyStage stage) {
+    switch (stage) {
+        case kInputLatencyStageNativeDispatch:
+            return "native_dispatch";
+        case kInputLatencyStageJniCallback:
+            return "jni_callback";
+        case kInputLatencyStagePhysicsTickSampleAge:
+            return "physics_tick_sample_age";
+        case kInputLatencyStageRenderFrameSampleAge:
+            return "render_frame_sample_age";
+        default:
+            return "unknown";
+    }
+}
+
+void InputLatencyTracker::reset() {
+    for (Histogram &histogram : histograms_) {
+        histogram.buckets.fill(0);
+        histogram.sample_count = 0;
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,66 @@
+#ifndef INPUT_LATENCY_TRACKER_H
+#define INPUT_LATENCY_TRACKER_H
+
+#include <array>
+#include <cstdint>
+
+namespace gast {
+
+namespace {
+// Width of the latency histograms buckets.
+constexpr int64_t kLatencyBucketWidthNanos = 250000;
+// Number of latency histograms buckets. The last bucket also holds the latencies past its range,
+// i.e: 100ms and up.
+constexpr int kLatencyBucketCount = 400;
+}  // namespace
+
+/// Stages of the native input pipeline, measured from the input capture timestamp.
+/// Mirrors src/main/java/org/godotengine/plugin/gast/input/InputLatencyTracker#NativeStage
+enum InputLatencyStage {
+    // Capture to the invocation of the JNI callback, including the time spent in the gesture and
+    // scroll stages.
+    kInputLatencyStageNativeDispatch = 0,
+    // Duration of the JNI callback, i.e: the render thread handling on the Kotlin side.
+    kInputLatencyStageJniCallback = 1,
+    // Age of the latest pointer sample at the end of each rendered frame input processing, when
+    // sampled on the physics tick. Up to a physics step on headsets rendering faster than the
+    // physics rate.
+    kInputLatencyStagePhysicsTickSampleAge = 2,
+    // Age of the latest pointer sample at the end of each rendered frame input processing, when
+    // sampled once per rendered frame.
+    kInputLatencyStageRenderFrameSampleAge = 3,
+    kInputLatencyStageCount,
+};
+
+/// Aggregates the latencies of the native input stages into fixed histograms, so recording is
+/// allocation free. The percentiles are reported at the bucket granularity.
+///
+/// Not thread safe: must be used on the render thread.
+class InputLatencyTracker {
+public:
+    void record(InputLatencyStage stage, int64_t latency_nanos);
+
+    /// Latency under which `percentile` (in [0, 100]) of the samples recorded for `stage` fall,
+    /// or 0 if no sample was recorded.
+    int64_t get_percentile_nanos(InputLatencyStage stage, float percentile) const;
+
+    int64_t get_sample_count(InputLatencyStage stage) const {
+        return histograms_[stage].sample_count;
+    }
+
+    static const char *get_stage_name(InputLatencyStage stage);
+
+    void reset();
+
+private:
+    struct Histogram {
+        std::array<int64_t, kLatencyBucketCount> buckets{};
+        int64_t sample_count = 0;
+    };
+
+    std::array<Histogram, kInputLatencyStageCount> histograms_;
+};
+
+}  // namespace gast
+
+#endif // INPUT_LATENCY_TRACKER_H
@@ -0,0 +1,98 @@
+#include "scroll_engine.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+namespace {
+constexpr float kNanosPerSecond = 1000000000.0f;
+
+// The scroll action is considered released if it's not reported within this delay, e.g: when the
+// pointer moves off the node.
+constexpr int64_t kScrollReleaseTimeoutNanos = 100 * 1000000LL;
+// Longest frame duration accounted for, to avoid jumps after a stall.
+constexpr int64_t kMaxFrameDurationNanos = 100 * 1000000LL;
+// Velocity under which the fling stops.
+constexpr float kMinFlingVelocity = 0.5f;
+// Accumulated delta under which no scroll event is emitted.
+constexpr float kMinScrollDelta = 0.001f;
+}  // namespace
+
+ScrollEngine::ScrollEngine(ScrollCallback callback) : callback_(std::move(callback)) {}
+
+void ScrollEngine::on_scroll(const GastNode *gast_node, const String &node_path,
+                             const String &pointer_id, Vector2 position, Vector2 strength,
+                             int64_t timestamp_nanos) {
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemInput);
+    auto entry = pointers_.emplace(PointerKey(node_path, pointer_id), PointerState());
+    PointerState &state = entry.first->second;
+    state.gast_node = gast_node;
+    if (!state.held) {
+        state.held = true;
+        state.hold_start_timestamp_nanos = timestamp_nanos;
+    }
+    state.last_input_timestamp_nanos = timestamp_nanos;
+    state.strength = strength;
+    state.position = position;
+}
+
+void ScrollEngine::on_scroll_released(const String &node_path, const String &pointer_id) {
+    auto it = pointers_.find(PointerKey(node_path, pointer_id));
+    if (it != pointers_.end()) {
+        it->second.held = false;
+    }
+}
+
+void ScrollEngine::on_frame(int64_t timestamp_nanos) {
+    int64_t frame_duration_nanos = last_frame_timestamp_nanos_ == 0
+                                   ? 0
+                                   : std::min(timestamp_nanos - last_frame_timestamp_nanos_,
+                                              kMaxFrameDurationNanos);
+    last_frame_timestamp_nanos_ = timestamp_nanos;
+    if (pointers_.empty() || frame_duration_nanos <= 0) {
+        return;
+    }
+
+    float delta_seconds = frame_duration_nanos / kNanosPerSecond;
+    for (auto it = pointers_.begin(); it != pointers_.end();) {
+        PointerState &state = it->second;
+        if (state.held &&
+            timestamp_nanos - state.last_input_timestamp_nanos > kScrollReleaseTimeoutNanos) {
+            state.held = false;
+        }
+
+        if (state.held) {
+            float held_seconds =
+                    (timestamp_nanos - state.hold_start_timestamp_nanos) / kNanosPerSecond;
+            float multiplier = std::min(1.0f + settings_.acceleration * held_seconds,
+                                        settings_.max_acceleration_multiplier);
+            state.velocity = state.strength * settings_.speed * std::max(multiplier, 1.0f);
+        } else if (settings_.fling_friction > 0) {
+            state.velocity = state.velocity * std::exp(-settings_.fling_friction * delta_seconds);
+        } else {
+            state.velocity = Vector2();
+        }
+
+        state.pending_delta += state.velocity * delta_seconds;
+        if (std::abs(state.pending_delta.x) >= kMinScrollDelta ||
+            std::abs(state.pending_delta.y) >= kMinScrollDelta) {
+            int64_t capture_timestamp_nanos = state.held ? state.last_input_timestamp_nanos
+                                                         : timestamp_nanos;
+            callback_(ScrollEvent{state.gast_node, it->first.first, it->first.second,
+                                  state.position, state.pending_delta,
+                                  capture_timestamp_nanos});
+            state.pending_delta = Vector2();
+        }
+
+        if (!state.held && state.velocity.length() < kMinFlingVelocity) {
+            it = pointers_.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,107 @@
+#ifndef SCROLL_ENGINE_H
+#define SCROLL_ENGINE_H
+
+#include <core/String.hpp>
+#include <core/Vector2.hpp>
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace gast {
+
+namespace {
+using namespace godot;
+}  // namespace
+
+class GastNode;
+
+/// Tuning of the scroll engine.
+struct ScrollSettings {
+    // Scroll delta per second for a scroll action held at full strength.
+    float speed = 60.0f;
+    // Increase of the scroll speed multiplier per second the scroll action is held.
+    float acceleration = 0.5f;
+    // Cap on the scroll speed multiplier.
+    float max_acceleration_multiplier = 3.0f;
+    // Exponential decay rate (per second) of the fling velocity after release. 0 disables the
+    // fling.
+    float fling_friction = 4.0f;
+};
+
+/// Scroll emitted by the engine. Coordinates are in percent of the node's dimensions.
+struct ScrollEvent {
+    // Node the scroll applies to, only used as an identity.
+    const GastNode *gast_node;
+    String node_path;
+    String pointer_id;
+    Vector2 position;
+    Vector2 delta;
+    // Capture timestamp of the last scroll input, or the frame timestamp during a fling.
+    int64_t capture_timestamp_nanos;
+};
+
+/// Turns the scroll actions held by each (node, pointer) into smooth scroll events.
+///
+/// The raw scroll input is reported on every input tick while a scroll action is held. The engine
+/// accumulates it into a velocity, accelerated the longer the action is held, and emits at most one
+/// scroll event per frame with the delta accumulated since the previous frame. When the action is
+/// released, the scroll continues with an inertial fling decaying to a stop.
+///
+/// on_frame() must be invoked once per frame while the engine is in use.
+class ScrollEngine {
+public:
+    using ScrollCallback = std::function<void(const ScrollEvent &)>;
+
+    explicit ScrollEngine(ScrollCallback callback);
+
+    void set_settings(const ScrollSettings &settings) {
+        settings_ = settings;
+    }
+
+    const ScrollSettings &get_settings() const {
+        return settings_;
+    }
+
+    /// Report the scroll action strength (in [-1, 1] on each axis) held by the given pointer.
+    void on_scroll(const GastNode *gast_node, const String &node_path, const String &pointer_id,
+                   Vector2 position, Vector2 strength, int64_t timestamp_nanos);
+
+    /// Report that the given pointer no longer holds a scroll action. This starts the fling.
+    void on_scroll_released(const String &node_path, const String &pointer_id);
+
+    void on_frame(int64_t timestamp_nanos);
+
+    /// Number of (node, pointer) pairs currently tracked.
+    size_t get_pointer_count() const {
+        return pointers_.size();
+    }
+
+    /// Drop all tracked pointer state without emitting any scroll.
+    void reset() {
+        pointers_.clear();
+    }
+
+private:
+    using PointerKey = std::pair<String, String>;
+
+    struct PointerState {
+        const GastNode *gast_node = nullptr;
+        bool held = false;
+        int64_t hold_start_timestamp_nanos = 0;
+        int64_t last_input_timestamp_nanos = 0;
+        Vector2 strength;
+        Vector2 position;
+        Vector2 velocity;
+        // Delta accumulated since the last emitted event.
+        Vector2 pending_delta;
+    };
+
+    ScrollCallback callback_;
+    ScrollSettings settings_;
+    std::map<PointerKey, PointerState> pointers_;
+    int64_t last_frame_timestamp_nanos_ = 0;
+};
+
+}  // namespace gast
+
+#endif // SCROLL_ENGINE_H
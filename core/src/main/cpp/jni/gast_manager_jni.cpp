@@ -1,5 +1,7 @@
 #include <jni.h>
 #include "gast_manager.h"
+#include "memory/allocation_tracker.h"
+#include "scene/gast_node_snapshot.h"
 #include "utils.h"
 
 // Current class and package names assumed for the Java side.
@@ -27,16 +29,183 @@ JNI_METHOD(setInputActionsToMonitor)(JNIEnv *env, jobject, jobjectArray input_ac
 
     int count = env->GetArrayLength(input_actions_to_monitor);
     for (int i = 0; i < count; i++) {
-        auto input_action = (jstring) (env->GetObjectArrayElement(input_actions_to_monitor, i));
+        // Released on each iteration, so a long list of actions can't overflow the local
+        // reference table.
+        ScopedLocalRef<jstring> input_action(
+                env, (jstring) env->GetObjectArrayElement(input_actions_to_monitor, i));
         GastManager::get_singleton_instance()->add_input_actions_to_monitor(
-                jstring_to_string(env, input_action));
+                jstring_to_string(env, input_action.get()));
     }
 }
 
+JNIEXPORT void JNICALL
+JNI_METHOD(setInputSubscriptions)(JNIEnv *env, jobject, jboolean has_unscoped_listeners,
+                                  jlongArray subscribed_node_pointers) {
+    GastManager *gast_manager = GastManager::get_singleton_instance();
+    gast_manager->reset_input_subscriptions(has_unscoped_listeners);
+
+    int count = env->GetArrayLength(subscribed_node_pointers);
+    jlong *node_pointers = env->GetLongArrayElements(subscribed_node_pointers, nullptr);
+    for (int i = 0; i < count; i++) {
+        gast_manager->add_input_subscribed_node(reinterpret_cast<GastNode *>(node_pointers[i]));
+    }
+    env->ReleaseLongArrayElements(subscribed_node_pointers, node_pointers, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(setGestureDetectionEnabled)(JNIEnv *, jobject, jboolean enabled) {
+    GastManager::get_singleton_instance()->set_jni_gesture_detection_enabled(enabled);
+}
+
 JNIEXPORT void JNICALL
 JNI_METHOD(nativeUpdateNodeVisibility)(JNIEnv *env, jobject, jstring node_path, jboolean visible) {
     GastManager::get_singleton_instance()->update_node_visibility(jstring_to_string(env, node_path),
                                                                   visible);
 }
 
+JNIEXPORT jlong JNICALL
+JNI_METHOD(nativeAcquireAndBindGastNode)(JNIEnv *env, jobject, jstring parent_node_path,
+                                         jboolean empty_parent) {
+    return reinterpret_cast<intptr_t>(
+            GastManager::get_singleton_instance()->acquire_and_bind_gast_node(
+                    jstring_to_string(env, parent_node_path), empty_parent));
+}
+
+JNIEXPORT jlong JNICALL
+JNI_METHOD(nativeRequestGastNode)(JNIEnv *env, jobject, jstring parent_node_path,
+                                  jboolean empty_parent, jboolean high_priority) {
+    return GastManager::get_singleton_instance()->request_gast_node(
+            jstring_to_string(env, parent_node_path), empty_parent, high_priority);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeCancelGastNodeRequest)(JNIEnv *, jobject, jlong request_id) {
+    GastManager::get_singleton_instance()->cancel_gast_node_request(request_id);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeSetGastNodeRequestBudgetNanos)(JNIEnv *, jobject, jlong budget_nanos) {
+    GastManager::get_singleton_instance()->set_gast_node_request_budget_nanos(budget_nanos);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeSetTextureMemoryBudgetBytes)(JNIEnv *, jobject, jlong budget_bytes) {
+    GastManager::get_singleton_instance()->get_texture_memory_budget().set_budget_bytes(
+            budget_bytes);
+}
+
+JNIEXPORT jlong JNICALL JNI_METHOD(nativeGetTextureMemoryUsageBytes)(JNIEnv *, jobject) {
+    return GastManager::get_singleton_instance()->get_texture_memory_budget().get_usage_bytes();
+}
+
+JNIEXPORT void JNICALL JNI_METHOD(nativeSetPickingMode)(JNIEnv *, jobject, jint picking_mode) {
+    GastManager::get_singleton_instance()->set_picking_mode(
+            static_cast<PickingMode>(picking_mode));
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeSetInputSamplingMode)(JNIEnv *, jobject, jint input_sampling_mode) {
+    GastManager::get_singleton_instance()->set_input_sampling_mode(
+            static_cast<InputSamplingMode>(input_sampling_mode));
+}
+
+JNIEXPORT jint JNICALL
+JNI_METHOD(nativeSnapshotGastNodes)(JNIEnv *env, jobject, jobject snapshot_buffer) {
+    auto *buffer = static_cast<uint8_t *>(env->GetDirectBufferAddress(snapshot_buffer));
+    jlong capacity = env->GetDirectBufferCapacity(snapshot_buffer);
+    if (!buffer || capacity < 0) {
+        ALOGE("Invalid Gast nodes snapshot buffer");
+        return -1;
+    }
+
+    return write_gast_node_snapshot(GastManager::get_singleton_instance()->get_node_registry(),
+                                    buffer, static_cast<size_t>(capacity));
+}
+
+JNIEXPORT jlong JNICALL
+JNI_METHOD(nativePick)(JNIEnv *env, jobject, jfloat origin_x, jfloat origin_y, jfloat origin_z,
+                       jfloat direction_x, jfloat direction_y, jfloat direction_z,
+                       jfloat max_distance, jfloatArray result_values) {
+    GastNodePickResult result;
+    if (!GastManager::get_singleton_instance()->pick(
+            Vector3(origin_x, origin_y, origin_z), Vector3(direction_x, direction_y, direction_z),
+            max_distance, &result)) {
+        return 0;
+    }
+
+    jfloat values[] = {result.uv.x, result.uv.y, result.distance};
+    env->SetFloatArrayRegion(result_values, 0, 3, values);
+    return (jlong) reinterpret_cast<intptr_t>(result.gast_node);
+}
+
+JNIEXPORT void JNICALL JNI_METHOD(nativeRecordUpdatedPixels)(JNIEnv *, jobject, jlong pixels) {
+    GastManager::get_singleton_instance()->record_updated_pixels(pixels);
+}
+
+JNIEXPORT jlong JNICALL JNI_METHOD(nativeGetUpdatedPixelsPerFrame)(JNIEnv *, jobject) {
+    return GastManager::get_singleton_instance()->get_updated_pixels_per_frame();
+}
+
+JNIEXPORT jlong JNICALL JNI_METHOD(nativeGetTestedRayCastPairsPerFrame)(JNIEnv *, jobject) {
+    return GastManager::get_singleton_instance()->get_ray_cast_filter()
+            .get_tested_pairs_per_frame();
+}
+
+JNIEXPORT jlong JNICALL JNI_METHOD(nativeGetCulledRayCastPairsPerFrame)(JNIEnv *, jobject) {
+    return GastManager::get_singleton_instance()->get_ray_cast_filter()
+            .get_culled_pairs_per_frame();
+}
+
+JNIEXPORT jlong JNICALL JNI_METHOD(nativeGetHeapAllocationsPerFrame)(JNIEnv *, jobject) {
+    return AllocationTracker::get_allocations_per_frame();
+}
+
+JNIEXPORT jlong JNICALL
+JNI_METHOD(nativeGetInputLatencyPercentileNanos)(JNIEnv *, jobject, jint stage, jfloat percentile) {
+    if (stage < 0 || stage >= kInputLatencyStageCount) {
+        ALOGE("Invalid input latency stage %d", stage);
+        return 0;
+    }
+    return GastManager::get_singleton_instance()->get_input_latency_tracker()
+            .get_percentile_nanos(static_cast<InputLatencyStage>(stage), percentile);
+}
+
+JNIEXPORT jlong JNICALL
+JNI_METHOD(nativeGetInputLatencySampleCount)(JNIEnv *, jobject, jint stage) {
+    if (stage < 0 || stage >= kInputLatencyStageCount) {
+        ALOGE("Invalid input latency stage %d", stage);
+        return 0;
+    }
+    return GastManager::get_singleton_instance()->get_input_latency_tracker()
+            .get_sample_count(static_cast<InputLatencyStage>(stage));
+}
+
+JNIEXPORT void JNICALL JNI_METHOD(nativeResetInputLatencyStats)(JNIEnv *, jobject) {
+    GastManager::get_singleton_instance()->get_input_latency_tracker().reset();
+}
+
+JNIEXPORT jobjectArray JNICALL JNI_METHOD(nativeGetGrowingResources)(JNIEnv *env, jobject) {
+    std::vector<const char *> growing_gauges =
+            GastManager::get_singleton_instance()->get_growth_watchdog().get_growing_gauges();
+    ScopedLocalRef<jclass> string_class(env, env->FindClass("java/lang/String"));
+    jobjectArray growing_resources = env->NewObjectArray(growing_gauges.size(),
+                                                         string_class.get(), nullptr);
+    for (size_t i = 0; i < growing_gauges.size(); i++) {
+        ScopedLocalRef<jstring> name(env, env->NewStringUTF(growing_gauges[i]));
+        env->SetObjectArrayElement(growing_resources, i, name.get());
+    }
+    return growing_resources;
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeSetScrollSettings)(JNIEnv *, jobject, jfloat speed, jfloat acceleration,
+                                    jfloat max_acceleration_multiplier, jfloat fling_friction) {
+    ScrollSettings settings;
+    settings.speed = speed;
+    settings.acceleration = acceleration;
+    settings.max_acceleration_multiplier = max_acceleration_multiplier;
+    settings.fling_friction = fling_friction;
+    GastManager::get_singleton_instance()->set_scroll_settings(settings);
+}
+
 }
@@ -22,21 +22,10 @@ inline GastNode *from_pointer(jlong gast_node_pointer) {
     return reinterpret_cast<GastNode *>(gast_node_pointer);
 }
 
-inline jlong to_pointer(GastNode *gast_node) {
-    return reinterpret_cast<intptr_t>(gast_node);
-}
-
 }  // namespace
 
 extern "C" {
 
-JNIEXPORT jlong JNICALL
-JNI_METHOD(acquireAndBindGastNode)(JNIEnv *env, jobject, jstring parent_node_path,
-                                   jboolean empty_parent) {
-    return to_pointer(GastManager::get_singleton_instance()->acquire_and_bind_gast_node(
-            jstring_to_string(env, parent_node_path), empty_parent));
-}
-
 JNIEXPORT void JNICALL
 JNI_METHOD(unbindAndReleaseGastNode)(JNIEnv *, jobject, jlong node_pointer) {
     GastManager::get_singleton_instance()->unbind_and_release_gast_node(from_pointer(node_pointer));
@@ -57,6 +46,7 @@ JNI_METHOD(nativeSetName)(JNIEnv *env, jobject, jlong node_pointer, jstring new_
     GastNode *gast_node = from_pointer(node_pointer);
     ERR_FAIL_NULL(gast_node);
     gast_node->set_name(jstring_to_string(env, new_name));
+    gast_node->update_registry_path_hash();
 }
 
 JNIEXPORT jboolean JNICALL
@@ -74,6 +64,23 @@ JNI_METHOD(getTextureId)(JNIEnv *, jobject, jlong node_pointer, jint surface_ind
     return gast_node->get_external_texture_id(surface_index);
 }
 
+JNIEXPORT jboolean JNICALL
+JNI_METHOD(nativeBindToSharedTexture)(JNIEnv *, jobject, jlong node_pointer,
+                                      jlong source_node_pointer) {
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL_V(gast_node, false);
+    GastNode *source_node = from_pointer(source_node_pointer);
+    ERR_FAIL_NULL_V(source_node, false);
+    return gast_node->bind_to_shared_texture(source_node);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeUnbindFromSharedTexture)(JNIEnv *, jobject, jlong node_pointer) {
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL(gast_node);
+    gast_node->unbind_from_shared_texture();
+}
+
 JNIEXPORT void JNICALL
 JNI_METHOD(updateGastNodeVisibility)(JNIEnv *, jobject, jlong node_pointer,
                                      jboolean should_duplicate_parent_visibility,
@@ -188,4 +195,35 @@ JNI_METHOD(updateGastNodeLocalRotation)(JNIEnv *, jobject, jlong node_pointer,
     gast_node->set_rotation_degrees(Vector3(x_rotation, y_rotation, z_rotation));
 }
 
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeRecordTextureMemory)(JNIEnv *, jobject, jlong node_pointer, jint width,
+                                      jint height, jint bits_per_pixel) {
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL(gast_node);
+    GastManager::get_singleton_instance()->get_texture_memory_budget().record_texture(
+            gast_node, width, height, bits_per_pixel);
+}
+
+JNIEXPORT jboolean JNICALL
+JNI_METHOD(nativeSetStaticSnapshot)(JNIEnv *env, jobject, jlong node_pointer, jobject rgba_buffer,
+                                    jint width, jint height) {
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL_V(gast_node, false);
+
+    auto *rgba_data = static_cast<const uint8_t *>(env->GetDirectBufferAddress(rgba_buffer));
+    if (!rgba_data || env->GetDirectBufferCapacity(rgba_buffer) < (jlong) width * height * 4) {
+        ALOGE("Invalid snapshot buffer for %s", get_node_tag(*gast_node).get_data());
+        return false;
+    }
+
+    return gast_node->set_static_snapshot(rgba_data, width, height);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeClearStaticSnapshot)(JNIEnv *, jobject, jlong node_pointer) {
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL(gast_node);
+    gast_node->clear_static_snapshot();
+}
+
 }
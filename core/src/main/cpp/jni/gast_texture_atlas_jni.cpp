@@ -0,0 +1,71 @@
+#include <jni.h>
+#include "gdn/gast_node.h"
+#include "gast_manager.h"
+#include "texture/texture_atlas.h"
+#include "utils.h"
+
+// Current class and package names assumed for the Java side.
+#undef JNI_PACKAGE_NAME
+#define JNI_PACKAGE_NAME org_godotengine_plugin_gast
+
+#undef JNI_CLASS_NAME
+#define JNI_CLASS_NAME GastTextureAtlas
+
+namespace {
+using namespace gast;
+
+inline GastNode *from_pointer(jlong gast_node_pointer) {
+    return reinterpret_cast<GastNode *>(gast_node_pointer);
+}
+
+inline TextureAtlas *get_texture_atlas(jint atlas_id) {
+    return GastManager::get_singleton_instance()->get_texture_atlas(atlas_id);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL
+JNI_METHOD(nativeCreateTextureAtlas)(JNIEnv *, jobject, jint width, jint height) {
+    return GastManager::get_singleton_instance()->create_texture_atlas(width, height);
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeReleaseTextureAtlas)(JNIEnv *, jobject, jint atlas_id) {
+    GastManager::get_singleton_instance()->release_texture_atlas(atlas_id);
+}
+
+JNIEXPORT jint JNICALL
+JNI_METHOD(nativeGetTextureId)(JNIEnv *, jobject, jint atlas_id) {
+    TextureAtlas *texture_atlas = get_texture_atlas(atlas_id);
+    ERR_FAIL_NULL_V(texture_atlas, kInvalidTexId);
+    return texture_atlas->get_external_texture_id();
+}
+
+JNIEXPORT jboolean JNICALL
+JNI_METHOD(nativeAllocateRegion)(JNIEnv *env, jobject, jint atlas_id, jlong node_pointer,
+                                 jint width, jint height, jintArray region_out) {
+    TextureAtlas *texture_atlas = get_texture_atlas(atlas_id);
+    ERR_FAIL_NULL_V(texture_atlas, false);
+    GastNode *gast_node = from_pointer(node_pointer);
+    ERR_FAIL_NULL_V(gast_node, false);
+
+    AtlasRegion region = texture_atlas->allocate_region(gast_node, width, height);
+    if (!region.is_valid()) {
+        return false;
+    }
+
+    jint region_values[] = {region.x, region.y, region.width, region.height};
+    env->SetIntArrayRegion(region_out, 0, 4, region_values);
+    return true;
+}
+
+JNIEXPORT void JNICALL
+JNI_METHOD(nativeReleaseRegion)(JNIEnv *, jobject, jint atlas_id, jlong node_pointer) {
+    TextureAtlas *texture_atlas = get_texture_atlas(atlas_id);
+    ERR_FAIL_NULL(texture_atlas);
+    texture_atlas->release_region(from_pointer(node_pointer));
+}
+
+}
@@ -0,0 +1,126 @@
+#include "logging.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <pthread.h>
+#include <thread>
+
+namespace gast {
+
+namespace {
+// How long the drain thread sleeps when the ring buffer is empty.
+constexpr std::chrono::milliseconds kDrainInterval(5);
+
+std::thread drain_thread;
+}  // namespace
+
+AsyncLogSink::Slot AsyncLogSink::slots_[AsyncLogSink::kCapacity];
+std::atomic<size_t> AsyncLogSink::write_position_(0);
+size_t AsyncLogSink::read_position_ = 0;
+std::atomic<bool> AsyncLogSink::running_(false);
+std::atomic<uint64_t> AsyncLogSink::dropped_count_(0);
+
+void log_print(int priority, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    size_t position;
+    AsyncLogSink::Slot *slot = AsyncLogSink::is_running() ? AsyncLogSink::acquire_slot(&position)
+                                                          : nullptr;
+    if (slot) {
+        slot->priority = priority;
+        vsnprintf(slot->message, AsyncLogSink::kMaxMessageLength, format, args);
+        AsyncLogSink::publish_slot(slot, position);
+    } else if (!AsyncLogSink::is_running()) {
+        __android_log_vprint(priority, LOG_TAG, format, args);
+    }
+
+    va_end(args);
+}
+
+void AsyncLogSink::start() {
+    if (is_running()) {
+        return;
+    }
+
+    for (size_t i = 0; i < kCapacity; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    write_position_.store(0, std::memory_order_relaxed);
+    read_position_ = 0;
+    dropped_count_.store(0, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+
+    drain_thread = std::thread([]() {
+        pthread_setname_np(pthread_self(), "GastLogSink");
+        while (is_running()) {
+            drain();
+            std::this_thread::sleep_for(kDrainInterval);
+        }
+    });
+}
+
+void AsyncLogSink::stop() {
+    if (!is_running()) {
+        return;
+    }
+
+    running_.store(false, std::memory_order_release);
+    if (drain_thread.joinable()) {
+        drain_thread.join();
+    }
+
+    // Flush whatever was published before the sink stopped.
+    drain();
+}
+
+AsyncLogSink::Slot *AsyncLogSink::acquire_slot(size_t *position) {
+    size_t current_position = write_position_.load(std::memory_order_relaxed);
+    while (true) {
+        Slot *slot = &slots_[current_position & (kCapacity - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) current_position;
+        if (difference == 0) {
+            if (write_position_.compare_exchange_weak(current_position, current_position + 1,
+                                                      std::memory_order_relaxed)) {
+                *position = current_position;
+                return slot;
+            }
+        } else if (difference < 0) {
+            // The ring buffer is full.
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            current_position = write_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncLogSink::publish_slot(Slot *slot, size_t position) {
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void AsyncLogSink::drain() {
+    // Single consumer: only invoked from the drain thread, or from stop() once it's joined.
+    while (true) {
+        Slot *slot = &slots_[read_position_ & (kCapacity - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != read_position_ + 1) {
+            // Empty, or the next slot is still being written.
+            break;
+        }
+
+        __android_log_write(slot->priority, LOG_TAG, slot->message);
+        slot->sequence.store(read_position_ + kCapacity, std::memory_order_release);
+        read_position_++;
+    }
+
+    uint64_t dropped_count = dropped_count_.exchange(0, std::memory_order_relaxed);
+    if (dropped_count > 0) {
+        __android_log_print(ANDROID_LOG_WARN, LOG_TAG, "Log sink dropped %llu messages.",
+                            (unsigned long long) dropped_count);
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,97 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <android/log.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define LOG_TAG "GAST"
+
+/**
+ * Minimum priority (Android log priority) of the log statements compiled into the library.
+ *
+ * Log statements below this level are discarded at compile time, along with the evaluation of
+ * their arguments. Set by the build (see CMakeLists.txt); defaults to verbose for debug builds
+ * and to warnings for release builds.
+ */
+#ifndef GAST_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define GAST_MIN_LOG_LEVEL ANDROID_LOG_WARN
+#else
+#define GAST_MIN_LOG_LEVEL ANDROID_LOG_VERBOSE
+#endif
+#endif
+
+/**
+ * Logs the printf style arguments with the given priority.
+ *
+ * The arguments are only evaluated and formatted if the priority is compiled in, so disabled
+ * levels cost nothing.
+ */
+#define GAST_LOG(priority, ...)                              \
+    do {                                                     \
+        if constexpr ((priority) >= GAST_MIN_LOG_LEVEL) {    \
+            gast::log_print((priority), __VA_ARGS__);        \
+        }                                                    \
+    } while (0)
+
+#define ALOG_ASSERT(_cond, ...) \
+    if (!(_cond)) __android_log_assert("conditional", LOG_TAG, __VA_ARGS__)
+#define ALOGE(...) GAST_LOG(ANDROID_LOG_ERROR, __VA_ARGS__)
+#define ALOGW(...) GAST_LOG(ANDROID_LOG_WARN, __VA_ARGS__)
+#define ALOGV(...) GAST_LOG(ANDROID_LOG_VERBOSE, __VA_ARGS__)
+
+namespace gast {
+
+/// Formats and writes the log message, either directly to logcat or to the async log sink if it's
+/// running. Use the ALOG* macros instead of calling this directly.
+void log_print(int priority, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * Optional non-blocking log sink.
+ *
+ * While running, log statements are formatted into a fixed size lock-free ring buffer instead of
+ * being written synchronously to logcat, and a background thread drains the buffer. Producers
+ * never block: messages are dropped (and counted) when the buffer is full.
+ */
+class AsyncLogSink {
+public:
+    static void start();
+
+    static void stop();
+
+    static bool is_running() {
+        return running_.load(std::memory_order_acquire);
+    }
+
+private:
+    friend void log_print(int priority, const char *format, ...);
+
+    static constexpr size_t kCapacity = 256;  // Must be a power of two.
+    static constexpr size_t kMaxMessageLength = 256;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        int priority;
+        char message[kMaxMessageLength];
+    };
+
+    /// Reserves a slot for writing. Returns nullptr if the ring buffer is full.
+    static Slot *acquire_slot(size_t *position);
+
+    static void publish_slot(Slot *slot, size_t position);
+
+    static void drain();
+
+    static Slot slots_[kCapacity];
+    static std::atomic<size_t> write_position_;
+    static size_t read_position_;
+    static std::atomic<bool> running_;
+    // Messages dropped because the ring buffer was full, reported and reset on drain.
+    static std::atomic<uint64_t> dropped_count_;
+};
+
+}  // namespace gast
+
+#endif // LOGGING_H
@@ -0,0 +1,64 @@
+#include <cstdlib>
+#include <new>
+
+#include "memory/allocation_tracker.h"
+
+// Replacement of the global allocation functions, so the AllocationTracker counts all the heap
+// allocations made by the Gast code, rather than a hand-picked set of sites. The allocations are
+// still served by malloc, so memory allocated here can be released by the C++ runtime, and the
+// other way around.
+#ifdef GAST_ALLOCATION_TRACKING
+
+namespace {
+
+void *allocate(size_t size) {
+    gast::AllocationTracker::record_allocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace
+
+void *operator new(size_t size) {
+    if (void *pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+    std::free(pointer);
+}
+
+#endif // GAST_ALLOCATION_TRACKING
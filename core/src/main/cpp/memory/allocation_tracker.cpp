@@ -0,0 +1,42 @@
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+AllocationTracker::SubsystemCounters AllocationTracker::counters_[kAllocationSubsystemCount];
+
+void AllocationTracker::on_frame() {
+    for (SubsystemCounters &counters : counters_) {
+        counters.allocations_per_frame =
+                counters.frame_allocations.exchange(0, std::memory_order_relaxed);
+        counters.allocated_bytes_per_frame =
+                counters.frame_allocated_bytes.exchange(0, std::memory_order_relaxed);
+        counters.total_allocations += counters.allocations_per_frame;
+    }
+}
+
+int64_t AllocationTracker::get_allocations_per_frame() {
+    int64_t allocations = 0;
+    for (const SubsystemCounters &counters : counters_) {
+        allocations += counters.allocations_per_frame;
+    }
+    return allocations;
+}
+
+const char *AllocationTracker::get_subsystem_name(AllocationSubsystem subsystem) {
+    switch (subsystem) {
+        case kAllocationSubsystemInput:
+            return "input";
+        case kAllocationSubsystemScene:
+            return "scene";
+        case kAllocationSubsystemTexture:
+            return "texture";
+        case kAllocationSubsystemFrameArena:
+            return "frame_arena";
+        case kAllocationSubsystemOther:
+            return "other";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,123 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gast {
+
+/// Whether the heap allocations made by the Gast code are counted. Set by the build (see
+/// CMakeLists.txt); enabled by default for debug builds.
+#ifdef GAST_ALLOCATION_TRACKING
+constexpr bool kAllocationTrackingEnabled = true;
+#else
+constexpr bool kAllocationTrackingEnabled = false;
+#endif
+
+/// Subsystems the heap allocations are attributed to.
+enum AllocationSubsystem {
+    // Gesture and scroll stages, ray casts collisions.
+    kAllocationSubsystemInput = 0,
+    // Node registry passes, picking, ray cast filtering.
+    kAllocationSubsystemScene = 1,
+    // Texture memory budget, texture atlases.
+    kAllocationSubsystemTexture = 2,
+    // Frame arena growth and spill over.
+    kAllocationSubsystemFrameArena = 3,
+    // Everything outside of a ScopedAllocationSubsystem, e.g: the JNI and GDNative entry points.
+    kAllocationSubsystemOther = 4,
+    kAllocationSubsystemCount,
+};
+
+/// Debug counter of the heap allocations made by the Gast code, per frame and per subsystem.
+///
+/// With GAST_ALLOCATION_TRACKING defined, the global allocation functions are replaced (see
+/// allocation_hooks.cpp), so every heap allocation made by the Gast code is counted, on any
+/// thread. Each allocation is attributed to the innermost ScopedAllocationSubsystem of the
+/// allocating thread. Allocations made by the engine on behalf of the Gast code (e.g:
+/// godot::String, godot::Array) go through the engine allocator and aren't counted.
+/// Recording compiles to nothing otherwise.
+class AllocationTracker {
+public:
+    /// Record an allocation made by the calling thread, in its current subsystem.
+    static inline void record_allocation(size_t bytes) {
+        record_allocation(current_subsystem_, bytes);
+    }
+
+    static inline void record_allocation(AllocationSubsystem subsystem, size_t bytes) {
+        if constexpr (kAllocationTrackingEnabled) {
+            SubsystemCounters &counters = counters_[subsystem];
+            counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.frame_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    /// Close the current frame. Invoked by the GastManager at the start of each frame.
+    static void on_frame();
+
+    /// Number of heap allocations recorded during the last frame, for all the subsystems.
+    static int64_t get_allocations_per_frame();
+
+    /// Number of heap allocations recorded during the last frame for the given subsystem.
+    static int64_t get_allocations_per_frame(AllocationSubsystem subsystem) {
+        return counters_[subsystem].allocations_per_frame;
+    }
+
+    /// Bytes allocated on the heap during the last frame for the given subsystem.
+    static int64_t get_allocated_bytes_per_frame(AllocationSubsystem subsystem) {
+        return counters_[subsystem].allocated_bytes_per_frame;
+    }
+
+    /// Number of heap allocations recorded since startup for the given subsystem.
+    static int64_t get_total_allocations(AllocationSubsystem subsystem) {
+        return counters_[subsystem].total_allocations;
+    }
+
+    static const char *get_subsystem_name(AllocationSubsystem subsystem);
+
+private:
+    friend class ScopedAllocationSubsystem;
+
+    struct SubsystemCounters {
+        std::atomic<int64_t> frame_allocations{0};
+        std::atomic<int64_t> frame_allocated_bytes{0};
+        int64_t allocations_per_frame = 0;
+        int64_t allocated_bytes_per_frame = 0;
+        int64_t total_allocations = 0;
+    };
+
+    static SubsystemCounters counters_[kAllocationSubsystemCount];
+
+    // Constant initialized, so it's safe to access from the allocation functions.
+    static inline thread_local AllocationSubsystem current_subsystem_ = kAllocationSubsystemOther;
+};
+
+/// Attributes the heap allocations made by the calling thread within the scope to the given
+/// subsystem.
+class ScopedAllocationSubsystem {
+public:
+    explicit ScopedAllocationSubsystem(AllocationSubsystem subsystem)
+            : previous_subsystem_(AllocationTracker::current_subsystem_) {
+        if constexpr (kAllocationTrackingEnabled) {
+            AllocationTracker::current_subsystem_ = subsystem;
+        }
+    }
+
+    ScopedAllocationSubsystem(const ScopedAllocationSubsystem &) = delete;
+
+    ScopedAllocationSubsystem &operator=(const ScopedAllocationSubsystem &) = delete;
+
+    ~ScopedAllocationSubsystem() {
+        if constexpr (kAllocationTrackingEnabled) {
+            AllocationTracker::current_subsystem_ = previous_subsystem_;
+        }
+    }
+
+private:
+    AllocationSubsystem previous_subsystem_;
+};
+
+}  // namespace gast
+
+#endif // ALLOCATION_TRACKER_H
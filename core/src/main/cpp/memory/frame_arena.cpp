@@ -0,0 +1,39 @@
+#include "memory/frame_arena.h"
+
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+FrameArena::FrameArena(size_t capacity) : buffer_(new uint8_t[capacity]), capacity_(capacity) {}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+    used_bytes_ += size;
+
+    auto base = reinterpret_cast<uintptr_t>(buffer_.get());
+    uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t) (alignment - 1);
+    size_t aligned_offset = aligned - base;
+    if (aligned_offset + size <= capacity_) {
+        offset_ = aligned_offset + size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Spill over to a dedicated block, over-allocated to honor the requested alignment.
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemFrameArena);
+    overflow_blocks_.emplace_back(new uint8_t[size + alignment]);
+    auto block = reinterpret_cast<uintptr_t>(overflow_blocks_.back().get());
+    return reinterpret_cast<void *>((block + alignment - 1) & ~(uintptr_t) (alignment - 1));
+}
+
+void FrameArena::reset() {
+    if (!overflow_blocks_.empty()) {
+        // Grow to the high water mark, with some headroom, so the next frames fit in the buffer.
+        ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemFrameArena);
+        overflow_blocks_.clear();
+        capacity_ = used_bytes_ + used_bytes_ / 2;
+        buffer_.reset(new uint8_t[capacity_]);
+    }
+    offset_ = 0;
+    used_bytes_ = 0;
+}
+
+}  // namespace gast
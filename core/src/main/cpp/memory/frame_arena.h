@@ -0,0 +1,106 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gast {
+
+namespace {
+constexpr size_t kDefaultFrameArenaCapacity = 16 * 1024;
+}  // namespace
+
+/// Bump allocator for the transient objects of a frame (ray cast dispatch, per-frame passes
+/// scratch data).
+///
+/// Allocation bumps an offset in a single buffer, and reset() rewinds it at the start of each
+/// frame: the objects allocated from the arena must not outlive the frame, and their destructors
+/// are never invoked. When the buffer runs out, the allocations spill over to separate heap
+/// blocks, and the buffer is grown to the frame's high water mark on the next reset so the steady
+/// state is allocation free.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = kDefaultFrameArenaCapacity);
+
+    FrameArena(const FrameArena &) = delete;
+
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /// Construct a T in the arena. T must be trivially destructible.
+    template<typename T, typename... Args>
+    T *create(Args &&... args) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Frame arena objects are never destroyed.");
+        return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /// Release all the allocations of the previous frame.
+    void reset();
+
+    size_t get_capacity() const {
+        return capacity_;
+    }
+
+    /// Bytes allocated since the last reset, including the spill over blocks.
+    size_t get_used_bytes() const {
+        return used_bytes_;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t capacity_;
+    size_t offset_ = 0;
+    size_t used_bytes_ = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> overflow_blocks_;
+};
+
+/// Standard allocator adapter allocating from a FrameArena, for the transient containers of a
+/// frame. Deallocation is a no-op.
+template<typename T>
+class FrameArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit FrameArenaAllocator(FrameArena &arena) : arena_(&arena) {}
+
+    template<typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U> &other) : arena_(other.get_arena()) {}
+
+    T *allocate(size_t count) {
+        return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, size_t) {}
+
+    FrameArena *get_arena() const {
+        return arena_;
+    }
+
+    template<typename U>
+    bool operator==(const FrameArenaAllocator<U> &other) const {
+        return arena_ == other.get_arena();
+    }
+
+    template<typename U>
+    bool operator!=(const FrameArenaAllocator<U> &other) const {
+        return arena_ != other.get_arena();
+    }
+
+private:
+    FrameArena *arena_;
+};
+
+/// Vector allocated from a FrameArena.
+template<typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+}  // namespace gast
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,66 @@
+#include "memory/growth_watchdog.h"
+
+#include "logging.h"
+
+namespace gast {
+
+void GrowthWatchdog::add_gauge(const char *name, Gauge gauge) {
+    GaugeState state;
+    state.name = name;
+    state.gauge = std::move(gauge);
+    state.last_value = state.gauge();
+    state.run_start_value = state.last_value;
+    gauges_.push_back(std::move(state));
+}
+
+void GrowthWatchdog::on_frame(int64_t timestamp_nanos) {
+    if (last_sample_nanos_ == 0) {
+        last_sample_nanos_ = timestamp_nanos;
+        return;
+    }
+
+    if (timestamp_nanos - last_sample_nanos_ < kGrowthWatchdogSamplingIntervalNanos) {
+        return;
+    }
+    last_sample_nanos_ = timestamp_nanos;
+
+    for (GaugeState &state : gauges_) {
+        sample(state);
+    }
+}
+
+void GrowthWatchdog::sample(GaugeState &state) {
+    int64_t value = state.gauge();
+    if (value < state.last_value) {
+        // The resource was reclaimed, start a new run.
+        state.run_start_value = value;
+        state.run_length = 0;
+        state.run_increases = 0;
+        state.growing = false;
+    } else {
+        state.run_length++;
+        if (value > state.last_value) {
+            state.run_increases++;
+        }
+    }
+    state.last_value = value;
+
+    if (!state.growing && state.run_length >= kGrowthWatchdogSamplesThreshold &&
+        state.run_increases >= kGrowthWatchdogIncreasesThreshold) {
+        state.growing = true;
+        ALOGW("Monotonic growth of %s: from %lld to %lld over %d samples.", state.name,
+              (long long) state.run_start_value, (long long) value, state.run_length);
+    }
+}
+
+std::vector<const char *> GrowthWatchdog::get_growing_gauges() const {
+    std::vector<const char *> growing_gauges;
+    for (const GaugeState &state : gauges_) {
+        if (state.growing) {
+            growing_gauges.push_back(state.name);
+        }
+    }
+    return growing_gauges;
+}
+
+}  // namespace gast
@@ -0,0 +1,63 @@
+#ifndef GROWTH_WATCHDOG_H
+#define GROWTH_WATCHDOG_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace gast {
+
+namespace {
+// Interval between two samples of the gauges.
+constexpr int64_t kGrowthWatchdogSamplingIntervalNanos = 30 * 1000000000LL;
+// Number of consecutive non decreasing samples after which a gauge which kept growing is
+// flagged, i.e: 10 minutes without ever shrinking.
+constexpr int kGrowthWatchdogSamplesThreshold = 20;
+// Minimum number of strictly increasing samples within that run. A single step up followed by a
+// plateau (e.g: a pool filled once) isn't a leak.
+constexpr int kGrowthWatchdogIncreasesThreshold = kGrowthWatchdogSamplesThreshold / 2;
+}  // namespace
+
+/// Watches gauges of the long lived resources (nodes, pools, registries...) for monotonic growth.
+///
+/// A resource used in steady state plateaus or oscillates; one that grows without ever
+/// shrinking over a long period is most likely leaking. The gauges are sampled every
+/// kGrowthWatchdogSamplingIntervalNanos, and a gauge is flagged as growing (and logged once) when
+/// it didn't decrease over the last kGrowthWatchdogSamplesThreshold samples while going up on at
+/// least kGrowthWatchdogIncreasesThreshold of them. The flag is cleared as soon as the gauge
+/// decreases.
+class GrowthWatchdog {
+public:
+    using Gauge = std::function<int64_t()>;
+
+    /// Watch the given gauge. `name` must outlive the watchdog.
+    void add_gauge(const char *name, Gauge gauge);
+
+    /// Invoked once per frame. The gauges are only sampled at the sampling interval.
+    void on_frame(int64_t timestamp_nanos);
+
+    /// Names of the gauges currently flagged as growing.
+    std::vector<const char *> get_growing_gauges() const;
+
+private:
+    struct GaugeState {
+        const char *name;
+        Gauge gauge;
+        int64_t last_value = 0;
+        // Value at the start of the current non decreasing run.
+        int64_t run_start_value = 0;
+        int run_length = 0;
+        // Number of samples of the current run greater than the previous one.
+        int run_increases = 0;
+        bool growing = false;
+    };
+
+    void sample(GaugeState &state);
+
+    std::vector<GaugeState> gauges_;
+    int64_t last_sample_nanos_ = 0;
+};
+
+}  // namespace gast
+
+#endif // GROWTH_WATCHDOG_H
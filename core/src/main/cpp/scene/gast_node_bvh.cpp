@@ -0,0 +1,282 @@
+#include "scene/gast_node_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gdn/gast_node.h"
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+namespace {
+// Padding added to the bounds, since a quad facing an axis has flat bounds.
+constexpr float kBoundsPadding = 0.0001f;
+constexpr float kParallelRayEpsilon = 0.000001f;
+}  // namespace
+
+void GastNodeBvh::Bounds::expand_to(const Vector3 &point) {
+    for (int axis = 0; axis < 3; axis++) {
+        min[axis] = std::min(min[axis], point[axis]);
+        max[axis] = std::max(max[axis], point[axis]);
+    }
+}
+
+void GastNodeBvh::Bounds::merge_with(const Bounds &bounds) {
+    expand_to(bounds.min);
+    expand_to(bounds.max);
+}
+
+bool GastNodeBvh::Bounds::operator==(const Bounds &other) const {
+    for (int axis = 0; axis < 3; axis++) {
+        if (min[axis] != other.min[axis] || max[axis] != other.max[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GastNodeBvh::update(GastNodeRegistry &registry) {
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemScene);
+    if (registry.get_layout_version() != layout_version_) {
+        rebuild(registry);
+    } else if (registry.has_dirty_bounds()) {
+        refit(registry);
+    }
+    registry.clear_dirty_bounds();
+}
+
+void GastNodeBvh::rebuild(const GastNodeRegistry &registry) {
+    layout_version_ = registry.get_layout_version();
+
+    bvh_nodes_.clear();
+    leaves_.clear();
+    leaf_order_.clear();
+    registry_to_leaf_.assign(registry.size(), kInvalidBvhIndex);
+    root_ = kInvalidBvhIndex;
+
+    const std::vector<GastNode *> &nodes = registry.get_nodes();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!registry.has_flags(i, kGastNodeFlagCollidable) || !registry.is_visible(i)) {
+            continue;
+        }
+
+        Leaf leaf;
+        leaf.gast_node = nodes[i];
+        leaf.registry_index = static_cast<int>(i);
+        leaf.bvh_node_index = kInvalidBvhIndex;
+        update_leaf(registry, &leaf);
+
+        registry_to_leaf_[i] = static_cast<int>(leaves_.size());
+        leaf_order_.push_back(static_cast<int>(leaves_.size()));
+        leaves_.push_back(leaf);
+    }
+
+    if (leaves_.empty()) {
+        return;
+    }
+
+    bvh_nodes_.reserve(leaves_.size() * 2 - 1);
+    root_ = build_range(0, static_cast<int>(leaf_order_.size()), kInvalidBvhIndex);
+}
+
+int GastNodeBvh::build_range(int begin, int end, int parent) {
+    int node_index = static_cast<int>(bvh_nodes_.size());
+    bvh_nodes_.emplace_back();
+    bvh_nodes_[node_index].parent = parent;
+
+    if (end - begin == 1) {
+        Leaf &leaf = leaves_[leaf_order_[begin]];
+        leaf.bvh_node_index = node_index;
+        bvh_nodes_[node_index].leaf = leaf_order_[begin];
+        bvh_nodes_[node_index].bounds = leaf.bounds;
+        return node_index;
+    }
+
+    // Split the leaves at the median of their centers along the longest axis.
+    Bounds center_bounds;
+    center_bounds.min = center_bounds.max = leaves_[leaf_order_[begin]].bounds.get_center();
+    for (int i = begin + 1; i < end; i++) {
+        center_bounds.expand_to(leaves_[leaf_order_[i]].bounds.get_center());
+    }
+    Vector3 extent = center_bounds.max - center_bounds.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    int middle = begin + (end - begin) / 2;
+    std::nth_element(leaf_order_.begin() + begin, leaf_order_.begin() + middle,
+                     leaf_order_.begin() + end, [this, axis](int lhs, int rhs) {
+                return leaves_[lhs].bounds.get_center()[axis] <
+                       leaves_[rhs].bounds.get_center()[axis];
+            });
+
+    // bvh_nodes_ may be reallocated by the recursive calls, so only access it by index.
+    int left = build_range(begin, middle, node_index);
+    int right = build_range(middle, end, node_index);
+
+    BvhNode &node = bvh_nodes_[node_index];
+    node.left = left;
+    node.right = right;
+    node.bounds = bvh_nodes_[left].bounds;
+    node.bounds.merge_with(bvh_nodes_[right].bounds);
+    return node_index;
+}
+
+void GastNodeBvh::refit(const GastNodeRegistry &registry) {
+    for (size_t i = 0; i < registry_to_leaf_.size(); i++) {
+        int leaf_index = registry_to_leaf_[i];
+        if (leaf_index == kInvalidBvhIndex || !registry.is_bounds_dirty(i)) {
+            continue;
+        }
+
+        Leaf &leaf = leaves_[leaf_index];
+        update_leaf(registry, &leaf);
+        bvh_nodes_[leaf.bvh_node_index].bounds = leaf.bounds;
+
+        // Propagate the change up, until an ancestor's bounds are unaffected.
+        int node_index = bvh_nodes_[leaf.bvh_node_index].parent;
+        while (node_index != kInvalidBvhIndex) {
+            BvhNode &node = bvh_nodes_[node_index];
+            Bounds bounds = bvh_nodes_[node.left].bounds;
+            bounds.merge_with(bvh_nodes_[node.right].bounds);
+            if (bounds == node.bounds) {
+                break;
+            }
+            node.bounds = bounds;
+            node_index = node.parent;
+        }
+    }
+}
+
+void GastNodeBvh::update_leaf(const GastNodeRegistry &registry, Leaf *leaf) {
+    leaf->global_transform = registry.get_global_transforms()[leaf->registry_index];
+    leaf->inverse_transform = leaf->global_transform.affine_inverse();
+    Vector2 size = registry.get_sizes()[leaf->registry_index];
+    leaf->half_size = Vector2(size.x / 2, size.y / 2);
+
+    const Vector2 &half_size = leaf->half_size;
+    const Transform &transform = leaf->global_transform;
+    leaf->bounds.min = leaf->bounds.max = transform.xform(
+            Vector3(-half_size.x, -half_size.y, 0));
+    leaf->bounds.expand_to(transform.xform(Vector3(half_size.x, -half_size.y, 0)));
+    leaf->bounds.expand_to(transform.xform(Vector3(-half_size.x, half_size.y, 0)));
+    leaf->bounds.expand_to(transform.xform(Vector3(half_size.x, half_size.y, 0)));
+
+    Vector3 padding(kBoundsPadding, kBoundsPadding, kBoundsPadding);
+    leaf->bounds.min = leaf->bounds.min - padding;
+    leaf->bounds.max = leaf->bounds.max + padding;
+}
+
+bool GastNodeBvh::pick(const Vector3 &origin, const Vector3 &direction, float max_distance,
+                       GastNodePickResult *result, uint32_t collision_mask) const {
+    if (root_ == kInvalidBvhIndex || !result) {
+        return false;
+    }
+
+    Vector3 inverse_direction;
+    for (int axis = 0; axis < 3; axis++) {
+        inverse_direction[axis] = direction[axis] == 0
+                                  ? std::numeric_limits<float>::infinity()
+                                  : 1.0f / direction[axis];
+    }
+
+    bool hit = false;
+    GastNodePickResult closest;
+    closest.distance = max_distance;
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemScene);
+    stack_.clear();
+    stack_.push_back(root_);
+    while (!stack_.empty()) {
+        const BvhNode &node = bvh_nodes_[stack_.back()];
+        stack_.pop_back();
+
+        if (!intersects_bounds(node.bounds, origin, inverse_direction, closest.distance)) {
+            continue;
+        }
+
+        if (node.leaf != kInvalidBvhIndex) {
+            const Leaf &leaf = leaves_[node.leaf];
+            // The collision layer isn't tracked by the registry, so it's read from the node, and
+            // only for the leaves the ray reaches.
+            if ((leaf.gast_node->get_collision_layer() & collision_mask) == 0) {
+                continue;
+            }
+            if (intersects_leaf(leaf, origin, direction, closest.distance, &closest)) {
+                hit = true;
+            }
+            continue;
+        }
+
+        stack_.push_back(node.left);
+        stack_.push_back(node.right);
+    }
+
+    if (hit) {
+        *result = closest;
+    }
+    return hit;
+}
+
+bool GastNodeBvh::intersects_bounds(const Bounds &bounds, const Vector3 &origin,
+                                    const Vector3 &inverse_direction,
+                                    float max_distance) const {
+    float t_min = 0;
+    float t_max = max_distance;
+    for (int axis = 0; axis < 3; axis++) {
+        float t1 = (bounds.min[axis] - origin[axis]) * inverse_direction[axis];
+        float t2 = (bounds.max[axis] - origin[axis]) * inverse_direction[axis];
+        if (std::isnan(t1) || std::isnan(t2)) {
+            // The ray is parallel to the slab and starts on its boundary.
+            continue;
+        }
+        t_min = std::max(t_min, std::min(t1, t2));
+        t_max = std::min(t_max, std::max(t1, t2));
+        if (t_min > t_max) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GastNodeBvh::intersects_leaf(const Leaf &leaf, const Vector3 &origin,
+                                  const Vector3 &direction, float max_distance,
+                                  GastNodePickResult *result) const {
+    // The quad lies on the z = 0 plane of the node's local space, centered on its origin.
+    Vector3 local_origin = leaf.inverse_transform.xform(origin);
+    Vector3 local_direction = leaf.inverse_transform.basis.xform(direction);
+    if (std::abs(local_direction.z) < kParallelRayEpsilon) {
+        return false;
+    }
+
+    // The transform is affine, so the distance along the ray is the same in both spaces.
+    float distance = -local_origin.z / local_direction.z;
+    if (distance < 0 || distance > max_distance) {
+        return false;
+    }
+
+    Vector3 local_position = local_origin + local_direction * distance;
+    if (std::abs(local_position.x) > leaf.half_size.x ||
+        std::abs(local_position.y) > leaf.half_size.y) {
+        return false;
+    }
+
+    Vector3 normal = leaf.global_transform.basis.xform(Vector3(0, 0, 1)).normalized();
+    if (normal.dot(direction) > 0) {
+        normal = -normal;
+    }
+
+    result->gast_node = leaf.gast_node;
+    result->distance = distance;
+    result->position = origin + direction * distance;
+    result->normal = normal;
+    result->local_position = local_position;
+    return true;
+}
+
+}  // namespace gast
@@ -0,0 +1,127 @@
+#ifndef GAST_NODE_BVH_H
+#define GAST_NODE_BVH_H
+
+#include <core/Transform.hpp>
+#include <core/Vector2.hpp>
+#include <core/Vector3.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "scene/gast_node_registry.h"
+
+namespace gast {
+
+namespace {
+using namespace godot;
+
+constexpr int kInvalidBvhIndex = -1;
+constexpr uint32_t kAllCollisionLayers = UINT32_MAX;
+}  // namespace
+
+class GastNode;
+
+/// Result of a ray pick against the Gast nodes.
+struct GastNodePickResult {
+    GastNode *gast_node = nullptr;
+    // Distance along the ray, in units of the ray direction length.
+    float distance = 0;
+    Vector3 position;
+    Vector3 normal;
+    // Hit position in the node's local space.
+    Vector3 local_position;
+    // Hit coordinates as reported in the input events, see
+    // GastNode::get_relative_collision_point. Only filled by GastManager::pick.
+    Vector2 uv;
+};
+
+/// Bounding volume hierarchy over the visible, collidable Gast nodes quads.
+///
+/// The hierarchy is built from the GastNodeRegistry. It's rebuilt when the registry layout
+/// changes (nodes added / removed, collidable flag or visibility toggled), and refit in place
+/// when only the transforms or sizes of some nodes changed: the dirty leaves bounds are
+/// recomputed, and the change is propagated up to the root.
+///
+/// Picking traverses the hierarchy with a ray / box slab test, and runs an analytic ray /
+/// rectangle intersection against the candidate quads.
+class GastNodeBvh {
+public:
+    /// Bring the hierarchy up to date with the registry, and clear the registry dirty bounds.
+    void update(GastNodeRegistry &registry);
+
+    /// Find the closest quad hit by the ray from `origin` along `direction`, within
+    /// `max_distance` (in units of the direction length).
+    /// As with the physics engine, the quads whose collision layer doesn't match
+    /// `collision_mask` are ignored, and the ray goes through them.
+    /// Returns true on hit, with `result` filled appropriately.
+    bool pick(const Vector3 &origin, const Vector3 &direction, float max_distance,
+              GastNodePickResult *result, uint32_t collision_mask = kAllCollisionLayers) const;
+
+    size_t get_leaf_count() const {
+        return leaves_.size();
+    }
+
+private:
+    struct Bounds {
+        Vector3 min;
+        Vector3 max;
+
+        void expand_to(const Vector3 &point);
+
+        void merge_with(const Bounds &bounds);
+
+        Vector3 get_center() const {
+            return (min + max) * 0.5f;
+        }
+
+        bool operator==(const Bounds &other) const;
+    };
+
+    struct BvhNode {
+        Bounds bounds;
+        // Child nodes indices. Both are kInvalidBvhIndex for a leaf node.
+        int left = kInvalidBvhIndex;
+        int right = kInvalidBvhIndex;
+        int parent = kInvalidBvhIndex;
+        // Index in leaves_ for a leaf node.
+        int leaf = kInvalidBvhIndex;
+    };
+
+    struct Leaf {
+        GastNode *gast_node;
+        int registry_index;
+        int bvh_node_index;
+        Transform global_transform;
+        Transform inverse_transform;
+        Vector2 half_size;
+        Bounds bounds;
+    };
+
+    void rebuild(const GastNodeRegistry &registry);
+
+    void refit(const GastNodeRegistry &registry);
+
+    void update_leaf(const GastNodeRegistry &registry, Leaf *leaf);
+
+    int build_range(int begin, int end, int parent);
+
+    bool intersects_bounds(const Bounds &bounds, const Vector3 &origin,
+                           const Vector3 &inverse_direction, float max_distance) const;
+
+    bool intersects_leaf(const Leaf &leaf, const Vector3 &origin, const Vector3 &direction,
+                         float max_distance, GastNodePickResult *result) const;
+
+    std::vector<BvhNode> bvh_nodes_;
+    std::vector<Leaf> leaves_;
+    // Leaves indices, sorted by the build to group the leaves of each subtree.
+    std::vector<int> leaf_order_;
+    // Maps a registry index to its leaf index, or kInvalidBvhIndex.
+    std::vector<int> registry_to_leaf_;
+    int root_ = kInvalidBvhIndex;
+    uint64_t layout_version_ = UINT64_MAX;
+    // Scratch stack used by the refit and traversal.
+    mutable std::vector<int> stack_;
+};
+
+}  // namespace gast
+
+#endif // GAST_NODE_BVH_H
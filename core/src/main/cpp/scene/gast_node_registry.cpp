@@ -0,0 +1,148 @@
+#include "scene/gast_node_registry.h"
+
+#include <algorithm>
+
+#include "gdn/gast_node.h"
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+void GastNodeRegistry::add(GastNode *gast_node) {
+    if (!gast_node || get_index(*gast_node) != kInvalidRegistryIndex) {
+        return;
+    }
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemScene);
+    gast_node->registry_index = static_cast<int>(nodes_.size());
+    nodes_.push_back(gast_node);
+    global_transforms_.push_back(gast_node->get_global_transform());
+    sizes_.push_back(gast_node->get_size());
+    flags_.push_back(gast_node->get_registry_flags());
+    texture_ids_.push_back(gast_node->get_external_texture_id());
+    visibilities_.push_back(gast_node->is_visible_in_tree());
+    path_hashes_.push_back(String(gast_node->get_path()).hash());
+    dirty_bounds_.push_back(0);
+    mark_bounds_dirty(nodes_.size() - 1);
+    layout_version_++;
+}
+
+bool GastNodeRegistry::contains(const GastNode *gast_node) const {
+    return std::find(nodes_.begin(), nodes_.end(), gast_node) != nodes_.end();
+}
+
+void GastNodeRegistry::remove(GastNode *gast_node) {
+    if (!gast_node) {
+        return;
+    }
+
+    int index = get_index(*gast_node);
+    if (index == kInvalidRegistryIndex) {
+        return;
+    }
+
+    // Swap the last entry into the freed slot.
+    size_t last_index = nodes_.size() - 1;
+    if (static_cast<size_t>(index) != last_index) {
+        nodes_[index] = nodes_[last_index];
+        global_transforms_[index] = global_transforms_[last_index];
+        sizes_[index] = sizes_[last_index];
+        flags_[index] = flags_[last_index];
+        texture_ids_[index] = texture_ids_[last_index];
+        visibilities_[index] = visibilities_[last_index];
+        path_hashes_[index] = path_hashes_[last_index];
+        dirty_bounds_[index] = dirty_bounds_[last_index];
+        nodes_[index]->registry_index = index;
+    }
+
+    nodes_.pop_back();
+    global_transforms_.pop_back();
+    sizes_.pop_back();
+    flags_.pop_back();
+    texture_ids_.pop_back();
+    visibilities_.pop_back();
+    path_hashes_.pop_back();
+    dirty_bounds_.pop_back();
+    gast_node->registry_index = kInvalidRegistryIndex;
+    layout_version_++;
+}
+
+void GastNodeRegistry::clear() {
+    for (GastNode *gast_node : nodes_) {
+        gast_node->registry_index = kInvalidRegistryIndex;
+    }
+
+    nodes_.clear();
+    global_transforms_.clear();
+    sizes_.clear();
+    flags_.clear();
+    texture_ids_.clear();
+    visibilities_.clear();
+    path_hashes_.clear();
+    dirty_bounds_.clear();
+    layout_version_++;
+}
+
+void GastNodeRegistry::update_global_transform(const GastNode &gast_node,
+                                               const Transform &global_transform) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex) {
+        global_transforms_[index] = global_transform;
+        mark_bounds_dirty(index);
+    }
+}
+
+void GastNodeRegistry::update_size(const GastNode &gast_node, Vector2 size) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex) {
+        sizes_[index] = size;
+        mark_bounds_dirty(index);
+    }
+}
+
+void GastNodeRegistry::update_flags(const GastNode &gast_node, uint32_t flags) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex && flags_[index] != flags) {
+        flags_[index] = flags;
+        layout_version_++;
+    }
+}
+
+void GastNodeRegistry::update_texture_id(const GastNode &gast_node, int texture_id) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex) {
+        texture_ids_[index] = texture_id;
+    }
+}
+
+void GastNodeRegistry::update_visibility(const GastNode &gast_node, bool visible) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex && is_visible(index) != visible) {
+        visibilities_[index] = visible;
+        layout_version_++;
+    }
+}
+
+void GastNodeRegistry::update_path_hash(const GastNode &gast_node, uint32_t path_hash) {
+    int index = get_index(gast_node);
+    if (index != kInvalidRegistryIndex) {
+        path_hashes_[index] = path_hash;
+    }
+}
+
+void GastNodeRegistry::clear_dirty_bounds() {
+    if (!has_dirty_bounds_) {
+        return;
+    }
+    std::fill(dirty_bounds_.begin(), dirty_bounds_.end(), 0);
+    has_dirty_bounds_ = false;
+}
+
+int GastNodeRegistry::get_index(const GastNode &gast_node) const {
+    int index = gast_node.registry_index;
+    if (index < 0 || static_cast<size_t>(index) >= nodes_.size() || nodes_[index] != &gast_node) {
+        return kInvalidRegistryIndex;
+    }
+    return index;
+}
+
+}  // namespace gast
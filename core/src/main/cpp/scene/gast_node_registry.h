@@ -0,0 +1,144 @@
+#ifndef GAST_NODE_REGISTRY_H
+#define GAST_NODE_REGISTRY_H
+
+#include <core/Transform.hpp>
+#include <core/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace gast {
+
+namespace {
+using namespace godot;
+
+constexpr int kInvalidRegistryIndex = -1;
+}  // namespace
+
+class GastNode;
+
+/// Flags tracked for each Gast node in the registry.
+enum GastNodeFlags : uint32_t {
+    kGastNodeFlagNone = 0,
+    kGastNodeFlagCollidable = 1 << 0,
+    kGastNodeFlagCurved = 1 << 1,
+    kGastNodeFlagGazeTracking = 1 << 2,
+    kGastNodeFlagRenderOnTop = 1 << 3,
+};
+
+/// Struct-of-arrays registry of the hot state of the Gast nodes in the scene tree.
+///
+/// The Gast nodes push their state updates to the registry, so per-frame passes (hit mapping,
+/// coverage, gaze updates, ...) can iterate over contiguous arrays instead of chasing pointers
+/// through the scene tree.
+/// Removal swaps the last entry into the freed slot, so indices are only stable between
+/// additions / removals.
+class GastNodeRegistry {
+public:
+    /// Add the given node to the registry. No-op if it's already registered.
+    void add(GastNode *gast_node);
+
+    /// Remove the given node from the registry. No-op if it's not registered.
+    void remove(GastNode *gast_node);
+
+    void clear();
+
+    /// Returns true if the given node is registered. The node isn't dereferenced, so it may be a
+    /// node freed since it was read from the registry.
+    bool contains(const GastNode *gast_node) const;
+
+    size_t size() const {
+        return nodes_.size();
+    }
+
+    void update_global_transform(const GastNode &gast_node, const Transform &global_transform);
+
+    void update_size(const GastNode &gast_node, Vector2 size);
+
+    void update_flags(const GastNode &gast_node, uint32_t flags);
+
+    void update_texture_id(const GastNode &gast_node, int texture_id);
+
+    void update_visibility(const GastNode &gast_node, bool visible);
+
+    /// Update the cached hash of the node path (Godot's String::hash), after a rename.
+    void update_path_hash(const GastNode &gast_node, uint32_t path_hash);
+
+    const std::vector<GastNode *> &get_nodes() const {
+        return nodes_;
+    }
+
+    const std::vector<Transform> &get_global_transforms() const {
+        return global_transforms_;
+    }
+
+    const std::vector<Vector2> &get_sizes() const {
+        return sizes_;
+    }
+
+    const std::vector<uint32_t> &get_flags() const {
+        return flags_;
+    }
+
+    const std::vector<int> &get_texture_ids() const {
+        return texture_ids_;
+    }
+
+    const std::vector<uint8_t> &get_visibilities() const {
+        return visibilities_;
+    }
+
+    const std::vector<uint32_t> &get_path_hashes() const {
+        return path_hashes_;
+    }
+
+    bool has_flags(size_t index, uint32_t flags) const {
+        return (flags_[index] & flags) == flags;
+    }
+
+    bool is_visible(size_t index) const {
+        return visibilities_[index] != 0;
+    }
+
+    /// Incremented when nodes are added or removed, or when their flags or visibility change.
+    /// Consumers caching a subset of the nodes (e.g. the collidable ones) rebuild it when the
+    /// version changes.
+    uint64_t get_layout_version() const {
+        return layout_version_;
+    }
+
+    /// Whether the bounds (global transform or size) of any node changed since the last call
+    /// to clear_dirty_bounds().
+    bool has_dirty_bounds() const {
+        return has_dirty_bounds_;
+    }
+
+    bool is_bounds_dirty(size_t index) const {
+        return dirty_bounds_[index] != 0;
+    }
+
+    void clear_dirty_bounds();
+
+    /// Index of the given node in the arrays, or kInvalidRegistryIndex if it's not registered.
+    int get_index(const GastNode &gast_node) const;
+
+private:
+    void mark_bounds_dirty(size_t index) {
+        dirty_bounds_[index] = 1;
+        has_dirty_bounds_ = true;
+    }
+
+    std::vector<GastNode *> nodes_;
+    std::vector<Transform> global_transforms_;
+    std::vector<Vector2> sizes_;
+    std::vector<uint32_t> flags_;
+    std::vector<int> texture_ids_;
+    std::vector<uint8_t> visibilities_;
+    std::vector<uint32_t> path_hashes_;
+    std::vector<uint8_t> dirty_bounds_;
+    bool has_dirty_bounds_ = false;
+    uint64_t layout_version_ = 0;
+};
+
+}  // namespace gast
+
+#endif // GAST_NODE_REGISTRY_H
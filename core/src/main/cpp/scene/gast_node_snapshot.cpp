@@ -0,0 +1,64 @@
+#include "scene/gast_node_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "gdn/gast_node.h"
+
+namespace gast {
+
+namespace {
+template<typename T>
+inline void write_value(uint8_t *destination, T value) {
+    // The entries fields aren't guaranteed to be aligned for T.
+    memcpy(destination, &value, sizeof(T));
+}
+}  // namespace
+
+int write_gast_node_snapshot(const GastNodeRegistry &registry, uint8_t *buffer,
+                             size_t capacity) {
+    if (!buffer || capacity < kGastNodeSnapshotHeaderSize) {
+        return -1;
+    }
+
+    const std::vector<GastNode *> &nodes = registry.get_nodes();
+    const std::vector<Transform> &global_transforms = registry.get_global_transforms();
+    const std::vector<Vector2> &sizes = registry.get_sizes();
+    const std::vector<uint32_t> &flags = registry.get_flags();
+    const std::vector<int> &texture_ids = registry.get_texture_ids();
+    const std::vector<uint32_t> &path_hashes = registry.get_path_hashes();
+
+    size_t entry_count = std::min(nodes.size(), (capacity - kGastNodeSnapshotHeaderSize) /
+                                                kGastNodeSnapshotEntrySize);
+    write_value<int32_t>(buffer, static_cast<int32_t>(entry_count));
+    write_value<int32_t>(buffer + 4, static_cast<int32_t>(nodes.size()));
+
+    uint8_t *entry = buffer + kGastNodeSnapshotHeaderSize;
+    for (size_t i = 0; i < entry_count; i++, entry += kGastNodeSnapshotEntrySize) {
+        write_value<int64_t>(entry + kGastNodeSnapshotHandleOffset,
+                             reinterpret_cast<intptr_t>(nodes[i]));
+        write_value<uint32_t>(entry + kGastNodeSnapshotPathHashOffset, path_hashes[i]);
+        write_value<uint32_t>(entry + kGastNodeSnapshotFlagsOffset, flags[i]);
+        write_value<int32_t>(entry + kGastNodeSnapshotTextureIdOffset, texture_ids[i]);
+        write_value<int32_t>(entry + kGastNodeSnapshotVisibleOffset,
+                             registry.is_visible(i) ? 1 : 0);
+
+        const Transform &transform = global_transforms[i];
+        uint8_t *basis = entry + kGastNodeSnapshotBasisOffset;
+        for (int row = 0; row < 3; row++) {
+            for (int column = 0; column < 3; column++, basis += sizeof(float)) {
+                write_value<float>(basis, transform.basis[row][column]);
+            }
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            write_value<float>(entry + kGastNodeSnapshotOriginOffset + axis * sizeof(float),
+                               transform.origin[axis]);
+        }
+        write_value<float>(entry + kGastNodeSnapshotSizeOffset, sizes[i].x);
+        write_value<float>(entry + kGastNodeSnapshotSizeOffset + sizeof(float), sizes[i].y);
+    }
+
+    return static_cast<int>(nodes.size());
+}
+
+}  // namespace gast
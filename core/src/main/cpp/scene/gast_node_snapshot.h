@@ -0,0 +1,51 @@
+#ifndef GAST_NODE_SNAPSHOT_H
+#define GAST_NODE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "scene/gast_node_registry.h"
+
+namespace gast {
+
+/// Layout of the Gast nodes snapshot, in native byte order.
+/// Mirrors src/main/java/org/godotengine/plugin/gast/GastNodeSnapshot
+///
+/// Header:
+///   [0]  int32: number of entries written
+///   [4]  int32: number of Gast nodes in the scene, which may exceed the entries written if the
+///               buffer is too small
+/// Entries, one per node, starting at kGastNodeSnapshotHeaderSize:
+///   [0]  int64: node handle, as used by the JNI APIs
+///   [8]  int32: hash of the node path (Godot's String::hash, i.e: djb2 over the characters)
+///   [12] int32: GastNodeFlags
+///   [16] int32: external texture id
+///   [20] int32: 1 if visible in the tree, 0 otherwise
+///   [24] float32[9]: global transform basis, row major
+///   [60] float32[3]: global transform origin
+///   [72] float32[2]: size (width, height)
+enum GastNodeSnapshotLayout {
+    kGastNodeSnapshotHeaderSize = 8,
+
+    kGastNodeSnapshotHandleOffset = 0,
+    kGastNodeSnapshotPathHashOffset = 8,
+    kGastNodeSnapshotFlagsOffset = 12,
+    kGastNodeSnapshotTextureIdOffset = 16,
+    kGastNodeSnapshotVisibleOffset = 20,
+    kGastNodeSnapshotBasisOffset = 24,
+    kGastNodeSnapshotOriginOffset = 60,
+    kGastNodeSnapshotSizeOffset = 72,
+    kGastNodeSnapshotEntrySize = 80,
+};
+
+/// Serialize the state of the nodes in the registry into `buffer`, of `capacity` bytes, using
+/// the GastNodeSnapshotLayout. The entries past the buffer capacity are dropped.
+///
+/// The state, including the node path hash, is read from the registry arrays.
+/// @return the number of Gast nodes in the scene, or -1 if the buffer can't hold the header
+int write_gast_node_snapshot(const GastNodeRegistry &registry, uint8_t *buffer,
+                             size_t capacity);
+
+}  // namespace gast
+
+#endif // GAST_NODE_SNAPSHOT_H
@@ -0,0 +1,126 @@
+#ifndef RAY_CAST_COLLISIONS_H
+#define RAY_CAST_COLLISIONS_H
+
+#include <core/String.hpp>
+#include <core/Vector3.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+namespace {
+using namespace godot;
+
+// Number of ray casts usually colliding with a node at once (e.g: one per controller / hand).
+constexpr size_t kExpectedRayCastCollisions = 4;
+}  // namespace
+
+/// Names of the input actions mapped to a ray cast, derived from its path.
+struct RayCastInputActions {
+    String click;
+    String horizontal_left_scroll;
+    String horizontal_right_scroll;
+    String vertical_up_scroll;
+    String vertical_down_scroll;
+};
+
+/// Collision state of a ray cast colliding with a Gast node.
+struct RayCastCollision {
+    int64_t ray_cast_id = 0;
+    // Path of the ray cast, used as pointer id for the input events.
+    String ray_cast_path;
+    // Built with the path when the ray cast starts colliding, rather than on every physics tick.
+    RayCastInputActions input_actions;
+    // Tracks whether a press is in progress. If so, collision is faked via simulation when the
+    // ray cast no longer collides with the node.
+    bool press_in_progress = false;
+    Vector3 collision_point;
+    Vector3 collision_normal;
+};
+
+/// Flat collection of the ray casts colliding with a Gast node, keyed by the ray casts object
+/// instance ids.
+///
+/// The entries are stored inline in a contiguous array sized for the usual number of active
+/// pointers, and looked up with a linear scan of the ids. Steady-state lookups, insertions and
+/// removals don't allocate. Removal swaps the last entry into the freed slot, so pointers to the
+/// entries are only valid until the next insertion / removal.
+class RayCastCollisions {
+public:
+    RayCastCollisions() {
+        entries_.reserve(kExpectedRayCastCollisions);
+    }
+
+    RayCastCollision *find(int64_t ray_cast_id) {
+        for (RayCastCollision &entry : entries_) {
+            if (entry.ray_cast_id == ray_cast_id) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool contains(int64_t ray_cast_id) const {
+        for (const RayCastCollision &entry : entries_) {
+            if (entry.ray_cast_id == ray_cast_id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns the entry for the given ray cast, adding it if needed.
+    RayCastCollision &get_or_add(int64_t ray_cast_id, const String &ray_cast_path,
+                                 const RayCastInputActions &input_actions = RayCastInputActions()) {
+        RayCastCollision *entry = find(ray_cast_id);
+        if (entry) {
+            return *entry;
+        }
+
+        ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemInput);
+        entries_.emplace_back();
+        RayCastCollision &new_entry = entries_.back();
+        new_entry.ray_cast_id = ray_cast_id;
+        new_entry.ray_cast_path = ray_cast_path;
+        new_entry.input_actions = input_actions;
+        return new_entry;
+    }
+
+    void remove(int64_t ray_cast_id) {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (entries_[i].ray_cast_id == ray_cast_id) {
+                if (i != entries_.size() - 1) {
+                    entries_[i] = std::move(entries_.back());
+                }
+                entries_.pop_back();
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        entries_.clear();
+    }
+
+    bool empty() const {
+        return entries_.empty();
+    }
+
+    std::vector<RayCastCollision>::const_iterator begin() const {
+        return entries_.begin();
+    }
+
+    std::vector<RayCastCollision>::const_iterator end() const {
+        return entries_.end();
+    }
+
+private:
+    std::vector<RayCastCollision> entries_;
+};
+
+}  // namespace gast
+
+#endif // RAY_CAST_COLLISIONS_H
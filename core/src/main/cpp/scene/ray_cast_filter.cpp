@@ -0,0 +1,99 @@
+#include "scene/ray_cast_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "memory/allocation_tracker.h"
+
+namespace gast {
+
+namespace {
+// Tolerance on the distances, so grazing rays are never culled.
+constexpr float kCullingMargin = 0.001f;
+}  // namespace
+
+RayCastFilter::Target RayCastFilter::make_target(const Transform &global_transform,
+                                                 Vector2 size, uint32_t collision_layer) {
+    Target target;
+    target.center = global_transform.origin;
+    target.normal = global_transform.basis.xform(Vector3(0, 0, 1)).normalized();
+    target.collision_layer = collision_layer;
+
+    // The quad is centered on the node's origin, so its corners are equidistant from the center
+    // for a non-skewed transform. Take the farthest to be safe.
+    Vector2 half_size(size.x / 2, size.y / 2);
+    float radius = 0;
+    for (int x = -1; x <= 1; x += 2) {
+        for (int y = -1; y <= 1; y += 2) {
+            Vector3 corner = global_transform.basis.xform(
+                    Vector3(x * half_size.x, y * half_size.y, 0));
+            radius = std::max(radius, corner.length());
+        }
+    }
+    target.radius = radius + kCullingMargin;
+    return target;
+}
+
+void RayCastFilter::update(const Array &ray_casts, int64_t physics_frame) {
+    physics_frame_ = physics_frame;
+
+    tested_pairs_per_frame_ = tested_pairs_;
+    culled_pairs_per_frame_ = culled_pairs_;
+    tested_pairs_ = 0;
+    culled_pairs_ = 0;
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemScene);
+    segments_.clear();
+    for (int i = 0; i < ray_casts.size(); i++) {
+        RayCast *ray_cast = Object::cast_to<RayCast>(ray_casts[i]);
+        if (!ray_cast || !ray_cast->is_enabled()) {
+            continue;
+        }
+
+        Transform global_transform = ray_cast->get_global_transform();
+        RayCastSegment segment;
+        segment.ray_cast = ray_cast;
+        segment.from = global_transform.origin;
+        segment.to = global_transform.xform(ray_cast->get_cast_to());
+        segment.collision_mask = ray_cast->get_collision_mask();
+        segments_.push_back(segment);
+    }
+}
+
+bool RayCastFilter::is_candidate(const RayCastSegment &segment, const Target &target) {
+    tested_pairs_++;
+
+    bool candidate = true;
+    if ((segment.collision_mask & target.collision_layer) == 0) {
+        // The physics engine will never report this collision.
+        candidate = false;
+    } else {
+        // Both ends on the same side of the node's plane: the ray stops short of the node or
+        // points away from it.
+        float from_distance = target.normal.dot(segment.from - target.center);
+        float to_distance = target.normal.dot(segment.to - target.center);
+        if ((from_distance > kCullingMargin && to_distance > kCullingMargin) ||
+            (from_distance < -kCullingMargin && to_distance < -kCullingMargin)) {
+            candidate = false;
+        } else {
+            // Closest point of the segment to the bounding sphere center.
+            Vector3 direction = segment.to - segment.from;
+            float length_squared = direction.length_squared();
+            float t = length_squared == 0
+                      ? 0
+                      : direction.dot(target.center - segment.from) / length_squared;
+            t = std::min(std::max(t, 0.0f), 1.0f);
+            Vector3 closest_point = segment.from + direction * t;
+            candidate = closest_point.distance_squared_to(target.center) <=
+                        target.radius * target.radius;
+        }
+    }
+
+    if (!candidate) {
+        culled_pairs_++;
+        total_culled_pairs_++;
+    }
+    return candidate;
+}
+
+}  // namespace gast
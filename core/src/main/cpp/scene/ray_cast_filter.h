@@ -0,0 +1,90 @@
+#ifndef RAY_CAST_FILTER_H
+#define RAY_CAST_FILTER_H
+
+#include <core/Array.hpp>
+#include <core/Transform.hpp>
+#include <core/Vector2.hpp>
+#include <core/Vector3.hpp>
+#include <gen/RayCast.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace gast {
+
+namespace {
+using namespace godot;
+
+// Physics frame of the segments sampled outside of the physics tick.
+constexpr int64_t kUnboundPhysicsFrame = -1;
+}  // namespace
+
+/// World-space segment of an enabled ray cast for the current physics frame.
+struct RayCastSegment {
+    RayCast *ray_cast;
+    Vector3 from;
+    Vector3 to;
+    uint32_t collision_mask;
+};
+
+/// Cheap pre-filter of the (ray cast, Gast node) pairs, run ahead of the per-node input logic.
+///
+/// The ray casts world-space segments are computed once per physics frame. Each node then tests
+/// them against its bounding sphere, the side of its plane each segment end lies on (rays stopping
+/// short of the node or pointing away from it), and its collision layer, and only runs the full
+/// input logic for the remaining candidate pairs.
+class RayCastFilter {
+public:
+    /// Bounding data of a Gast node quad.
+    struct Target {
+        Vector3 center;
+        Vector3 normal;
+        float radius;
+        uint32_t collision_layer;
+    };
+
+    static Target make_target(const Transform &global_transform, Vector2 size,
+                              uint32_t collision_layer);
+
+    /// Refresh the ray cast segments for the given physics frame, from the ray casts in the
+    /// 'gast_ray_caster' group. `physics_frame` is kUnboundPhysicsFrame when the segments are
+    /// sampled once per rendered frame instead.
+    void update(const Array &ray_casts, int64_t physics_frame);
+
+    bool is_up_to_date(int64_t physics_frame) const {
+        return physics_frame_ == physics_frame;
+    }
+
+    const std::vector<RayCastSegment> &get_segments() const {
+        return segments_;
+    }
+
+    /// Returns true if the given ray cast segment may hit the target, false if the pair is culled.
+    bool is_candidate(const RayCastSegment &segment, const Target &target);
+
+    /// Number of pairs tested during the last completed physics frame.
+    int64_t get_tested_pairs_per_frame() const {
+        return tested_pairs_per_frame_;
+    }
+
+    /// Number of pairs culled during the last completed physics frame.
+    int64_t get_culled_pairs_per_frame() const {
+        return culled_pairs_per_frame_;
+    }
+
+    int64_t get_total_culled_pairs() const {
+        return total_culled_pairs_;
+    }
+
+private:
+    std::vector<RayCastSegment> segments_;
+    int64_t physics_frame_ = -1;
+    int64_t tested_pairs_ = 0;
+    int64_t culled_pairs_ = 0;
+    int64_t tested_pairs_per_frame_ = 0;
+    int64_t culled_pairs_per_frame_ = 0;
+    int64_t total_culled_pairs_ = 0;
+};
+
+}  // namespace gast
+
+#endif // RAY_CAST_FILTER_H
@@ -0,0 +1,172 @@
+#include "texture_atlas.h"
+
+#include <core/Vector2.hpp>
+
+#include "gdn/gast_node.h"
+#include "memory/allocation_tracker.h"
+#include "utils.h"
+
+namespace gast {
+
+namespace {
+// A shelf is reused for regions whose height is within this ratio of the shelf's height.
+constexpr float kMaxShelfHeightRatio = 1.5f;
+}  // namespace
+
+TextureAtlas::TextureAtlas(int width, int height) : width_(width), height_(height) {
+    ExternalTexture *external_texture = ExternalTexture::_new();
+    external_texture->set_size(Vector2(width, height));
+    external_texture_ref_ = Ref<ExternalTexture>(external_texture);
+}
+
+TextureAtlas::~TextureAtlas() {
+    release_all_regions();
+}
+
+int TextureAtlas::get_external_texture_id() const {
+    return external_texture_ref_.is_valid() ? external_texture_ref_->get_external_texture_id()
+                                            : kInvalidTexId;
+}
+
+AtlasRegion TextureAtlas::allocate_region(GastNode *gast_node, int width, int height) {
+    if (!gast_node) {
+        return AtlasRegion();
+    }
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemTexture);
+    release_region(gast_node);
+
+    AtlasRegion region = allocate(width, height);
+    if (!region.is_valid()) {
+        ALOGW("Unable to allocate a %dx%d region in the %dx%d texture atlas.", width, height,
+              width_, height_);
+        return region;
+    }
+
+    node_regions_[gast_node] = region;
+    gast_node->bind_to_texture_atlas(external_texture_ref_, get_uv_rect(region));
+    return region;
+}
+
+void TextureAtlas::release_region(GastNode *gast_node) {
+    auto it = node_regions_.find(gast_node);
+    if (it == node_regions_.end()) {
+        return;
+    }
+
+    free(it->second);
+    node_regions_.erase(it);
+    gast_node->unbind_from_texture_atlas();
+}
+
+void TextureAtlas::release_all_regions() {
+    for (auto &node_region : node_regions_) {
+        node_region.first->unbind_from_texture_atlas();
+    }
+    node_regions_.clear();
+    shelves_.clear();
+}
+
+AtlasRegion TextureAtlas::allocate(int width, int height) {
+    AtlasRegion region;
+    if (width <= 0 || height <= 0 || width > width_ || height > height_) {
+        return region;
+    }
+
+    // Look for the existing shelf that fits the region with the least wasted height.
+    Shelf *best_shelf = nullptr;
+    for (auto &shelf : shelves_) {
+        if (shelf.height < height || shelf.height > height * kMaxShelfHeightRatio) {
+            continue;
+        }
+
+        bool has_room = shelf.get_used_width() + width <= width_;
+        for (const auto &slot : shelf.slots) {
+            has_room |= !slot.in_use && slot.width >= width;
+        }
+
+        if (has_room && (!best_shelf || shelf.height < best_shelf->height)) {
+            best_shelf = &shelf;
+        }
+    }
+
+    if (!best_shelf) {
+        // Open a new shelf at the bottom of the atlas.
+        int shelf_y = shelves_.empty() ? 0 : shelves_.back().y + shelves_.back().height;
+        if (shelf_y + height > height_) {
+            return region;
+        }
+        shelves_.push_back(Shelf{shelf_y, height, {}});
+        best_shelf = &shelves_.back();
+    }
+
+    // Reuse a released slot if possible, otherwise append a new one.
+    std::vector<Slot> &slots = best_shelf->slots;
+    int slot_x = -1;
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].in_use || slots[i].width < width) {
+            continue;
+        }
+
+        slot_x = slots[i].x;
+        int remaining_width = slots[i].width - width;
+        slots[i].width = width;
+        slots[i].in_use = true;
+        if (remaining_width > 0) {
+            slots.insert(slots.begin() + i + 1, Slot{slot_x + width, remaining_width, false});
+        }
+        break;
+    }
+
+    if (slot_x < 0) {
+        slot_x = best_shelf->get_used_width();
+        slots.push_back(Slot{slot_x, width, true});
+    }
+
+    region.x = slot_x;
+    region.y = best_shelf->y;
+    region.width = width;
+    region.height = height;
+    return region;
+}
+
+void TextureAtlas::free(const AtlasRegion &region) {
+    for (auto &shelf : shelves_) {
+        if (shelf.y != region.y) {
+            continue;
+        }
+
+        std::vector<Slot> &slots = shelf.slots;
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].x != region.x) {
+                continue;
+            }
+
+            slots[i].in_use = false;
+
+            // Merge with the adjacent free slots.
+            if (i + 1 < slots.size() && !slots[i + 1].in_use) {
+                slots[i].width += slots[i + 1].width;
+                slots.erase(slots.begin() + i + 1);
+            }
+            if (i > 0 && !slots[i - 1].in_use) {
+                slots[i - 1].width += slots[i].width;
+                slots.erase(slots.begin() + i);
+            }
+            break;
+        }
+
+        // Trailing free space goes back to the shelf.
+        if (!slots.empty() && !slots.back().in_use) {
+            slots.pop_back();
+        }
+        break;
+    }
+
+    // Trailing empty shelves go back to the atlas.
+    while (!shelves_.empty() && shelves_.back().slots.empty()) {
+        shelves_.pop_back();
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,107 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <core/Ref.hpp>
+#include <core/Rect2.hpp>
+#include <gen/ExternalTexture.hpp>
+#include <map>
+#include <vector>
+
+namespace gast {
+
+namespace {
+using namespace godot;
+}  // namespace
+
+class GastNode;
+
+/// Region of a texture atlas, in pixels. The origin is the top left corner of the atlas.
+struct AtlasRegion {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool is_valid() const {
+        return width > 0 && height > 0;
+    }
+};
+
+/// External texture shared by several Gast nodes, each sampling its own sub-rect of it.
+///
+/// This allows small panels (buttons, labels, toasts) to be fed by a single SurfaceTexture
+/// (one updateTexImage call per frame) instead of one per panel.
+/// Regions are packed using a shelf allocator.
+class TextureAtlas {
+public:
+    TextureAtlas(int width, int height);
+
+    ~TextureAtlas();
+
+    int get_width() const {
+        return width_;
+    }
+
+    int get_height() const {
+        return height_;
+    }
+
+    int get_external_texture_id() const;
+
+    Ref<ExternalTexture> get_external_texture() const {
+        return external_texture_ref_;
+    }
+
+    /// Allocate a region of the given size and bind the given node to it.
+    /// If the node already has a region in this atlas, it's released first.
+    /// @return The allocated region, invalid if there's no room left in the atlas.
+    AtlasRegion allocate_region(GastNode *gast_node, int width, int height);
+
+    /// Release the region bound to the given node, and unbind the node.
+    void release_region(GastNode *gast_node);
+
+    /// Release all the regions and unbind their nodes.
+    void release_all_regions();
+
+    bool has_region(GastNode *gast_node) const {
+        return node_regions_.count(gast_node) != 0;
+    }
+
+    /// Convert the given region into UV coordinates.
+    Rect2 get_uv_rect(const AtlasRegion &region) const {
+        return Rect2((float) region.x / width_, (float) region.y / height_,
+                     (float) region.width / width_, (float) region.height / height_);
+    }
+
+private:
+    struct Slot {
+        int x;
+        int width;
+        bool in_use;
+    };
+
+    // Horizontal strip of the atlas holding regions of similar heights.
+    struct Shelf {
+        int y;
+        int height;
+        std::vector<Slot> slots;
+
+        int get_used_width() const {
+            return slots.empty() ? 0 : slots.back().x + slots.back().width;
+        }
+    };
+
+    AtlasRegion allocate(int width, int height);
+
+    void free(const AtlasRegion &region);
+
+    const int width_;
+    const int height_;
+    Ref<ExternalTexture> external_texture_ref_;
+    std::vector<Shelf> shelves_;
+    std::map<GastNode *, AtlasRegion> node_regions_;
+};
+
+}  // namespace gast
+
+#endif // TEXTURE_ATLAS_H
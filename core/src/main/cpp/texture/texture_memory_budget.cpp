@@ -0,0 +1,228 @@
+#include "texture_memory_budget.h"
+
+#include <algorithm>
+#include <core/Transform.hpp>
+#include <core/Vector2.hpp>
+
+#include "gdn/gast_node.h"
+#include "memory/allocation_tracker.h"
+#include "utils.h"
+
+namespace gast {
+
+namespace {
+// Number of buffers assumed to back each texture (SurfaceTexture buffer queue).
+constexpr int kEstimatedBuffersPerTexture = 3;
+// Downscaling stops at this dimension; past that, the producer is asked to unbind.
+constexpr int kMinDownscaleDimension = 64;
+// Restricted textures are restored once usage is under this ratio of the budget, which avoids
+// oscillating around the budget.
+constexpr float kRestoreBudgetRatio = 0.75f;
+constexpr int64_t kEvaluationIntervalNanos = 250000000;
+constexpr float kVisibilityWeight = 4.0f;
+constexpr float kScreenSizeWeight = 2.0f;
+constexpr float kRecencyWeight = 1.0f;
+constexpr float kMinCameraDistance = 0.1f;
+}  // namespace
+
+TextureMemoryBudget::TextureMemoryBudget(DecisionCallback decision_callback)
+        : decision_callback_(std::move(decision_callback)) {}
+
+void TextureMemoryBudget::set_budget_bytes(int64_t budget_bytes) {
+    budget_bytes_ = std::max(kUnlimitedTextureMemoryBudget, budget_bytes);
+    dirty_ = true;
+}
+
+void TextureMemoryBudget::record_texture(GastNode *gast_node, int width, int height,
+                                         int bits_per_pixel) {
+    if (!gast_node) {
+        return;
+    }
+
+    ScopedAllocationSubsystem allocation_subsystem(kAllocationSubsystemTexture);
+    auto entry = records_.emplace(gast_node, TextureRecord());
+    TextureRecord &record = entry.first->second;
+    record.width = std::max(0, width);
+    record.height = std::max(0, height);
+    record.bits_per_pixel = std::max(0, bits_per_pixel);
+    if (record.action == kTextureBudgetNone) {
+        record.full_width = record.width;
+        record.full_height = record.height;
+    }
+    dirty_ = true;
+}
+
+void TextureMemoryBudget::remove_texture(GastNode *gast_node) {
+    if (records_.erase(gast_node) != 0) {
+        dirty_ = true;
+    }
+}
+
+void TextureMemoryBudget::mark_used(GastNode *gast_node, int64_t timestamp_nanos) {
+    auto it = records_.find(gast_node);
+    if (it != records_.end()) {
+        it->second.last_used_nanos = timestamp_nanos;
+    }
+}
+
+int64_t TextureMemoryBudget::estimate_bytes(int width, int height, int bits_per_pixel) {
+    return static_cast<int64_t>(width) * height * bits_per_pixel / 8 * kEstimatedBuffersPerTexture;
+}
+
+int64_t TextureMemoryBudget::get_usage_bytes() const {
+    int64_t usage = 0;
+    for (const auto &entry : records_) {
+        const TextureRecord &record = entry.second;
+        usage += estimate_bytes(record.width, record.height, record.bits_per_pixel);
+    }
+    return usage;
+}
+
+std::vector<TextureBudgetDecision> TextureMemoryBudget::get_decisions() const {
+    std::vector<TextureBudgetDecision> decisions;
+    for (const auto &entry : records_) {
+        const TextureRecord &record = entry.second;
+        if (record.action != kTextureBudgetNone) {
+            decisions.push_back({entry.first, record.action, record.width, record.height});
+        }
+    }
+    return decisions;
+}
+
+bool TextureMemoryBudget::should_evaluate(int64_t timestamp_nanos) const {
+    if (records_.empty()) {
+        return false;
+    }
+    return dirty_ || timestamp_nanos - last_evaluation_nanos_ >= kEvaluationIntervalNanos;
+}
+
+float TextureMemoryBudget::compute_rank(GastNode *gast_node, const TextureRecord &record,
+                                        const GastNodeRegistry &registry,
+                                        const Vector3 &camera_position,
+                                        int64_t timestamp_nanos) const {
+    float rank = 0;
+
+    int index = registry.get_index(*gast_node);
+    if (index != kInvalidRegistryIndex && registry.is_visible(index)) {
+        rank += kVisibilityWeight;
+
+        // Approximate the fraction of the view covered by the node by its area over the squared
+        // distance to the camera.
+        const Transform &transform = registry.get_global_transforms()[index];
+        Vector3 scale = transform.basis.get_scale();
+        Vector2 size = registry.get_sizes()[index];
+        float area = size.x * scale.x * size.y * scale.y;
+        float distance = std::max(kMinCameraDistance,
+                                  camera_position.distance_to(transform.origin));
+        rank += kScreenSizeWeight * std::min(1.0f, area / (distance * distance));
+    }
+
+    if (record.last_used_nanos > 0) {
+        float seconds_since_use = (timestamp_nanos - record.last_used_nanos) / 1e9f;
+        rank += kRecencyWeight / (1.0f + std::max(0.0f, seconds_since_use));
+    }
+
+    return rank;
+}
+
+void TextureMemoryBudget::apply_decision(GastNode *gast_node, TextureRecord &record,
+                                         TextureBudgetAction action, int width, int height) {
+    if (record.action == kTextureBudgetNone && action != kTextureBudgetNone) {
+        record.full_width = record.width;
+        record.full_height = record.height;
+    }
+
+    // Assume the producer complies; its next update will correct the record if it doesn't.
+    record.action = action;
+    record.width = width;
+    record.height = height;
+
+    ALOGV("Texture budget decision %d (%dx%d) for %s", action, width, height,
+          get_node_tag(*gast_node).get_data());
+    if (decision_callback_) {
+        decision_callback_({gast_node, action, width, height});
+    }
+}
+
+void TextureMemoryBudget::evaluate(const GastNodeRegistry &registry,
+                                   const Vector3 &camera_position, int64_t timestamp_nanos,
+                                   FrameArena &frame_arena) {
+    dirty_ = false;
+    last_evaluation_nanos_ = timestamp_nanos;
+
+    using RankedRecord = std::pair<GastNode *, TextureRecord *>;
+    FrameVector<RankedRecord> ranked_records{FrameArenaAllocator<RankedRecord>(frame_arena)};
+    ranked_records.reserve(records_.size());
+    for (auto &entry : records_) {
+        entry.second.rank = compute_rank(entry.first, entry.second, registry, camera_position,
+                                         timestamp_nanos);
+        ranked_records.emplace_back(entry.first, &entry.second);
+    }
+
+    // Lowest ranked first.
+    std::sort(ranked_records.begin(), ranked_records.end(),
+              [](const RankedRecord &first, const RankedRecord &second) {
+                  return first.second->rank < second.second->rank;
+              });
+
+    int64_t usage = get_usage_bytes();
+    bool unlimited = budget_bytes_ == kUnlimitedTextureMemoryBudget;
+
+    if (!unlimited && usage > budget_bytes_) {
+        // First pass: downscale the lowest ranked textures.
+        for (auto &entry : ranked_records) {
+            if (usage <= budget_bytes_) {
+                break;
+            }
+
+            TextureRecord &record = *entry.second;
+            int width = record.width / 2;
+            int height = record.height / 2;
+            if (width < kMinDownscaleDimension || height < kMinDownscaleDimension) {
+                continue;
+            }
+
+            usage += estimate_bytes(width, height, record.bits_per_pixel) -
+                     estimate_bytes(record.width, record.height, record.bits_per_pixel);
+            apply_decision(entry.first, record, kTextureBudgetDownscale, width, height);
+        }
+
+        // Second pass: unbind the lowest ranked textures.
+        for (auto &entry : ranked_records) {
+            if (usage <= budget_bytes_) {
+                break;
+            }
+
+            TextureRecord &record = *entry.second;
+            if (record.width == 0 || record.height == 0) {
+                continue;
+            }
+
+            usage -= estimate_bytes(record.width, record.height, record.bits_per_pixel);
+            apply_decision(entry.first, record, kTextureBudgetUnbind, 0, 0);
+        }
+        return;
+    }
+
+    // Restore the restricted textures, highest ranked first, while staying under the budget.
+    int64_t restore_budget = static_cast<int64_t>(budget_bytes_ * kRestoreBudgetRatio);
+    for (auto it = ranked_records.rbegin(); it != ranked_records.rend(); it++) {
+        TextureRecord &record = *it->second;
+        if (record.action == kTextureBudgetNone) {
+            continue;
+        }
+
+        int64_t restored_usage =
+                usage + estimate_bytes(record.full_width, record.full_height, record.bits_per_pixel)
+                - estimate_bytes(record.width, record.height, record.bits_per_pixel);
+        if (!unlimited && restored_usage > restore_budget) {
+            continue;
+        }
+
+        usage = restored_usage;
+        apply_decision(it->first, record, kTextureBudgetNone, record.full_width,
+                       record.full_height);
+    }
+}
+
+}  // namespace gast
@@ -0,0 +1,116 @@
+#ifndef TEXTURE_MEMORY_BUDGET_H
+#define TEXTURE_MEMORY_BUDGET_H
+
+#include <core/Vector3.hpp>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "memory/frame_arena.h"
+#include "scene/gast_node_registry.h"
+
+namespace gast {
+
+namespace {
+using namespace godot;
+
+// Budget value disabling the texture memory budget.
+constexpr int64_t kUnlimitedTextureMemoryBudget = 0;
+}  // namespace
+
+class GastNode;
+
+/// Mirrors src/main/java/org/godotengine/plugin/gast/GastNode#TextureBudgetAction
+enum TextureBudgetAction {
+    kTextureBudgetNone = 0,
+    kTextureBudgetDownscale = 1,
+    kTextureBudgetUnbind = 2,
+};
+
+/// Request sent to the producer of a Gast node texture.
+struct TextureBudgetDecision {
+    GastNode *gast_node;
+    TextureBudgetAction action;
+    // Dimensions the producer should use. Zero when the producer should unbind its surface.
+    int width;
+    int height;
+};
+
+/// Tracks the memory used by the Gast nodes textures, and keeps it under a configurable budget.
+///
+/// When the budget is exceeded, the nodes are ranked by visibility, size on screen and recency of
+/// interaction, and the producers of the lowest ranked nodes are asked to downscale, then to
+/// unbind their surface. Once usage is back well under the budget, the producers are allowed to
+/// restore their full size, highest ranked first.
+class TextureMemoryBudget {
+public:
+    using DecisionCallback = std::function<void(const TextureBudgetDecision &)>;
+
+    explicit TextureMemoryBudget(DecisionCallback decision_callback);
+
+    /// Set the budget in bytes. kUnlimitedTextureMemoryBudget disables the budget.
+    void set_budget_bytes(int64_t budget_bytes);
+
+    int64_t get_budget_bytes() const {
+        return budget_bytes_;
+    }
+
+    /// Record the dimensions and format of the given node's texture. Zero dimensions mean the
+    /// node doesn't have a surface bound.
+    void record_texture(GastNode *gast_node, int width, int height, int bits_per_pixel);
+
+    void remove_texture(GastNode *gast_node);
+
+    /// Record an interaction with the given node.
+    void mark_used(GastNode *gast_node, int64_t timestamp_nanos);
+
+    size_t get_record_count() const {
+        return records_.size();
+    }
+
+    /// Estimated memory used by the recorded textures, in bytes.
+    int64_t get_usage_bytes() const;
+
+    /// Decisions currently in effect, i.e: the nodes asked to downscale or unbind.
+    std::vector<TextureBudgetDecision> get_decisions() const;
+
+    bool should_evaluate(int64_t timestamp_nanos) const;
+
+    /// Rank the recorded textures, and issue the decisions needed to honor the budget.
+    /// The ranking scratch data is allocated from `frame_arena`.
+    void evaluate(const GastNodeRegistry &registry, const Vector3 &camera_position,
+                  int64_t timestamp_nanos, FrameArena &frame_arena);
+
+private:
+    struct TextureRecord {
+        int width = 0;
+        int height = 0;
+        int bits_per_pixel = 0;
+        // Dimensions requested by the producer before any downscaling.
+        int full_width = 0;
+        int full_height = 0;
+        TextureBudgetAction action = kTextureBudgetNone;
+        int64_t last_used_nanos = 0;
+        float rank = 0;
+    };
+
+    static int64_t estimate_bytes(int width, int height, int bits_per_pixel);
+
+    float compute_rank(GastNode *gast_node, const TextureRecord &record,
+                       const GastNodeRegistry &registry, const Vector3 &camera_position,
+                       int64_t timestamp_nanos) const;
+
+    void apply_decision(GastNode *gast_node, TextureRecord &record, TextureBudgetAction action,
+                        int width, int height);
+
+    DecisionCallback decision_callback_;
+    int64_t budget_bytes_ = kUnlimitedTextureMemoryBudget;
+    std::map<GastNode *, TextureRecord> records_;
+    bool dirty_ = false;
+    int64_t last_evaluation_nanos_ = 0;
+};
+
+}  // namespace gast
+
+#endif // TEXTURE_MEMORY_BUDGET_H
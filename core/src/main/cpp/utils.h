@@ -1,20 +1,14 @@
 #ifndef UTILS_H
 #define UTILS_H
 
-#include <android/log.h>
+#include <chrono>
 #include <core/Godot.hpp>
 #include <core/String.hpp>
 #include <core/Variant.hpp>
 #include <gen/Node.hpp>
 #include <gen/Object.hpp>
 
-#define LOG_TAG "GAST"
-
-#define ALOG_ASSERT(_cond, ...) \
-    if (!(_cond)) __android_log_assert("conditional", LOG_TAG, __VA_ARGS__)
-#define ALOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define ALOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
-#define ALOGV(...) __android_log_print(ANDROID_LOG_VERBOSE, LOG_TAG, __VA_ARGS__)
+#include "logging.h"
 
 /** Auxiliary macros */
 #define __JNI_METHOD_BUILD(package, class_name, method) \
@@ -61,11 +55,17 @@ namespace gast {
 
 using namespace godot;
 
-static inline const char *get_node_tag(const String &node_path) {
-    return node_path.utf8().get_data();
+/**
+ * Returns a utf8 representation of the node path for logging purposes.
+ *
+ * The returned buffer owns the data, so get_data() must be invoked within the log statement:
+ * ALOGV("... %s", get_node_tag(node).get_data());
+ */
+static inline CharString get_node_tag(const String &node_path) {
+    return node_path.utf8();
 }
 
-static inline const char *get_node_tag(const Node& node) {
+static inline CharString get_node_tag(const Node& node) {
     return get_node_tag(node.get_path());
 }
 
@@ -100,6 +100,51 @@ static inline jstring string_to_jstring(JNIEnv *env, const String &source) {
     return nullptr;
 }
 
+/**
+ * Owns a JNI local reference, and deletes it when going out of scope.
+ *
+ * The local references created by the callbacks into the JVM are only reclaimed when the frame
+ * returns to Java, so a frame with many input events could otherwise overflow the local
+ * reference table.
+ */
+template<typename T>
+class ScopedLocalRef {
+public:
+    ScopedLocalRef(JNIEnv *env, T local_ref) : env_(env), local_ref_(local_ref) {}
+
+    ~ScopedLocalRef() {
+        if (env_ && local_ref_) {
+            env_->DeleteLocalRef(local_ref_);
+        }
+    }
+
+    ScopedLocalRef(const ScopedLocalRef &) = delete;
+
+    ScopedLocalRef &operator=(const ScopedLocalRef &) = delete;
+
+    T get() const {
+        return local_ref_;
+    }
+
+private:
+    JNIEnv *env_;
+    T local_ref_;
+};
+
+/**
+ * Monotonic timestamp in nanoseconds. Uses the same clock (CLOCK_MONOTONIC) as Android's
+ * SystemClock#uptimeMillis, so the values can be compared on the Kotlin side.
+ */
+#ifdef GAST_HOST_CLOCK
+// Host builds (see src/test/cpp) advance the clock from the tests, to simulate long sessions.
+int64_t get_monotonic_time_nanos();
+#else
+static inline int64_t get_monotonic_time_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
 static inline Node *get_node_from_variant(Variant variant) {
     if (variant.get_type() != Variant::OBJECT) {
         return nullptr;
@@ -0,0 +1,259 @@
+package org.godotengine.plugin.gast
+
+import android.opengl.GLES11Ext
+import android.opengl.GLES20
+import android.opengl.GLES30
+import android.util.Log
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+
+/**
+ * Reads back the content of an external (OES) texture as RGBA8 pixels, top row first.
+ *
+ * The texture is rendered into a temporary framebuffer, then read with glReadPixels.
+ * Must be used on the render thread. The GL state modified by the read back is restored
+ * afterward, since the Godot renderer caches it.
+ */
+internal class ExternalTextureReader {
+
+    companion object {
+        private val TAG = ExternalTextureReader::class.java.simpleName
+
+        private const val VERTEX_SHADER = """
+            attribute vec2 a_position;
+            attribute vec2 a_tex_coord;
+            varying vec2 v_tex_coord;
+            void main() {
+                gl_Position = vec4(a_position, 0.0, 1.0);
+                v_tex_coord = a_tex_coord;
+            }
+        """
+
+        private const val FRAGMENT_SHADER = """
+            #extension GL_OES_EGL_image_external : require
+            precision mediump float;
+            uniform samplerExternalOES u_texture;
+            varying vec2 v_tex_coord;
+            void main() {
+                gl_FragColor = texture2D(u_texture, v_tex_coord);
+            }
+        """
+
+        /**
+         * Quad as a triangle strip (x, y, u, v). The first framebuffer row maps to v = 0, which is
+         * the top row of the streamed content (the same mapping the Gast shader uses), so the
+         * pixels are read top row first.
+         */
+        private val QUAD_VERTICES = floatArrayOf(
+            -1f, -1f, 0f, 0f,
+            1f, -1f, 1f, 0f,
+            -1f, 1f, 0f, 1f,
+            1f, 1f, 1f, 1f
+        )
+        private const val VERTEX_STRIDE = 4 * 4
+
+        private const val GL_TEXTURE_BINDING_EXTERNAL_OES = 0x8D67
+    }
+
+    private val quadVertices: FloatBuffer =
+        ByteBuffer.allocateDirect(QUAD_VERTICES.size * 4)
+            .order(ByteOrder.nativeOrder())
+            .asFloatBuffer()
+            .apply {
+                put(QUAD_VERTICES)
+                position(0)
+            }
+
+    private val intParams = IntArray(4)
+    private val viewport = IntArray(4)
+
+    private var program = 0
+    private var positionHandle = -1
+    private var texCoordHandle = -1
+    private var textureHandle = -1
+    private var isGles3 = false
+
+    /**
+     * Read the content of the given external texture into [out], which must hold at least
+     * width * height * 4 bytes.
+     * @return true on success
+     */
+    fun read(texId: Int, width: Int, height: Int, out: ByteBuffer): Boolean {
+        if (width <= 0 || height <= 0 || out.capacity() < width * height * 4) {
+            return false
+        }
+
+        if (!ensureProgram()) {
+            return false
+        }
+
+        // Save the GL state.
+        val previousFramebuffer = getInteger(GLES20.GL_FRAMEBUFFER_BINDING)
+        val previousProgram = getInteger(GLES20.GL_CURRENT_PROGRAM)
+        val previousArrayBuffer = getInteger(GLES20.GL_ARRAY_BUFFER_BINDING)
+        val previousActiveTexture = getInteger(GLES20.GL_ACTIVE_TEXTURE)
+        val previousVertexArray = if (isGles3) getInteger(GLES30.GL_VERTEX_ARRAY_BINDING) else 0
+        GLES20.glActiveTexture(GLES20.GL_TEXTURE0)
+        val previousTexture2D = getInteger(GLES20.GL_TEXTURE_BINDING_2D)
+        val previousTextureOes = getInteger(GL_TEXTURE_BINDING_EXTERNAL_OES)
+        GLES20.glGetIntegerv(GLES20.GL_VIEWPORT, viewport, 0)
+        val blendEnabled = GLES20.glIsEnabled(GLES20.GL_BLEND)
+        val depthTestEnabled = GLES20.glIsEnabled(GLES20.GL_DEPTH_TEST)
+        val cullFaceEnabled = GLES20.glIsEnabled(GLES20.GL_CULL_FACE)
+        val scissorTestEnabled = GLES20.glIsEnabled(GLES20.GL_SCISSOR_TEST)
+
+        // Setup the target framebuffer.
+        GLES20.glGenTextures(1, intParams, 0)
+        val targetTexture = intParams[0]
+        GLES20.glBindTexture(GLES20.GL_TEXTURE_2D, targetTexture)
+        GLES20.glTexImage2D(
+            GLES20.GL_TEXTURE_2D, 0, GLES20.GL_RGBA, width, height, 0, GLES20.GL_RGBA,
+            GLES20.GL_UNSIGNED_BYTE, null
+        )
+        GLES20.glTexParameteri(
+            GLES20.GL_TEXTURE_2D, GLES20.GL_TEXTURE_MIN_FILTER, GLES20.GL_NEAREST
+        )
+        GLES20.glTexParameteri(
+            GLES20.GL_TEXTURE_2D, GLES20.GL_TEXTURE_MAG_FILTER, GLES20.GL_NEAREST
+        )
+
+        GLES20.glGenFramebuffers(1, intParams, 0)
+        val framebuffer = intParams[0]
+        GLES20.glBindFramebuffer(GLES20.GL_FRAMEBUFFER, framebuffer)
+        GLES20.glFramebufferTexture2D(
+            GLES20.GL_FRAMEBUFFER, GLES20.GL_COLOR_ATTACHMENT0, GLES20.GL_TEXTURE_2D,
+            targetTexture, 0
+        )
+
+        var success = GLES20.glCheckFramebufferStatus(GLES20.GL_FRAMEBUFFER) ==
+                GLES20.GL_FRAMEBUFFER_COMPLETE
+        if (success) {
+            GLES20.glViewport(0, 0, width, height)
+            GLES20.glDisable(GLES20.GL_BLEND)
+            GLES20.glDisable(GLES20.GL_DEPTH_TEST)
+            GLES20.glDisable(GLES20.GL_CULL_FACE)
+            GLES20.glDisable(GLES20.GL_SCISSOR_TEST)
+
+            GLES20.glUseProgram(program)
+            GLES20.glBindTexture(GLES11Ext.GL_TEXTURE_EXTERNAL_OES, texId)
+            GLES20.glUniform1i(textureHandle, 0)
+
+            // Client side vertex arrays require the default vertex array object.
+            if (isGles3) {
+                GLES30.glBindVertexArray(0)
+            }
+            GLES20.glBindBuffer(GLES20.GL_ARRAY_BUFFER, 0)
+            quadVertices.position(0)
+            GLES20.glVertexAttribPointer(
+                positionHandle, 2, GLES20.GL_FLOAT, false, VERTEX_STRIDE, quadVertices
+            )
+            GLES20.glEnableVertexAttribArray(positionHandle)
+            quadVertices.position(2)
+            GLES20.glVertexAttribPointer(
+                texCoordHandle, 2, GLES20.GL_FLOAT, false, VERTEX_STRIDE, quadVertices
+            )
+            GLES20.glEnableVertexAttribArray(texCoordHandle)
+
+            GLES20.glDrawArrays(GLES20.GL_TRIANGLE_STRIP, 0, 4)
+
+            out.position(0)
+            GLES20.glReadPixels(
+                0, 0, width, height, GLES20.GL_RGBA, GLES20.GL_UNSIGNED_BYTE, out
+            )
+            out.position(0)
+
+            GLES20.glDisableVertexAttribArray(positionHandle)
+            GLES20.glDisableVertexAttribArray(texCoordHandle)
+            success = GLES20.glGetError() == GLES20.GL_NO_ERROR
+        } else {
+            Log.w(TAG, "Incomplete read back framebuffer.")
+        }
+
+        // Restore the GL state.
+        GLES20.glBindFramebuffer(GLES20.GL_FRAMEBUFFER, previousFramebuffer)
+        intParams[0] = framebuffer
+        GLES20.glDeleteFramebuffers(1, intParams, 0)
+        intParams[0] = targetTexture
+        GLES20.glDeleteTextures(1, intParams, 0)
+
+        GLES20.glBindTexture(GLES20.GL_TEXTURE_2D, previousTexture2D)
+        GLES20.glBindTexture(GLES11Ext.GL_TEXTURE_EXTERNAL_OES, previousTextureOes)
+        GLES20.glActiveTexture(previousActiveTexture)
+        GLES20.glBindBuffer(GLES20.GL_ARRAY_BUFFER, previousArrayBuffer)
+        if (isGles3) {
+            GLES30.glBindVertexArray(previousVertexArray)
+        }
+        GLES20.glUseProgram(previousProgram)
+        GLES20.glViewport(viewport[0], viewport[1], viewport[2], viewport[3])
+        setEnabled(GLES20.GL_BLEND, blendEnabled)
+        setEnabled(GLES20.GL_DEPTH_TEST, depthTestEnabled)
+        setEnabled(GLES20.GL_CULL_FACE, cullFaceEnabled)
+        setEnabled(GLES20.GL_SCISSOR_TEST, scissorTestEnabled)
+
+        return success
+    }
+
+    private fun getInteger(name: Int): Int {
+        GLES20.glGetIntegerv(name, intParams, 0)
+        return intParams[0]
+    }
+
+    private fun setEnabled(capability: Int, enabled: Boolean) {
+        if (enabled) {
+            GLES20.glEnable(capability)
+        } else {
+            GLES20.glDisable(capability)
+        }
+    }
+
+    private fun ensureProgram(): Boolean {
+        // The program is lost along with the GL context.
+        if (program != 0 && GLES20.glIsProgram(program)) {
+            return true
+        }
+
+        isGles3 = GLES20.glGetString(GLES20.GL_VERSION)?.startsWith("OpenGL ES 3") == true
+
+        val vertexShader = compileShader(GLES20.GL_VERTEX_SHADER, VERTEX_SHADER)
+        val fragmentShader = compileShader(GLES20.GL_FRAGMENT_SHADER, FRAGMENT_SHADER)
+        if (vertexShader == 0 || fragmentShader == 0) {
+            GLES20.glDeleteShader(vertexShader)
+            GLES20.glDeleteShader(fragmentShader)
+            return false
+        }
+
+        program = GLES20.glCreateProgram()
+        GLES20.glAttachShader(program, vertexShader)
+        GLES20.glAttachShader(program, fragmentShader)
+        GLES20.glLinkProgram(program)
+        GLES20.glDeleteShader(vertexShader)
+        GLES20.glDeleteShader(fragmentShader)
+
+        GLES20.glGetProgramiv(program, GLES20.GL_LINK_STATUS, intParams, 0)
+        if (intParams[0] != GLES20.GL_TRUE) {
+            Log.e(TAG, "Unable to link read back program: ${GLES20.glGetProgramInfoLog(program)}")
+            GLES20.glDeleteProgram(program)
+            program = 0
+            return false
+        }
+
+        positionHandle = GLES20.glGetAttribLocation(program, "a_position")
+        texCoordHandle = GLES20.glGetAttribLocation(program, "a_tex_coord")
+        textureHandle = GLES20.glGetUniformLocation(program, "u_texture")
+        return true
+    }
+
+    private fun compileShader(type: Int, source: String): Int {
+        val shader = GLES20.glCreateShader(type)
+        GLES20.glShaderSource(shader, source.trimIndent())
+        GLES20.glCompileShader(shader)
+        GLES20.glGetShaderiv(shader, GLES20.GL_COMPILE_STATUS, intParams, 0)
+        if (intParams[0] != GLES20.GL_TRUE) {
+            Log.e(TAG, "Unable to compile read back shader: ${GLES20.glGetShaderInfoLog(shader)}")
+            GLES20.glDeleteShader(shader)
+            return 0
+        }
+        return shader
+    }
+}
@@ -5,18 +5,23 @@ package org.godotengine.plugin.gast
 import android.app.Activity
 import android.os.Handler
 import android.os.Looper
+import android.text.TextUtils
 import android.util.Log
 import android.widget.FrameLayout
 import org.godotengine.godot.Godot
 import org.godotengine.godot.plugin.GodotPlugin
 import org.godotengine.plugin.gast.input.ActionEventData
 import org.godotengine.plugin.gast.input.GastInputListener
+import org.godotengine.plugin.gast.input.GestureEventData
+import org.godotengine.plugin.gast.input.InputDeliveryPipeline
 import org.godotengine.plugin.gast.input.HoverEventData
 import org.godotengine.plugin.gast.input.InputDispatcher
 import org.godotengine.plugin.gast.input.InputEventData
+import org.godotengine.plugin.gast.input.InputLatencyTracker
 import org.godotengine.plugin.gast.input.PressEventData
 import org.godotengine.plugin.gast.input.ReleaseEventData
 import org.godotengine.plugin.gast.input.ScrollEventData
+import java.nio.ByteBuffer
 import java.util.ArrayDeque
 import java.util.Queue
 import java.util.concurrent.ConcurrentHashMap
@@ -40,6 +45,15 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
     private val gastInputListeners = ConcurrentLinkedQueue<GastInputListener>()
 
     private val gastInputListenersPerActions = ConcurrentHashMap<String, ArrayDeque<GastInputListener>>()
+    private val gastGestureListeners = ConcurrentLinkedQueue<GastInputListener>()
+
+    // Input listeners scoped to a single node, keyed by node pointer.
+    private val inputSubscriptionsPerNode = ConcurrentHashMap<Long, NodeInputSubscription>()
+    // Same subscriptions, keyed by the node path carried by the input events.
+    private val inputSubscriptionsPerNodePath = ConcurrentHashMap<String, NodeInputSubscription>()
+
+    private val gastNodeRequests = ConcurrentHashMap<Long, GastNodeRequest>()
+    private val gastNodes = ConcurrentHashMap<Long, GastNode>()
 
     private val mainThreadHandler = Handler(Looper.getMainLooper())
     private val initialized = AtomicBoolean(false)
@@ -49,16 +63,100 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
      */
     val rootView = FrameLayout(activity!!)
 
+    /**
+     * Schedules the texture updates of the [GastNode] nodes and [GastTextureAtlas] atlases.
+     */
+    val textureUpdateScheduler = GastTextureUpdateScheduler()
+
+    /**
+     * Latencies of the input events delivery on the Kotlin side.
+     */
+    val inputLatencyTracker = InputLatencyTracker()
+
+    private val inputDeliveryPipeline =
+        InputDeliveryPipeline(mainThreadHandler, inputLatencyTracker)
+
+    internal val externalTextureReader = ExternalTextureReader()
+
+    // Receives the (xPercent, yPercent, distance) values of the pick queries.
+    private val pickResultValues = FloatArray(3)
+
     companion object {
         private val TAG = GastManager::class.java.simpleName
     }
 
+    /**
+     * Mirrors src/main/cpp/gast_manager.h#PickingMode
+     */
+    enum class PickingMode(internal val index: Int) {
+        /**
+         * The RayCast nodes are resolved by the physics engine. This is the default.
+         */
+        PHYSICS(0),
+
+        /**
+         * The RayCast nodes are resolved once per rendered frame against a bounding volume
+         * hierarchy of the collidable [GastNode]s, which scales better with the number of nodes.
+         *
+         * The RayCast collision mask is matched against the [GastNode]s collision layer, but
+         * other occluders are ignored: a RayCast going through a non-Gast physics body still
+         * hits the [GastNode]s behind it.
+         */
+        BVH(1)
+    }
+
+    /**
+     * Mirrors src/main/cpp/gast_manager.h#InputSamplingMode
+     */
+    enum class InputSamplingMode(internal val index: Int) {
+        /**
+         * The RayCast nodes are sampled on every physics frame. This is the default.
+         */
+        PHYSICS_TICK(0),
+
+        /**
+         * The RayCast nodes are sampled once per rendered frame, from their latest transforms.
+         * Only applies to [PickingMode.PHYSICS]: [PickingMode.BVH] always samples once per
+         * rendered frame.
+         */
+        RENDER_FRAME(1)
+    }
+
+    /**
+     * Result of a [pick] query.
+     *
+     * @property nodePointer Handle of the hit node
+     * @property gastNode Hit node, or null if it wasn't created from the Android side
+     * @property xPercent Hit x coordinate, as reported in the input events
+     * @property yPercent Hit y coordinate, as reported in the input events
+     * @property distance Distance from the ray origin, in world units
+     */
+    data class PickResult(
+        val nodePointer: Long,
+        val gastNode: GastNode?,
+        val xPercent: Float,
+        val yPercent: Float,
+        val distance: Float
+    )
+
+    private class NodeInputSubscription(var nodePath: String) {
+        val inputListeners = ConcurrentLinkedQueue<GastInputListener>()
+        val gestureListeners = ConcurrentLinkedQueue<GastInputListener>()
+    }
+
+    private class GastNodeRequest(
+        val parentNodePath: String,
+        val callback: (GastNode?) -> Unit
+    )
+
     override fun onGodotMainLoopStarted() {
         Log.d(TAG, "Initializing $pluginName manager")
         initialize()
         initialized.set(true)
 
         updateMonitoredInputActions()
+        updateGestureDetection()
+        updateInputSubscriptions()
     }
 
     override fun onMainCreate(activity: Activity) = rootView
@@ -68,6 +166,7 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         runOnRenderThread {
             initialized.set(false);
             shutdown()
+            inputDeliveryPipeline.shutdown()
         }
     }
 
@@ -76,6 +175,13 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
     }
 
     override fun onGLDrawFrame(gl: GL10) {
+        textureUpdateScheduler.onRenderDrawFrame()
+
+        val timestampNanos = System.nanoTime()
+        for (gastNode in gastNodes.values) {
+            gastNode.onRenderDrawFrame(timestampNanos)
+        }
+
         for (listener in gastRenderListeners) {
             listener.onRenderDrawFrame()
         }
@@ -102,22 +208,22 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
     }
 
     /**
-     * Register a [GastInputListener] instance to be notified of input related events.
+     * Register a [GastInputListener] instance to be notified of input related events, for all
+     * the nodes.
+     *
+     * Prefer registering with [registerGastInputListener] for a given node when possible: as long
+     * as no listener is registered for all the nodes, the input events of the nodes without
+     * listeners are filtered out on the native side.
      */
     fun registerGastInputListener(listener: GastInputListener) {
         if (gastInputListeners.add(listener)) {
-
-            val actionsToMonitor = listener.getInputActionsToMonitor()
-            if (actionsToMonitor.isEmpty()) {
-                return
+            if (listener.getGestureTypesToMonitor().isNotEmpty()) {
+                gastGestureListeners += listener
+                updateGestureDetection()
             }
 
-            for (action in actionsToMonitor) {
-                val actionListeners = gastInputListenersPerActions.getOrPut(action) { ArrayDeque() }
-                actionListeners.add(listener)
-            }
-
-            updateMonitoredInputActions()
+            addMonitoredInputActions(listener)
+            updateInputSubscriptions()
         }
     }
 
@@ -126,22 +232,62 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
      */
     fun unregisterGastInputListener(listener: GastInputListener) {
         if (gastInputListeners.remove(listener)) {
-
-            val monitoredActions = listener.getInputActionsToMonitor()
-            if (monitoredActions.isEmpty()) {
-                return
+            if (gastGestureListeners.remove(listener)) {
+                updateGestureDetection()
             }
 
-            for (action in monitoredActions) {
-                val actionListeners = gastInputListenersPerActions.get(action) ?: continue
-                actionListeners.remove(listener)
-                if (actionListeners.isEmpty()) {
-                    gastInputListenersPerActions.remove(action)
-                }
-            }
+            removeMonitoredInputActions(listener)
+            updateInputSubscriptions()
+        }
+    }
+
+    /**
+     * Register a [GastInputListener] instance to be notified of the input events targeting the
+     * given node only. Input action events are dispatched as for [registerGastInputListener].
+     *
+     * The subscription follows the node across renames and reparenting, and is dropped when the
+     * node is released.
+     */
+    fun registerGastInputListener(listener: GastInputListener, gastNode: GastNode) {
+        var subscription = inputSubscriptionsPerNode[gastNode.nodePointer]
+        if (subscription == null) {
+            subscription = NodeInputSubscription(gastNode.nodePath)
+            inputSubscriptionsPerNode[gastNode.nodePointer] = subscription
+            inputSubscriptionsPerNodePath[subscription.nodePath] = subscription
+        } else if (subscription.inputListeners.contains(listener)) {
+            return
+        }
+
+        subscription.inputListeners += listener
+        if (listener.getGestureTypesToMonitor().isNotEmpty()) {
+            subscription.gestureListeners += listener
+            updateGestureDetection()
+        }
 
-            updateMonitoredInputActions()
+        addMonitoredInputActions(listener)
+        updateInputSubscriptions()
+    }
+
+    /**
+     * Unregister a [GastInputListener] instance previously registered for the given node.
+     */
+    fun unregisterGastInputListener(listener: GastInputListener, gastNode: GastNode) {
+        val subscription = inputSubscriptionsPerNode[gastNode.nodePointer] ?: return
+        if (!subscription.inputListeners.remove(listener)) {
+            return
+        }
+
+        if (subscription.inputListeners.isEmpty()) {
+            inputSubscriptionsPerNode.remove(gastNode.nodePointer)
+            inputSubscriptionsPerNodePath.remove(subscription.nodePath, subscription)
         }
+
+        if (subscription.gestureListeners.remove(listener)) {
+            updateGestureDetection()
+        }
+
+        removeMonitoredInputActions(listener)
+        updateInputSubscriptions()
     }
 
     /**
@@ -153,6 +299,338 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         }
     }
 
+    /**
+     * Create a Gast node with the given parent node and set it up.
+     * @return Pointer to the native node, or [GastNode.INVALID_NODE_POINTER] on failure
+     */
+    internal fun acquireAndBindGastNode(parentNodePath: String, emptyParent: Boolean): Long {
+        if (TextUtils.isEmpty(parentNodePath)) {
+            throw IllegalArgumentException("Invalid parent node path value: $parentNodePath")
+        }
+        return nativeAcquireAndBindGastNode(parentNodePath, emptyParent)
+    }
+
+    /**
+     * Asynchronously create a [GastNode] with the given parent node and set it up.
+     *
+     * The construction steps are spread over frames within the per-frame time budget (see
+     * [setGastNodeRequestBudgetNanos]), avoiding the frame stall caused by the synchronous
+     * [GastNode] constructor when several panels are opened at once.
+     *
+     * Must be invoked on the render thread.
+     * @param parentNodePath - Path to the parent for the Gast node that will be created
+     * @param emptyParent - If true, remove the children of the parent (if any) prior to inserting the Gast node
+     * @param highPriority - If true, the request skips ahead of the queue and completes on the
+     * next frame regardless of the budget
+     * @param callback - Invoked on the render thread with the new node, or null on failure
+     * @return Id of the request, which can be passed to [cancelGastNodeRequest]
+     */
+    @JvmOverloads
+    fun requestGastNode(
+        parentNodePath: String,
+        emptyParent: Boolean = false,
+        highPriority: Boolean = false,
+        callback: (GastNode?) -> Unit
+    ): Long {
+        if (TextUtils.isEmpty(parentNodePath)) {
+            throw IllegalArgumentException("Invalid parent node path value: $parentNodePath")
+        }
+
+        val requestId = nativeRequestGastNode(parentNodePath, emptyParent, highPriority)
+        gastNodeRequests[requestId] = GastNodeRequest(parentNodePath, callback)
+        return requestId
+    }
+
+    /**
+     * Cancel a pending [requestGastNode] request. Its callback won't be invoked.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun cancelGastNodeRequest(requestId: Long) {
+        if (gastNodeRequests.remove(requestId) != null) {
+            nativeCancelGastNodeRequest(requestId)
+        }
+    }
+
+    /**
+     * Update the per-frame time budget for the [requestGastNode] requests.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun setGastNodeRequestBudgetNanos(budgetNanos: Long) {
+        nativeSetGastNodeRequestBudgetNanos(budgetNanos)
+    }
+
+    internal fun runOnMainThread(action: Runnable) {
+        mainThreadHandler.post(action)
+    }
+
+    internal fun recordUpdatedPixels(pixels: Long) {
+        if (initialized.get()) {
+            nativeRecordUpdatedPixels(pixels)
+        }
+    }
+
+    /**
+     * Number of [GastNode] texture pixels updated through their surface canvas during the last
+     * frame. Canvas updates restricted to a dirty region only count that region.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getUpdatedPixelsPerFrame() = nativeGetUpdatedPixelsPerFrame()
+
+    /**
+     * Number of (RayCast, [GastNode]) pairs tested by the ray cast pre-filter during the last
+     * physics frame, in the [PickingMode.PHYSICS] picking mode.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getTestedRayCastPairsPerFrame() = nativeGetTestedRayCastPairsPerFrame()
+
+    /**
+     * Number of (RayCast, [GastNode]) pairs culled by the ray cast pre-filter during the last
+     * physics frame, i.e: skipped by the per-node input logic because the ray can't reach the
+     * node or their collision layer and mask don't overlap.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getCulledRayCastPairsPerFrame() = nativeGetCulledRayCastPairsPerFrame()
+
+    /**
+     * Number of heap allocations made by the native Gast code during the last frame, on any
+     * thread, including the JNI calls such as this one.
+     *
+     * The allocations made by the engine on behalf of the native code (e.g: Godot String and
+     * Array temporaries) go through the engine allocator, and aren't counted. So a count of 0
+     * doesn't mean the frame was allocation free.
+     *
+     * Only tracked when the native library is built with GAST_ALLOCATION_TRACKING (the default
+     * for debug builds), which replaces the global operator new; always 0 otherwise.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getHeapAllocationsPerFrame() = nativeGetHeapAllocationsPerFrame()
+
+    /**
+     * Names of the native Gast resources (nodes, pools, registries...) which have been growing
+     * without ever shrinking for a long period, i.e: likely leaks. A warning is also logged when
+     * a resource starts growing.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getGrowingResources(): Array<String> = nativeGetGrowingResources()
+
+    /**
+     * Latency under which [percentile] (in [0, 100]) of the input events fall for the given
+     * native stage, or 0 if no event was recorded.
+     *
+     * Must be invoked on the render thread.
+     * @see [inputLatencyTracker] for the Kotlin stages
+     */
+    fun getNativeInputLatencyPercentileNanos(
+        stage: InputLatencyTracker.NativeStage,
+        percentile: Float
+    ) = nativeGetInputLatencyPercentileNanos(stage.index, percentile)
+
+    /**
+     * Number of input events recorded for the given native stage.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getNativeInputLatencySampleCount(stage: InputLatencyTracker.NativeStage) =
+        nativeGetInputLatencySampleCount(stage.index)
+
+    /**
+     * Reset the input latency stats, native and Kotlin stages alike.
+     */
+    fun resetInputLatencyStats() {
+        inputLatencyTracker.reset()
+        runOnRenderThread { nativeResetInputLatencyStats() }
+    }
+
+    internal fun registerGastNode(gastNode: GastNode) {
+        gastNodes[gastNode.nodePointer] = gastNode
+    }
+
+    internal fun unregisterGastNode(gastNode: GastNode) {
+        gastNodes.remove(gastNode.nodePointer, gastNode)
+
+        val subscription = inputSubscriptionsPerNode.remove(gastNode.nodePointer) ?: return
+        inputSubscriptionsPerNodePath.remove(subscription.nodePath, subscription)
+        for (listener in subscription.inputListeners) {
+            removeMonitoredInputActions(listener)
+        }
+        if (subscription.gestureListeners.isNotEmpty()) {
+            updateGestureDetection()
+        }
+        updateInputSubscriptions()
+    }
+
+    /**
+     * Invoked when the path of the given node changes, to keep its input subscription up to date.
+     */
+    internal fun onGastNodePathUpdated(gastNode: GastNode) {
+        val subscription = inputSubscriptionsPerNode[gastNode.nodePointer] ?: return
+        inputSubscriptionsPerNodePath.remove(subscription.nodePath, subscription)
+        subscription.nodePath = gastNode.nodePath
+        inputSubscriptionsPerNodePath[subscription.nodePath] = subscription
+    }
+
+    /**
+     * Set the memory budget for the [GastNode] textures, in bytes. 0 disables the budget.
+     *
+     * When the budget is exceeded, the lowest ranked nodes (by visibility, size on screen and
+     * recency of interaction) are asked to downscale, then to unbind their surface, via their
+     * [GastNode.TextureBudgetListener].
+     *
+     * Must be invoked on the render thread.
+     */
+    fun setTextureMemoryBudgetBytes(budgetBytes: Long) {
+        nativeSetTextureMemoryBudgetBytes(budgetBytes)
+    }
+
+    /**
+     * Tune the conversion of the held scroll actions into scroll events. The scroll events are
+     * emitted at most once per frame, with the delta accumulated since the previous frame.
+     *
+     * Must be invoked on the render thread.
+     * @param speed Scroll delta per second for a scroll action held at full strength
+     * @param acceleration Increase of the scroll speed multiplier per second the action is held
+     * @param maxAccelerationMultiplier Cap on the scroll speed multiplier
+     * @param flingFriction Exponential decay rate (per second) of the scroll velocity after the
+     * scroll action is released. 0 disables the fling.
+     */
+    @JvmOverloads
+    fun setScrollSettings(
+        speed: Float = 60f,
+        acceleration: Float = 0.5f,
+        maxAccelerationMultiplier: Float = 3f,
+        flingFriction: Float = 4f
+    ) {
+        nativeSetScrollSettings(speed, acceleration, maxAccelerationMultiplier, flingFriction)
+    }
+
+    /**
+     * Write the state of every [GastNode] in the scene into [snapshotBuffer] in one call, using
+     * the [GastNodeSnapshot] layout. This replaces one getter call per node and property.
+     *
+     * [snapshotBuffer] must be a direct buffer, e.g: from [GastNodeSnapshot.allocateBuffer]. The
+     * entries past its capacity are dropped, in which case the returned count is larger than
+     * the number of entries written and the buffer should be grown.
+     *
+     * Must be invoked on the render thread.
+     * @return the number of [GastNode]s in the scene, or -1 if the buffer is invalid
+     */
+    fun snapshotGastNodes(snapshotBuffer: ByteBuffer): Int {
+        require(snapshotBuffer.isDirect) { "The snapshot buffer must be a direct buffer." }
+        return nativeSnapshotGastNodes(snapshotBuffer)
+    }
+
+    /**
+     * Synchronously find the closest visible, collidable [GastNode] hit by the ray from
+     * ([originX], [originY], [originZ]) along ([directionX], [directionY], [directionZ]), within
+     * [maxDistance] world units.
+     *
+     * The query runs against the nodes' current transforms and sizes, without going through the
+     * physics engine, so it doesn't wait for the next physics frame.
+     *
+     * Must be invoked on the render thread.
+     * @return the hit result, or null if the ray doesn't hit any node
+     */
+    fun pick(
+        originX: Float,
+        originY: Float,
+        originZ: Float,
+        directionX: Float,
+        directionY: Float,
+        directionZ: Float,
+        maxDistance: Float = Float.MAX_VALUE
+    ): PickResult? {
+        val nodePointer = nativePick(
+            originX,
+            originY,
+            originZ,
+            directionX,
+            directionY,
+            directionZ,
+            maxDistance,
+            pickResultValues
+        )
+        if (nodePointer == GastNode.INVALID_NODE_POINTER) {
+            return null
+        }
+
+        return PickResult(
+            nodePointer,
+            gastNodes[nodePointer],
+            pickResultValues[0],
+            pickResultValues[1],
+            pickResultValues[2]
+        )
+    }
+
+    /**
+     * Select how the RayCast nodes in the 'gast_ray_caster' group are resolved against the
+     * [GastNode]s.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun setPickingMode(pickingMode: PickingMode) {
+        nativeSetPickingMode(pickingMode.index)
+    }
+
+    /**
+     * Select how often the RayCast nodes in the 'gast_ray_caster' group are sampled for the
+     * [PickingMode.PHYSICS] picking mode.
+     *
+     * The latency impact can be compared with the
+     * [InputLatencyTracker.NativeStage.PHYSICS_TICK_SAMPLE_AGE] and
+     * [InputLatencyTracker.NativeStage.RENDER_FRAME_SAMPLE_AGE] stages.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun setInputSamplingMode(inputSamplingMode: InputSamplingMode) {
+        nativeSetInputSamplingMode(inputSamplingMode.index)
+    }
+
+    /**
+     * Estimated memory used by the [GastNode] textures, in bytes.
+     *
+     * Must be invoked on the render thread.
+     */
+    fun getTextureMemoryUsageBytes() = nativeGetTextureMemoryUsageBytes()
+
+    private fun addMonitoredInputActions(listener: GastInputListener) {
+        val actionsToMonitor = listener.getInputActionsToMonitor()
+        if (actionsToMonitor.isEmpty()) {
+            return
+        }
+
+        for (action in actionsToMonitor) {
+            val actionListeners = gastInputListenersPerActions.getOrPut(action) { ArrayDeque() }
+            actionListeners.add(listener)
+        }
+
+        updateMonitoredInputActions()
+    }
+
+    private fun removeMonitoredInputActions(listener: GastInputListener) {
+        val monitoredActions = listener.getInputActionsToMonitor()
+        if (monitoredActions.isEmpty()) {
+            return
+        }
+
+        for (action in monitoredActions) {
+            val actionListeners = gastInputListenersPerActions.get(action) ?: continue
+            actionListeners.remove(listener)
+            if (actionListeners.isEmpty()) {
+                gastInputListenersPerActions.remove(action)
+            }
+        }
+
+        updateMonitoredInputActions()
+    }
+
     private fun updateMonitoredInputActions() {
         if (initialized.get()) {
             // Update the list of input actions to monitor for the native code
@@ -160,19 +638,46 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         }
     }
 
+    private fun updateGestureDetection() {
+        if (initialized.get()) {
+            // Only run the native gesture stage when someone is listening.
+            setGestureDetectionEnabled(
+                gastGestureListeners.isNotEmpty() ||
+                        inputSubscriptionsPerNode.values.any { it.gestureListeners.isNotEmpty() }
+            )
+        }
+    }
+
+    private fun updateInputSubscriptions() {
+        if (initialized.get()) {
+            // The native side reads the subscriptions on the render thread, for every input event.
+            runOnRenderThread {
+                if (initialized.get()) {
+                    setInputSubscriptions(
+                        gastInputListeners.isNotEmpty(),
+                        inputSubscriptionsPerNode.keys.toLongArray()
+                    )
+                }
+            }
+        }
+    }
+
     private inline fun dispatchInputEvent(
         listeners: Queue<GastInputListener>?,
+        nodeListeners: Queue<GastInputListener>? = null,
         eventDataProvider : () -> InputEventData
     ) {
-        if (listeners.isNullOrEmpty()) {
+        if (listeners.isNullOrEmpty() && nodeListeners.isNullOrEmpty()) {
             return
         }
 
-        val dispatcher = InputDispatcher.acquireInputDispatcher(
-            listeners,
-            eventDataProvider()
+        val eventData = eventDataProvider()
+        inputLatencyTracker.record(
+            InputLatencyTracker.Stage.RENDER_THREAD,
+            eventData.captureTimeNanos
         )
-        mainThreadHandler.post(dispatcher)
+        val dispatcher = InputDispatcher.acquireInputDispatcher(listeners, nodeListeners, eventData)
+        inputDeliveryPipeline.enqueue(dispatcher)
     }
 
     private external fun initialize()
@@ -183,14 +688,87 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
 
     private external fun setInputActionsToMonitor(inputActions: Array<String>)
 
-    private fun onRenderInputAction(action: String, pressStateIndex: Int, strength: Float) {
+    private external fun setGestureDetectionEnabled(enabled: Boolean)
+
+    private external fun setInputSubscriptions(
+        hasUnscopedListeners: Boolean,
+        subscribedNodePointers: LongArray
+    )
+
+    private external fun nativeAcquireAndBindGastNode(
+        parentNodePath: String,
+        emptyParent: Boolean
+    ): Long
+
+    private external fun nativeRequestGastNode(
+        parentNodePath: String,
+        emptyParent: Boolean,
+        highPriority: Boolean
+    ): Long
+
+    private external fun nativeCancelGastNodeRequest(requestId: Long)
+
+    private external fun nativeSetGastNodeRequestBudgetNanos(budgetNanos: Long)
+
+    private external fun nativeSetTextureMemoryBudgetBytes(budgetBytes: Long)
+
+    private external fun nativeGetTextureMemoryUsageBytes(): Long
+
+    private external fun nativeSetPickingMode(pickingMode: Int)
+
+    private external fun nativeSetInputSamplingMode(inputSamplingMode: Int)
+
+    private external fun nativeRecordUpdatedPixels(pixels: Long)
+
+    private external fun nativeSetScrollSettings(
+        speed: Float,
+        acceleration: Float,
+        maxAccelerationMultiplier: Float,
+        flingFriction: Float
+    )
+
+    private external fun nativeGetUpdatedPixelsPerFrame(): Long
+
+    private external fun nativeGetTestedRayCastPairsPerFrame(): Long
+
+    private external fun nativeGetCulledRayCastPairsPerFrame(): Long
+
+    private external fun nativeGetHeapAllocationsPerFrame(): Long
+
+    private external fun nativeGetGrowingResources(): Array<String>
+
+    private external fun nativeSnapshotGastNodes(snapshotBuffer: ByteBuffer): Int
+
+    private external fun nativePick(
+        originX: Float,
+        originY: Float,
+        originZ: Float,
+        directionX: Float,
+        directionY: Float,
+        directionZ: Float,
+        maxDistance: Float,
+        resultValues: FloatArray
+    ): Long
+
+    private external fun nativeGetInputLatencyPercentileNanos(stage: Int, percentile: Float): Long
+
+    private external fun nativeGetInputLatencySampleCount(stage: Int): Long
+
+    private external fun nativeResetInputLatencyStats()
+
+    private fun onRenderInputAction(
+        action: String,
+        pressStateIndex: Int,
+        strength: Float,
+        captureTimeNanos: Long
+    ) {
         val pressState = GastInputListener.InputPressState.fromIndex(pressStateIndex)
         if (pressState == GastInputListener.InputPressState.INVALID) {
             return
         }
 
         dispatchInputEvent(gastInputListenersPerActions[action]) {
-            ActionEventData(action, pressState, strength)
+            ActionEventData(action, pressState, strength, captureTimeNanos)
         }
     }
 
@@ -198,10 +776,15 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         nodePath: String,
         pointerId: String,
         xPercent: Float,
-        yPercent: Float
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
-        dispatchInputEvent(gastInputListeners) {
-            HoverEventData(nodePath, pointerId, xPercent, yPercent)
+        textureUpdateScheduler.onInputEvent(nodePath, null)
+        dispatchInputEvent(
+            gastInputListeners,
+            inputSubscriptionsPerNodePath[nodePath]?.inputListeners
+        ) {
+            HoverEventData(nodePath, pointerId, xPercent, yPercent, captureTimeNanos)
         }
     }
 
@@ -209,10 +792,15 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         nodePath: String,
         pointerId: String,
         xPercent: Float,
-        yPercent: Float
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
-        dispatchInputEvent(gastInputListeners){
-            PressEventData(nodePath, pointerId, xPercent, yPercent)
+        textureUpdateScheduler.onInputEvent(nodePath, true)
+        dispatchInputEvent(
+            gastInputListeners,
+            inputSubscriptionsPerNodePath[nodePath]?.inputListeners
+        ) {
+            PressEventData(nodePath, pointerId, xPercent, yPercent, captureTimeNanos)
         }
     }
 
@@ -220,10 +808,15 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         nodePath: String,
         pointerId: String,
         xPercent: Float,
-        yPercent: Float
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
-        dispatchInputEvent(gastInputListeners){
-            ReleaseEventData(nodePath, pointerId, xPercent, yPercent)
+        textureUpdateScheduler.onInputEvent(nodePath, false)
+        dispatchInputEvent(
+            gastInputListeners,
+            inputSubscriptionsPerNodePath[nodePath]?.inputListeners
+        ) {
+            ReleaseEventData(nodePath, pointerId, xPercent, yPercent, captureTimeNanos)
         }
     }
 
@@ -233,18 +826,81 @@ class GastManager(godot: Godot) : GodotPlugin(godot) {
         xPercent: Float,
         yPercent: Float,
         horizontalDelta: Float,
-        verticalDelta: Float
+        verticalDelta: Float,
+        captureTimeNanos: Long
     ) {
-        dispatchInputEvent(gastInputListeners) {
+        textureUpdateScheduler.onInputEvent(nodePath, null)
+        dispatchInputEvent(
+            gastInputListeners,
+            inputSubscriptionsPerNodePath[nodePath]?.inputListeners
+        ) {
             ScrollEventData(
                 nodePath,
                 pointerId,
                 xPercent,
                 yPercent,
                 horizontalDelta,
-                verticalDelta
+                verticalDelta,
+                captureTimeNanos
             )
         }
     }
 
+    private fun onRenderInputGesture(
+        nodePath: String,
+        pointerId: String,
+        gestureTypeIndex: Int,
+        xPercent: Float,
+        yPercent: Float,
+        xVelocity: Float,
+        yVelocity: Float,
+        eventTimeNanos: Long
+    ) {
+        val gestureType = GastInputListener.GestureType.fromIndex(gestureTypeIndex)
+        if (gestureType == GastInputListener.GestureType.INVALID) {
+            return
+        }
+
+        dispatchInputEvent(
+            gastGestureListeners,
+            inputSubscriptionsPerNodePath[nodePath]?.gestureListeners
+        ) {
+            GestureEventData(
+                nodePath,
+                pointerId,
+                gestureType,
+                xPercent,
+                yPercent,
+                xVelocity,
+                yVelocity,
+                eventTimeNanos
+            )
+        }
+    }
+
+    private fun onGastNodeReady(requestId: Long, nodePointer: Long) {
+        // Requests issued from GDScript are not tracked on this side.
+        val request = gastNodeRequests.remove(requestId) ?: return
+        if (nodePointer == GastNode.INVALID_NODE_POINTER) {
+            Log.w(TAG, "Unable to create node under ${request.parentNodePath}")
+            request.callback(null)
+        } else {
+            request.callback(GastNode(this, request.parentNodePath, nodePointer))
+        }
+    }
+
+    private fun onTextureBudgetDecision(
+        nodePointer: Long,
+        actionIndex: Int,
+        width: Int,
+        height: Int
+    ) {
+        val gastNode = gastNodes[nodePointer] ?: return
+        val action = GastNode.TextureBudgetAction.fromIndex(actionIndex)
+        mainThreadHandler.post {
+            if (!gastNode.isReleased()) {
+                gastNode.onTextureBudgetDecision(action, width, height)
+            }
+        }
+    }
 }
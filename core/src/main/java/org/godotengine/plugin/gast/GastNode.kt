@@ -2,40 +2,264 @@ package org.godotengine.plugin.gast
 
 import android.graphics.Canvas
 import android.graphics.Color
+import android.graphics.ImageFormat
+import android.graphics.PixelFormat
 import android.graphics.PorterDuff
+import android.graphics.Rect
 import android.graphics.SurfaceTexture
+import android.os.Build
 import android.text.TextUtils
+import android.util.Log
 import android.view.Surface
-import java.util.concurrent.atomic.AtomicInteger
+import androidx.annotation.RequiresApi
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.util.concurrent.TimeUnit
+import kotlin.math.ceil
+import kotlin.math.floor
+import kotlin.math.max
 
 /**
- * @constructor Create a Gast node with the given parent node and set it up.
- * @property gastManager
- * @property parentNodePath - Path to the parent for the Gast node that will be created. The parent node must exist
- * @property emptyParent - If true, remove the children of the parent (if any) prior to inserting the Gast node
+ * Gast node bound to a node in the Godot scene tree.
+ *
+ * The node is either created synchronously via the public constructor, or asynchronously via
+ * [GastManager.requestGastNode].
  */
-class GastNode @JvmOverloads constructor(
+class GastNode internal constructor(
     private val gastManager: GastManager,
     private var parentNodePath: String,
-    emptyParent: Boolean = false
-) : SurfaceTexture.OnFrameAvailableListener, GastRenderListener {
+    nodePointer: Long
+) {
 
-    private val updateTextureImageCounter = AtomicInteger()
+    /**
+     * @constructor Create a Gast node with the given parent node and set it up.
+     * @property gastManager
+     * @property parentNodePath - Path to the parent for the Gast node that will be created. The parent node must exist
+     * @property emptyParent - If true, remove the children of the parent (if any) prior to inserting the Gast node
+     */
+    @JvmOverloads
+    constructor(
+        gastManager: GastManager,
+        parentNodePath: String,
+        emptyParent: Boolean = false
+    ) : this(
+        gastManager,
+        parentNodePath,
+        gastManager.acquireAndBindGastNode(parentNodePath, emptyParent)
+    )
+
+    private val textureUpdateEntry = GastTextureUpdateScheduler.Entry()
 
     private var surfaceTexture: SurfaceTexture? = null
     private var surface: Surface? = null
     private var surfaceCanvas: Canvas? = null
     private var surfaceCanvasRefCount = 0
-
-    private var nodePointer: Long
+    private var surfaceWidth = 0
+    private var surfaceHeight = 0
+    private var surfaceBitsPerPixel = 0
+    private var surfacePixelFormat = PixelFormat.RGBA_8888
+    @Volatile
+    private var surfaceBindNanos = 0L
+
+    internal var nodePointer: Long = nodePointer
+        private set
     val nodePath get() = nativeGetNodePath(nodePointer)
 
-    init {
-        if (TextUtils.isEmpty(parentNodePath)) {
-            throw IllegalArgumentException("Invalid parent node path value: $parentNodePath")
+    /**
+     * Texture atlas this node samples from, if any.
+     * @see [GastTextureAtlas.allocateRegion]
+     */
+    var textureAtlas: GastTextureAtlas? = null
+        internal set
+
+    /**
+     * Node whose texture this node displays, if any.
+     * @see [bindToSharedTexture]
+     */
+    var sharedTextureSource: GastNode? = null
+        get() = field?.takeUnless { it.isReleased() }
+        private set
+
+    /**
+     * Action requested by the texture memory budget.
+     * @see [GastManager.setTextureMemoryBudgetBytes]
+     */
+    enum class TextureBudgetAction(internal val index: Int) {
+        /**
+         * The producer can use its full resolution.
+         */
+        NONE(0),
+
+        /**
+         * The producer should downscale its content to the requested dimensions.
+         */
+        DOWNSCALE(1),
+
+        /**
+         * The producer should unbind its surface.
+         */
+        UNBIND(2);
+
+        internal companion object {
+            fun fromIndex(index: Int): TextureBudgetAction {
+                for (action in values()) {
+                    if (action.index == index) {
+                        return action
+                    }
+                }
+                return NONE
+            }
         }
+    }
+
+    /**
+     * Implemented by the producer of the node's content to honor the texture memory budget.
+     */
+    interface TextureBudgetListener {
+        /**
+         * Invoked on the main thread when the texture memory budget requests an action from the
+         * producer.
+         * @param width - Requested texture width, 0 for [TextureBudgetAction.UNBIND]
+         * @param height - Requested texture height, 0 for [TextureBudgetAction.UNBIND]
+         */
+        fun onTextureBudgetDecision(
+            gastNode: GastNode,
+            action: TextureBudgetAction,
+            width: Int,
+            height: Int
+        )
+    }
+
+    /**
+     * Producer notified of the texture memory budget decisions for this node.
+     */
+    var textureBudgetListener: TextureBudgetListener? = null
+
+    /**
+     * Last action requested by the texture memory budget for this node.
+     */
+    @Volatile
+    var textureBudgetAction = TextureBudgetAction.NONE
+        private set
+
+    /**
+     * Scale applied to the [Canvas] returned by [lockSurfaceCanvas]. This allows canvas based
+     * producers to downscale their content along with the surface texture size.
+     */
+    var surfaceCanvasScale = 1f
+
+    /**
+     * Number of pixels updated by the last canvas post, i.e: the area of the dirty region passed
+     * to [lockSurfaceCanvas] as adjusted by the [Surface], or the full surface area.
+     */
+    @Volatile
+    var lastCanvasUpdatedPixels = 0L
+        private set
+
+    private val surfaceCanvasDirtyRect = Rect()
+    private var surfaceCanvasUpdatedPixels = 0L
+
+    /**
+     * Opt-in to a hardware accelerated [Canvas] ([Surface.lockHardwareCanvas], API 23+) in
+     * [lockSurfaceCanvas], so the content is rasterized by the GPU instead of the CPU.
+     *
+     * The software canvas is used as fallback when unavailable. The hardware canvas doesn't
+     * support dirty regions, so the whole surface is redrawn on each update.
+     * The mode is selected when the canvas is first locked after [bindSurface], and kept until
+     * the surface is unbound, since a surface can't switch between the two canvas types.
+     */
+    var hardwareCanvasEnabled = false
+
+    /**
+     * True if the bound surface is drawn with a hardware accelerated canvas.
+     */
+    var isHardwareCanvasActive = false
+        private set
+
+    private var surfaceCanvasModeSelected = false
+    private var surfaceCanvasLockNanos = 0L
+    private val canvasDrawStats = arrayOf(CanvasDrawStats(), CanvasDrawStats())
 
-        nodePointer = acquireAndBindGastNode(parentNodePath, emptyParent)
+    /**
+     * Snapshot of the canvas draw time metrics for a canvas type, since the last
+     * [resetCanvasDrawMetrics] call.
+     *
+     * @property drawnFrames Number of frames drawn and posted through [lockSurfaceCanvas] and
+     * [unlockSurfaceCanvas].
+     * @property averageDrawNanos Average time between locking the canvas and posting its content.
+     * @property maxDrawNanos Max time between locking the canvas and posting its content.
+     */
+    data class CanvasDrawMetrics(
+        val drawnFrames: Long,
+        val averageDrawNanos: Long,
+        val maxDrawNanos: Long
+    )
+
+    private class CanvasDrawStats {
+        var drawnFrames = 0L
+        var totalDrawNanos = 0L
+        var maxDrawNanos = 0L
+    }
+
+    /**
+     * Implemented by the producer of the node's content to support hibernation.
+     * @see [hibernationTimeoutMillis]
+     */
+    interface HibernationListener {
+        /**
+         * Invoked on the main thread before the node's [Surface] is released. The producer should
+         * pause and stop drawing into the surface.
+         */
+        fun onHibernate(gastNode: GastNode)
+
+        /**
+         * Invoked on the main thread after a new [Surface] is bound to the node. The producer
+         * should resume and redraw its content.
+         */
+        fun onRehydrate(gastNode: GastNode)
+    }
+
+    /**
+     * Producer notified when the node hibernates and rehydrates. Hibernation is disabled when
+     * this is null.
+     */
+    var hibernationListener: HibernationListener? = null
+
+    /**
+     * Duration after which an idle node (no new frame and no interaction) hibernates: its last
+     * frame is captured into a static texture, and its streaming surface is released.
+     * The node rehydrates on the next interaction, or when [rehydrate] is invoked (e.g: on content
+     * update). 0 disables hibernation.
+     */
+    @Volatile
+    var hibernationTimeoutMillis = 0L
+
+    /**
+     * True while the node displays a static snapshot instead of its streamed content.
+     */
+    @Volatile
+    var isHibernating = false
+        private set
+
+    /**
+     * Time between the last rehydration request and the display of the first new frame.
+     */
+    @Volatile
+    var lastRehydrationLatencyNanos = 0L
+        private set
+
+    @Volatile
+    private var hibernationPending = false
+    @Volatile
+    private var rehydrationPending = false
+    @Volatile
+    private var awaitingFirstFrame = false
+    private var hibernationStartNanos = 0L
+    private var rehydrationStartNanos = 0L
+    private var hibernatedWidth = 0
+    private var hibernatedHeight = 0
+
+    init {
         if (nodePointer == INVALID_NODE_POINTER) {
             throw IllegalStateException("Unable to initialize node")
         }
@@ -45,14 +269,20 @@ class GastNode @JvmOverloads constructor(
             throw IllegalStateException("Unable to initialize node texture.")
         }
 
-        gastManager.registerGastRenderListener(this)
+        textureUpdateEntry.onFrameLatched = this::onFrameLatched
+        gastManager.textureUpdateScheduler.register(textureUpdateEntry, nodePath)
+        gastManager.registerGastNode(this)
     }
 
     companion object {
         private val TAG = GastNode::class.java.simpleName
         private const val INVALID_SURFACE_INDEX = -1
         private const val INVALID_TEX_ID = 0
-        private const val INVALID_NODE_POINTER = 0L;
+        internal const val INVALID_NODE_POINTER = 0L;
+        // PixelFormat.RGBA_F16, only available from API 26.
+        private const val PIXEL_FORMAT_RGBA_F16 = 0x16
+        // Rehydration is expected to complete within a couple of frames.
+        private val MAX_EXPECTED_REHYDRATION_LATENCY_NANOS = TimeUnit.MILLISECONDS.toNanos(33)
         private const val RELEASED_PATH = ""
     }
 
@@ -66,9 +296,12 @@ class GastNode @JvmOverloads constructor(
             return
         }
 
-        gastManager.unregisterGastRenderListener(this)
+        gastManager.textureUpdateScheduler.unregister(textureUpdateEntry)
+        gastManager.unregisterGastNode(this)
 
+        textureAtlas?.releaseRegion(this)
         unbindSurface()
+        sharedTextureSource = null
         unbindAndReleaseGastNode(nodePointer)
         nodePointer = INVALID_NODE_POINTER
     }
@@ -77,8 +310,19 @@ class GastNode @JvmOverloads constructor(
      * Initialize and bind a [Surface] to this [GastNode] node.
      *
      * If the [Surface] is already bound, this method just returns it.
+     * @param pixelFormat - Format of the content produced into the surface, used to estimate its
+     * memory usage. Either a [PixelFormat] or an [ImageFormat] value.
+     * @throws IllegalStateException if this [GastNode] node is bound to a [GastTextureAtlas].
      */
-    fun bindSurface(): Surface {
+    @JvmOverloads
+    fun bindSurface(pixelFormat: Int = PixelFormat.RGBA_8888): Surface {
+        if (textureAtlas != null) {
+            throw IllegalStateException("Node is bound to a texture atlas.")
+        }
+        if (sharedTextureSource != null) {
+            throw IllegalStateException("Node is bound to a shared texture.")
+        }
+
         if (surfaceTexture == null) {
             val texId = getTextureId()
             if (texId == INVALID_TEX_ID) {
@@ -86,13 +330,18 @@ class GastNode @JvmOverloads constructor(
             }
 
             surfaceTexture = SurfaceTexture(texId)
-            surfaceTexture?.setOnFrameAvailableListener(this)
+            surfaceTexture?.setOnFrameAvailableListener(textureUpdateEntry)
+            textureUpdateEntry.surfaceTexture = surfaceTexture
         }
 
         if (surface == null) {
             surface = Surface(surfaceTexture)
         }
 
+        surfacePixelFormat = pixelFormat
+        surfaceBitsPerPixel = getBitsPerPixel(pixelFormat)
+        surfaceBindNanos = System.nanoTime()
+        recordTextureMemory()
         return surface!!
     }
 
@@ -105,9 +354,16 @@ class GastNode @JvmOverloads constructor(
             surface = null
         }
 
+        surfaceCanvasModeSelected = false
+        isHardwareCanvasActive = false
+
         if (surfaceTexture != null) {
+            textureUpdateEntry.surfaceTexture = null
             surfaceTexture?.release()
             surfaceTexture = null
+            surfaceWidth = 0
+            surfaceHeight = 0
+            recordTextureMemory()
         }
     }
 
@@ -128,18 +384,172 @@ class GastNode @JvmOverloads constructor(
     fun setSurfaceTextureSize(width: Int, height: Int) {
         surfaceTexture?.setDefaultBufferSize(width, height)
             ?: throw IllegalStateException("No Surface object bound to this node.")
+        surfaceWidth = width
+        surfaceHeight = height
+        recordTextureMemory()
+    }
+
+    /**
+     * Wake up the node if it's hibernating. The producer is notified via
+     * [HibernationListener.onRehydrate], and the static snapshot is displayed until the first new
+     * frame is available.
+     */
+    fun rehydrate() {
+        if (!isHibernating || rehydrationPending) {
+            return
+        }
+
+        rehydrationPending = true
+        rehydrationStartNanos = System.nanoTime()
+        gastManager.runOnMainThread {
+            rehydrationPending = false
+            if (!isHibernating || isReleased()) {
+                return@runOnMainThread
+            }
+
+            bindSurface(surfacePixelFormat)
+            setSurfaceTextureSize(hibernatedWidth, hibernatedHeight)
+            awaitingFirstFrame = true
+            isHibernating = false
+            hibernationListener?.onRehydrate(this)
+        }
+    }
+
+    /**
+     * Check for inactivity, and rehydrate on interaction.
+     *
+     * This is invoked on the render thread.
+     */
+    internal fun onRenderDrawFrame(timestampNanos: Long) {
+        if (isHibernating) {
+            if (textureUpdateEntry.lastInteractionNanos > hibernationStartNanos) {
+                rehydrate()
+            }
+            return
+        }
+
+        val timeoutNanos = TimeUnit.MILLISECONDS.toNanos(hibernationTimeoutMillis)
+        if (timeoutNanos <= 0 || hibernationPending || awaitingFirstFrame ||
+            hibernationListener == null || textureAtlas != null || surfaceTexture == null ||
+            surfaceWidth <= 0 || surfaceHeight <= 0 ||
+            textureUpdateEntry.pendingFrames.get() > 0
+        ) {
+            return
+        }
+
+        val lastActivityNanos = maxOf(
+            surfaceBindNanos,
+            textureUpdateEntry.lastLatchNanos,
+            textureUpdateEntry.lastInteractionNanos
+        )
+        if (timestampNanos - lastActivityNanos >= timeoutNanos) {
+            hibernate(timestampNanos)
+        }
+    }
+
+    private fun hibernate(timestampNanos: Long) {
+        val width = surfaceWidth
+        val height = surfaceHeight
+        val snapshot = ByteBuffer.allocateDirect(width * height * 4).order(ByteOrder.nativeOrder())
+        if (!gastManager.externalTextureReader.read(getTextureId(), width, height, snapshot) ||
+            !nativeSetStaticSnapshot(nodePointer, snapshot, width, height)
+        ) {
+            Log.w(TAG, "Unable to capture the snapshot for $nodePath")
+            // Restart the inactivity timer.
+            surfaceBindNanos = timestampNanos
+            return
+        }
+
+        hibernationPending = true
+        hibernationStartNanos = timestampNanos
+        hibernatedWidth = width
+        hibernatedHeight = height
+        gastManager.runOnMainThread {
+            hibernationPending = false
+            if (isReleased()) {
+                return@runOnMainThread
+            }
+
+            hibernationListener?.onHibernate(this)
+            unbindSurface()
+            isHibernating = true
+        }
+    }
+
+    private fun onFrameLatched() {
+        if (!awaitingFirstFrame) {
+            return
+        }
+
+        awaitingFirstFrame = false
+        nativeClearStaticSnapshot(nodePointer)
+
+        lastRehydrationLatencyNanos = System.nanoTime() - rehydrationStartNanos
+        if (lastRehydrationLatencyNanos > MAX_EXPECTED_REHYDRATION_LATENCY_NANOS) {
+            Log.w(
+                TAG,
+                "Rehydration took ${TimeUnit.NANOSECONDS.toMillis(lastRehydrationLatencyNanos)} ms"
+            )
+        }
+    }
+
+    private external fun nativeSetStaticSnapshot(
+        nodePointer: Long,
+        rgbaBuffer: ByteBuffer,
+        width: Int,
+        height: Int
+    ): Boolean
+
+    private external fun nativeClearStaticSnapshot(nodePointer: Long)
+
+    private fun recordTextureMemory() {
+        val width = surfaceWidth
+        val height = surfaceHeight
+        val bitsPerPixel = surfaceBitsPerPixel
+        gastManager.runOnRenderThread {
+            if (!isReleased()) {
+                nativeRecordTextureMemory(nodePointer, width, height, bitsPerPixel)
+            }
+        }
+    }
+
+    private fun getBitsPerPixel(pixelFormat: Int): Int {
+        return when (pixelFormat) {
+            PixelFormat.RGB_565 -> 16
+            PixelFormat.RGB_888 -> 24
+            ImageFormat.YUV_420_888, ImageFormat.NV21, ImageFormat.YV12 -> 12
+            PIXEL_FORMAT_RGBA_F16 -> 64
+            else -> 32
+        }
+    }
+
+    internal fun onTextureBudgetDecision(action: TextureBudgetAction, width: Int, height: Int) {
+        textureBudgetAction = action
+        textureBudgetListener?.onTextureBudgetDecision(this, action, width, height)
     }
 
+    private external fun nativeRecordTextureMemory(
+        nodePointer: Long,
+        width: Int,
+        height: Int,
+        bitsPerPixel: Int
+    )
+
     /**
      * Gets a [Canvas] for drawing into the [Surface] bound to this node.
      *
      * After drawing into the provided [Canvas], the caller must invoke [unlockSurfaceCanvas] to
      * post the new contents.
      *
+     * When [dirtyRect] is provided (in canvas coordinates, prior to [surfaceCanvasScale]), only
+     * that region is cleared and updated; the rest of the surface keeps its previous content. It's
+     * ignored if the canvas is already locked.
+     *
      * [bindSurface] must have been invoked at least once prior to invoking this method.
      * @throws IllegalStateException if a [Surface] is not bound to this [GastNode] node.
      */
-    fun lockSurfaceCanvas(): Canvas? {
+    @JvmOverloads
+    fun lockSurfaceCanvas(dirtyRect: Rect? = null): Canvas? {
         val boundSurface =
             surface ?: throw IllegalStateException("No Surface object bound to this node.")
 
@@ -152,8 +562,43 @@ class GastNode @JvmOverloads constructor(
                 throw IllegalStateException("Invalid surface canvas state.")
             }
 
-            surfaceCanvas = boundSurface.lockCanvas(null)
-            surfaceCanvas?.drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR)
+            if (!surfaceCanvasModeSelected) {
+                surfaceCanvasModeSelected = true
+                isHardwareCanvasActive =
+                    hardwareCanvasEnabled && Build.VERSION.SDK_INT >= Build.VERSION_CODES.M
+            }
+
+            surfaceCanvasLockNanos = System.nanoTime()
+            surfaceCanvas = if (isHardwareCanvasActive &&
+                Build.VERSION.SDK_INT >= Build.VERSION_CODES.M
+            ) {
+                lockHardwareCanvas(boundSurface)
+            } else if (dirtyRect == null) {
+                boundSurface.lockCanvas(null)
+            } else {
+                // The surface may grow the dirty region, e.g: when it can't preserve the
+                // previous content.
+                surfaceCanvasDirtyRect.set(
+                    floor(dirtyRect.left * surfaceCanvasScale).toInt(),
+                    floor(dirtyRect.top * surfaceCanvasScale).toInt(),
+                    ceil(dirtyRect.right * surfaceCanvasScale).toInt(),
+                    ceil(dirtyRect.bottom * surfaceCanvasScale).toInt()
+                )
+                boundSurface.lockCanvas(surfaceCanvasDirtyRect)
+            }
+
+            val canvas = surfaceCanvas ?: return null
+            surfaceCanvasUpdatedPixels = if (dirtyRect == null || isHardwareCanvasActive) {
+                canvas.width.toLong() * canvas.height
+            } else {
+                surfaceCanvasDirtyRect.width().toLong() * surfaceCanvasDirtyRect.height()
+            }
+
+            // The canvas is clipped to the dirty region, so only that region is cleared.
+            canvas.drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR)
+            if (surfaceCanvasScale != 1f) {
+                canvas.scale(surfaceCanvasScale, surfaceCanvasScale)
+            }
         }
         surfaceCanvasRefCount++
         return surfaceCanvas
@@ -177,13 +622,57 @@ class GastNode @JvmOverloads constructor(
         if (surfaceCanvasRefCount == 0) {
             boundSurface.unlockCanvasAndPost(surfaceCanvas)
             surfaceCanvas = null
+            lastCanvasUpdatedPixels = surfaceCanvasUpdatedPixels
+            gastManager.recordUpdatedPixels(surfaceCanvasUpdatedPixels)
+            recordCanvasDrawTime(System.nanoTime() - surfaceCanvasLockNanos)
         }
     }
 
-    private external fun acquireAndBindGastNode(
-        parentNodePath: String,
-        emptyParent: Boolean
-    ): Long
+    @RequiresApi(Build.VERSION_CODES.M)
+    private fun lockHardwareCanvas(boundSurface: Surface): Canvas? {
+        return try {
+            boundSurface.lockHardwareCanvas()
+        } catch (e: RuntimeException) {
+            // Only possible on the first lock, before the surface is used by either canvas type.
+            Log.w(TAG, "Unable to lock a hardware canvas, falling back to software.", e)
+            isHardwareCanvasActive = false
+            boundSurface.lockCanvas(null)
+        }
+    }
+
+    @Synchronized
+    private fun recordCanvasDrawTime(drawNanos: Long) {
+        val stats = canvasDrawStats[if (isHardwareCanvasActive) 1 else 0]
+        stats.drawnFrames++
+        stats.totalDrawNanos += drawNanos
+        stats.maxDrawNanos = max(stats.maxDrawNanos, drawNanos)
+    }
+
+    /**
+     * Canvas draw time metrics for the hardware accelerated canvas if [hardware] is true, for
+     * the software canvas otherwise.
+     * @see [hardwareCanvasEnabled]
+     */
+    @Synchronized
+    fun getCanvasDrawMetrics(hardware: Boolean): CanvasDrawMetrics {
+        val stats = canvasDrawStats[if (hardware) 1 else 0]
+        return CanvasDrawMetrics(
+            stats.drawnFrames,
+            if (stats.drawnFrames == 0L) 0L else stats.totalDrawNanos / stats.drawnFrames,
+            stats.maxDrawNanos
+        )
+    }
+
+    @Synchronized
+    fun resetCanvasDrawMetrics() {
+        for (stats in canvasDrawStats) {
+            stats.drawnFrames = 0L
+            stats.totalDrawNanos = 0L
+            stats.maxDrawNanos = 0L
+        }
+    }
+
+    internal fun isSurfaceCanvasLocked() = surfaceCanvas != null
 
     private external fun unbindAndReleaseGastNode(nodePointer: Long)
 
@@ -207,6 +696,8 @@ class GastNode @JvmOverloads constructor(
     fun setName(name: String) {
         checkIfReleased()
         nativeSetName(nodePointer, name)
+        gastManager.textureUpdateScheduler.updateNodePath(textureUpdateEntry, nodePath)
+        gastManager.onGastNodePathUpdated(this)
     }
 
     private external fun nativeSetName(nodePointer: Long, name: String)
@@ -225,6 +716,8 @@ class GastNode @JvmOverloads constructor(
             } else {
                 if (updateGastNodeParent(nodePointer, newParentNodePath, emptyParent)) {
                     parentNodePath = newParentNodePath;
+                    gastManager.textureUpdateScheduler.updateNodePath(textureUpdateEntry, nodePath)
+                    gastManager.onGastNodePathUpdated(this)
                 }
             }
         }
@@ -247,6 +740,7 @@ class GastNode @JvmOverloads constructor(
     ) {
         checkIfReleased()
         updateGastNodeVisibility(nodePointer, shouldDuplicateParentVisibility, visible)
+        textureUpdateEntry.visible = visible
     }
 
     private external fun updateGastNodeVisibility(
@@ -255,6 +749,45 @@ class GastNode @JvmOverloads constructor(
         visible: Boolean
     )
 
+    /**
+     * Display the texture of the [source] node instead of this node's own texture, so a single
+     * producer and a single texture update per frame feed several nodes (e.g: mirror or
+     * spectator views). The input received by this node is routed to [source].
+     *
+     * If [source] itself displays a shared texture, this node binds to the same source.
+     * @throws IllegalStateException if this node has a surface bound, is bound to a
+     * [GastTextureAtlas], or is itself the source of a shared texture.
+     */
+    fun bindToSharedTexture(source: GastNode) {
+        checkIfReleased()
+        source.checkIfReleased()
+        if (surface != null || textureAtlas != null) {
+            throw IllegalStateException("Node has its own texture content.")
+        }
+
+        val textureSource = source.sharedTextureSource ?: source
+        if (!nativeBindToSharedTexture(nodePointer, textureSource.nodePointer)) {
+            throw IllegalStateException("Unable to bind to the shared texture.")
+        }
+        sharedTextureSource = textureSource
+    }
+
+    private external fun nativeBindToSharedTexture(
+        nodePointer: Long,
+        sourceNodePointer: Long
+    ): Boolean
+
+    /**
+     * Revert to displaying this node's own texture.
+     */
+    fun unbindFromSharedTexture() {
+        checkIfReleased()
+        nativeUnbindFromSharedTexture(nodePointer)
+        sharedTextureSource = null
+    }
+
+    private external fun nativeUnbindFromSharedTexture(nodePointer: Long)
+
     /**
      * Update the collision flag for the Gast node.
      * @param collidable - True to enable collision, false to disable.
@@ -392,15 +925,4 @@ class GastNode @JvmOverloads constructor(
 
     private external fun nativeGetNodePath(nodePointer: Long): String
 
-    override fun onFrameAvailable(surfaceTexture: SurfaceTexture) {
-        updateTextureImageCounter.incrementAndGet()
-    }
-
-    override fun onRenderDrawFrame() {
-        var counter = updateTextureImageCounter.get()
-        while (counter > 0) {
-            surfaceTexture?.updateTexImage()
-            counter = updateTextureImageCounter.decrementAndGet()
-        }
-    }
 }
@@ -0,0 +1,76 @@
+package org.godotengine.plugin.gast
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Layout of the snapshot written by [GastManager.snapshotGastNodes], in native byte order.
+ *
+ * Mirrors src/main/cpp/scene/gast_node_snapshot.h#GastNodeSnapshotLayout
+ *
+ * The buffer starts with a [HEADER_SIZE] bytes header holding the number of entries written
+ * (Int), followed by the number of [GastNode]s in the scene (Int), which exceeds the entries
+ * written when the buffer is too small.
+ *
+ * The entries follow, [ENTRY_SIZE] bytes each, with the fields at the given offsets:
+ * - [HANDLE_OFFSET] (Long): node handle, matching [GastNode.nodePointer]
+ * - [PATH_HASH_OFFSET] (Int): hash of the node path, see [hashNodePath]
+ * - [FLAGS_OFFSET] (Int): combination of the FLAG_* values
+ * - [TEXTURE_ID_OFFSET] (Int): external texture id
+ * - [VISIBLE_OFFSET] (Int): 1 if visible in the tree, 0 otherwise
+ * - [BASIS_OFFSET] (Float x 9): global transform basis, row major
+ * - [ORIGIN_OFFSET] (Float x 3): global transform origin
+ * - [SIZE_OFFSET] (Float x 2): node size (width, height)
+ */
+object GastNodeSnapshot {
+    const val HEADER_SIZE = 8
+    const val ENTRY_COUNT_OFFSET = 0
+    const val NODE_COUNT_OFFSET = 4
+
+    const val ENTRY_SIZE = 80
+    const val HANDLE_OFFSET = 0
+    const val PATH_HASH_OFFSET = 8
+    const val FLAGS_OFFSET = 12
+    const val TEXTURE_ID_OFFSET = 16
+    const val VISIBLE_OFFSET = 20
+    const val BASIS_OFFSET = 24
+    const val ORIGIN_OFFSET = 60
+    const val SIZE_OFFSET = 72
+
+    const val FLAG_COLLIDABLE = 1 shl 0
+    const val FLAG_CURVED = 1 shl 1
+    const val FLAG_GAZE_TRACKING = 1 shl 2
+    const val FLAG_RENDER_ON_TOP = 1 shl 3
+
+    /**
+     * Capacity in bytes of a snapshot buffer holding up to [nodeCount] entries.
+     */
+    fun getRequiredCapacity(nodeCount: Int) = HEADER_SIZE + nodeCount * ENTRY_SIZE
+
+    /**
+     * Allocate a direct buffer holding up to [nodeCount] entries, in native byte order.
+     */
+    fun allocateBuffer(nodeCount: Int): ByteBuffer =
+        ByteBuffer.allocateDirect(getRequiredCapacity(nodeCount)).order(ByteOrder.nativeOrder())
+
+    /**
+     * Offset of the entry at [index] in the snapshot buffer.
+     */
+    fun getEntryOffset(index: Int) = HEADER_SIZE + index * ENTRY_SIZE
+
+    /**
+     * Hash of the given node path, as reported in the snapshot entries.
+     *
+     * Matches Godot's String::hash (djb2 over the characters).
+     */
+    fun hashNodePath(nodePath: String): Int {
+        var hash = 5381
+        var i = 0
+        while (i < nodePath.length) {
+            val codePoint = nodePath.codePointAt(i)
+            hash = (hash shl 5) + hash + codePoint
+            i += Character.charCount(codePoint)
+        }
+        return hash
+    }
+}
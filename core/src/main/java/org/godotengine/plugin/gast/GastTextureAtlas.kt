@@ -0,0 +1,209 @@
+package org.godotengine.plugin.gast
+
+import android.graphics.Canvas
+import android.graphics.Color
+import android.graphics.PorterDuff
+import android.graphics.Rect
+import android.graphics.SurfaceTexture
+import android.view.Surface
+import java.util.concurrent.ConcurrentHashMap
+
+/**
+ * Texture shared by several [GastNode] nodes, each sampling its own region of it.
+ *
+ * Small panels (buttons, labels, toasts) can be packed into a single atlas so that they share one
+ * [SurfaceTexture], and one updateTexImage call per frame, instead of one per panel.
+ *
+ * Input events for a node bound to an atlas report coordinates relative to the whole atlas, since
+ * that's the surface the content is drawn into.
+ *
+ * The constructor, [allocateRegion], [releaseRegion] and [release] must be invoked on the render
+ * thread.
+ *
+ * @constructor Create a texture atlas with the given dimensions in pixels.
+ */
+class GastTextureAtlas(
+    private val gastManager: GastManager,
+    val width: Int,
+    val height: Int
+) {
+
+    private val textureUpdateEntry = GastTextureUpdateScheduler.Entry()
+    private val regions = ConcurrentHashMap<GastNode, Rect>()
+
+    private var atlasId: Int
+    private var surfaceTexture: SurfaceTexture? = null
+    private var surface: Surface? = null
+    private var surfaceCanvas: Canvas? = null
+
+    init {
+        atlasId = nativeCreateTextureAtlas(width, height)
+        if (atlasId == INVALID_ATLAS_ID) {
+            throw IllegalStateException("Unable to initialize texture atlas.")
+        }
+
+        val texId = nativeGetTextureId(atlasId)
+        if (texId == INVALID_TEX_ID) {
+            throw IllegalStateException("Unable to initialize texture atlas texture.")
+        }
+
+        surfaceTexture = SurfaceTexture(texId).apply {
+            setDefaultBufferSize(width, height)
+            setOnFrameAvailableListener(textureUpdateEntry)
+        }
+        surface = Surface(surfaceTexture)
+
+        textureUpdateEntry.surfaceTexture = surfaceTexture
+        gastManager.textureUpdateScheduler.register(textureUpdateEntry)
+    }
+
+    companion object {
+        private const val INVALID_ATLAS_ID = 0
+        private const val INVALID_TEX_ID = 0
+    }
+
+    fun isReleased() = atlasId == INVALID_ATLAS_ID
+
+    private fun checkIfReleased() {
+        if (isReleased()) {
+            throw IllegalStateException("GastTextureAtlas is already released")
+        }
+    }
+
+    /**
+     * Release the atlas. The nodes bound to it revert to their own texture.
+     */
+    fun release() {
+        if (isReleased()) {
+            return
+        }
+
+        gastManager.textureUpdateScheduler.unregister(textureUpdateEntry)
+
+        for (gastNode in regions.keys) {
+            gastNode.textureAtlas = null
+        }
+        regions.clear()
+
+        surface?.release()
+        surface = null
+        surfaceTexture?.release()
+        surfaceTexture = null
+
+        nativeReleaseTextureAtlas(atlasId)
+        atlasId = INVALID_ATLAS_ID
+    }
+
+    /**
+     * Allocate a region of the given size for the given node and bind the node to it.
+     *
+     * The node must not have a [Surface] bound to it.
+     * @return The allocated region in pixels, or null if there's no room left in the atlas.
+     */
+    fun allocateRegion(gastNode: GastNode, regionWidth: Int, regionHeight: Int): Rect? {
+        checkIfReleased()
+        gastNode.textureAtlas?.releaseRegion(gastNode)
+        gastNode.unbindSurface()
+        if (gastNode.sharedTextureSource != null) {
+            gastNode.unbindFromSharedTexture()
+        }
+
+        val regionValues = IntArray(4)
+        if (!nativeAllocateRegion(
+                atlasId,
+                gastNode.nodePointer,
+                regionWidth,
+                regionHeight,
+                regionValues
+            )
+        ) {
+            return null
+        }
+
+        val region = Rect(
+            regionValues[0],
+            regionValues[1],
+            regionValues[0] + regionValues[2],
+            regionValues[1] + regionValues[3]
+        )
+        regions[gastNode] = region
+        gastNode.textureAtlas = this
+        return Rect(region)
+    }
+
+    /**
+     * Release the region bound to the given node. The node reverts to its own texture.
+     */
+    fun releaseRegion(gastNode: GastNode) {
+        if (regions.remove(gastNode) == null) {
+            return
+        }
+
+        gastNode.textureAtlas = null
+        if (!isReleased() && !gastNode.isReleased()) {
+            nativeReleaseRegion(atlasId, gastNode.nodePointer)
+        }
+    }
+
+    /**
+     * Region bound to the given node, in pixels.
+     */
+    fun getRegion(gastNode: GastNode): Rect? = regions[gastNode]?.let { Rect(it) }
+
+    /**
+     * Gets a [Canvas] for drawing into the region bound to the given node.
+     *
+     * The canvas is clipped and translated to the region, and the region is cleared. The rest of
+     * the atlas retains its content.
+     * After drawing into the provided [Canvas], the caller must invoke [unlockRegionCanvas] to
+     * post the new contents. Only one region can be locked at a time.
+     */
+    fun lockRegionCanvas(gastNode: GastNode): Canvas? {
+        checkIfReleased()
+        val region = regions[gastNode] ?: return null
+        val boundSurface = surface ?: return null
+        if (!boundSurface.isValid) {
+            return null
+        }
+
+        if (surfaceCanvas != null) {
+            throw IllegalStateException("A region canvas is already locked.")
+        }
+
+        val dirty = Rect(region)
+        val canvas = boundSurface.lockCanvas(dirty)
+        canvas.save()
+        canvas.clipRect(region)
+        canvas.drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR)
+        canvas.translate(region.left.toFloat(), region.top.toFloat())
+        surfaceCanvas = canvas
+        return canvas
+    }
+
+    /**
+     * Post the new contents and release the [Canvas] obtained from [lockRegionCanvas].
+     */
+    fun unlockRegionCanvas() {
+        val canvas = surfaceCanvas ?: return
+        canvas.restore()
+        surface?.unlockCanvasAndPost(canvas)
+        surfaceCanvas = null
+    }
+
+    private external fun nativeCreateTextureAtlas(width: Int, height: Int): Int
+
+    private external fun nativeReleaseTextureAtlas(atlasId: Int)
+
+    private external fun nativeGetTextureId(atlasId: Int): Int
+
+    private external fun nativeAllocateRegion(
+        atlasId: Int,
+        nodePointer: Long,
+        width: Int,
+        height: Int,
+        regionOut: IntArray
+    ): Boolean
+
+    private external fun nativeReleaseRegion(atlasId: Int, nodePointer: Long)
+
+}
@@ -0,0 +1,236 @@
+package org.godotengine.plugin.gast
+
+import android.graphics.SurfaceTexture
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.ConcurrentLinkedQueue
+import java.util.concurrent.TimeUnit
+import java.util.concurrent.atomic.AtomicInteger
+import kotlin.math.max
+
+/**
+ * Schedules the texture updates ([SurfaceTexture.updateTexImage] calls) performed on the render
+ * thread.
+ *
+ * Each frame, only the newest frame of each texture is latched, and textures are updated in
+ * priority order (visible, focused, recently interacted) until the per-frame budget is exhausted.
+ * Textures that don't fit in the budget are carried over to the next frame.
+ */
+class GastTextureUpdateScheduler internal constructor() {
+
+    companion object {
+        private const val VISIBLE_PRIORITY = 4
+        private const val FOCUSED_PRIORITY = 2
+        private const val RECENT_INTERACTION_PRIORITY = 1
+        private val RECENT_INTERACTION_WINDOW_NANOS = TimeUnit.SECONDS.toNanos(2)
+    }
+
+    /**
+     * Snapshot of the scheduler metrics since the last [resetMetrics] call.
+     *
+     * @property latchedFrames Number of frames latched via updateTexImage.
+     * @property droppedFrames Number of frames superseded by a newer frame before being latched.
+     * @property deferredUpdates Number of texture updates pushed to the next frame because the
+     * per-frame budget was exhausted.
+     * @property averageLatchLatencyNanos Average time between a frame becoming available and it
+     * being latched.
+     * @property maxLatchLatencyNanos Max time between a frame becoming available and it being
+     * latched.
+     */
+    data class Metrics(
+        val latchedFrames: Long,
+        val droppedFrames: Long,
+        val deferredUpdates: Long,
+        val averageLatchLatencyNanos: Long,
+        val maxLatchLatencyNanos: Long
+    )
+
+    /**
+     * Scheduling state for a [SurfaceTexture].
+     */
+    internal class Entry : SurfaceTexture.OnFrameAvailableListener {
+        @Volatile
+        var surfaceTexture: SurfaceTexture? = null
+
+        @Volatile
+        var visible = true
+
+        // Whether a press is in progress on the node.
+        @Volatile
+        var focused = false
+
+        @Volatile
+        var lastInteractionNanos = 0L
+
+        @Volatile
+        var lastLatchNanos = 0L
+
+        // Invoked on the render thread after a frame is latched.
+        var onFrameLatched: (() -> Unit)? = null
+
+        internal var nodePath: String? = null
+        internal val pendingFrames = AtomicInteger()
+
+        @Volatile
+        internal var firstPendingFrameNanos = 0L
+        internal var priority = 0
+
+        override fun onFrameAvailable(surfaceTexture: SurfaceTexture) {
+            if (pendingFrames.getAndIncrement() == 0) {
+                firstPendingFrameNanos = System.nanoTime()
+            }
+        }
+    }
+
+    /**
+     * Max number of textures updated per frame.
+     */
+    @Volatile
+    var maxUpdatesPerFrame = Int.MAX_VALUE
+
+    /**
+     * Max time spent updating textures per frame, in nanoseconds. The highest priority texture is
+     * always updated, regardless of the budget.
+     */
+    @Volatile
+    var frameBudgetNanos = Long.MAX_VALUE
+
+    private val entries = ConcurrentLinkedQueue<Entry>()
+    private val entriesPerNodePath = ConcurrentHashMap<String, Entry>()
+
+    // Only accessed on the render thread.
+    private val pendingEntries = ArrayList<Entry>()
+    private val priorityComparator = Comparator<Entry> { first, second ->
+        if (first.priority != second.priority) {
+            second.priority - first.priority
+        } else {
+            // Oldest pending frame first.
+            first.firstPendingFrameNanos.compareTo(second.firstPendingFrameNanos)
+        }
+    }
+
+    private var latchedFrames = 0L
+    private var droppedFrames = 0L
+    private var deferredUpdates = 0L
+    private var totalLatchLatencyNanos = 0L
+    private var maxLatchLatencyNanos = 0L
+
+    internal fun register(entry: Entry, nodePath: String? = null) {
+        entries += entry
+        updateNodePath(entry, nodePath)
+    }
+
+    internal fun unregister(entry: Entry) {
+        entries -= entry
+        updateNodePath(entry, null)
+        entry.surfaceTexture = null
+    }
+
+    internal fun updateNodePath(entry: Entry, nodePath: String?) {
+        entry.nodePath?.let { entriesPerNodePath.remove(it, entry) }
+        entry.nodePath = nodePath
+        if (!nodePath.isNullOrEmpty()) {
+            entriesPerNodePath[nodePath] = entry
+        }
+    }
+
+    /**
+     * Record an input event targeting the given node.
+     * @param focused Whether a press is in progress on the node, or null if unchanged.
+     */
+    internal fun onInputEvent(nodePath: String, focused: Boolean?) {
+        val entry = entriesPerNodePath[nodePath] ?: return
+        focused?.let { entry.focused = it }
+        entry.lastInteractionNanos = System.nanoTime()
+    }
+
+    /**
+     * Returns a snapshot of the metrics.
+     */
+    @Synchronized
+    fun getMetrics() = Metrics(
+        latchedFrames,
+        droppedFrames,
+        deferredUpdates,
+        if (latchedFrames == 0L) 0L else totalLatchLatencyNanos / latchedFrames,
+        maxLatchLatencyNanos
+    )
+
+    @Synchronized
+    fun resetMetrics() {
+        latchedFrames = 0L
+        droppedFrames = 0L
+        deferredUpdates = 0L
+        totalLatchLatencyNanos = 0L
+        maxLatchLatencyNanos = 0L
+    }
+
+    /**
+     * Latch the pending frames within the per-frame budget.
+     *
+     * This is invoked on the render thread.
+     */
+    internal fun onRenderDrawFrame() {
+        val frameStartNanos = System.nanoTime()
+
+        for (entry in entries) {
+            if (entry.pendingFrames.get() > 0 && entry.surfaceTexture != null) {
+                var priority = 0
+                if (entry.visible) {
+                    priority += VISIBLE_PRIORITY
+                }
+                if (entry.focused) {
+                    priority += FOCUSED_PRIORITY
+                }
+                if (frameStartNanos - entry.lastInteractionNanos < RECENT_INTERACTION_WINDOW_NANOS) {
+                    priority += RECENT_INTERACTION_PRIORITY
+                }
+                entry.priority = priority
+                pendingEntries += entry
+            }
+        }
+
+        if (pendingEntries.isEmpty()) {
+            return
+        }
+        pendingEntries.sortWith(priorityComparator)
+
+        synchronized(this) {
+            val maxUpdates = max(1, maxUpdatesPerFrame)
+            var updates = 0
+            for (entry in pendingEntries) {
+                if (updates > 0 &&
+                    (updates >= maxUpdates || System.nanoTime() - frameStartNanos >= frameBudgetNanos)
+                ) {
+                    deferredUpdates++
+                    continue
+                }
+
+                val firstPendingFrameNanos = entry.firstPendingFrameNanos
+                val pendingFrames = entry.pendingFrames.getAndSet(0)
+                if (pendingFrames == 0) {
+                    continue
+                }
+
+                // Latching once is enough: queued frames are superseded by the newest one.
+                entry.surfaceTexture?.updateTexImage() ?: continue
+                updates++
+
+                val latchNanos = System.nanoTime()
+                val latchLatencyNanos = max(0L, latchNanos - firstPendingFrameNanos)
+                entry.lastLatchNanos = latchNanos
+                latchedFrames++
+                droppedFrames += pendingFrames - 1
+                totalLatchLatencyNanos += latchLatencyNanos
+                maxLatchLatencyNanos = max(maxLatchLatencyNanos, latchLatencyNanos)
+            }
+        }
+
+        for (entry in pendingEntries) {
+            if (entry.lastLatchNanos >= frameStartNanos) {
+                entry.onFrameLatched?.invoke()
+            }
+        }
+
+        pendingEntries.clear()
+    }
+}
@@ -40,6 +40,67 @@ interface GastInputListener {
         }
     }
 
+    /**
+     * Classifies the high-level gestures detected by the native gesture stage.
+     *
+     * Mirrors src/main/cpp/input/gesture_recognizer.h#GestureType
+     */
+    enum class GestureType(private val index: Int) {
+        /**
+         * Invalid gesture.
+         */
+        INVALID(-1),
+
+        /**
+         * Press and release without moving past the touch slop.
+         */
+        TAP(0),
+
+        /**
+         * Second tap in quick succession, dispatched right after its [TAP].
+         */
+        DOUBLE_TAP(1),
+
+        /**
+         * Press held in place past the long press timeout.
+         */
+        LONG_PRESS(2),
+
+        /**
+         * Press that moved past the touch slop. Reports the press coordinates.
+         */
+        DRAG_START(3),
+
+        /**
+         * Movement during a drag.
+         */
+        DRAG_UPDATE(4),
+
+        /**
+         * Release that ended a drag.
+         */
+        DRAG_END(5),
+
+        /**
+         * Drag released with a velocity past the fling threshold, dispatched right after its
+         * [DRAG_END].
+         */
+        FLING(6);
+
+        companion object {
+            internal fun fromIndex(index: Int): GestureType = when (index) {
+                TAP.index -> TAP
+                DOUBLE_TAP.index -> DOUBLE_TAP
+                LONG_PRESS.index -> LONG_PRESS
+                DRAG_START.index -> DRAG_START
+                DRAG_UPDATE.index -> DRAG_UPDATE
+                DRAG_END.index -> DRAG_END
+                FLING.index -> FLING
+                else -> INVALID
+            }
+        }
+    }
+
     /**
      * Return a set of input actions to monitor.
      * @see [onMainInputAction]
@@ -47,10 +108,28 @@ interface GastInputListener {
      */
     fun getInputActionsToMonitor(): Set<String> = emptySet()
 
+    /**
+     * Return the set of gestures to monitor.
+     *
+     * The native gesture stage is only enabled while at least one registered listener monitors
+     * gestures.
+     * @see [onMainInputGesture]
+     */
+    fun getGestureTypesToMonitor(): Set<GestureType> = emptySet()
+
+    /**
+     * Whether the callbacks must be invoked on the main thread, e.g: because they touch views.
+     *
+     * Listeners returning false are invoked on a dedicated high priority input thread instead,
+     * so their delivery isn't held up by the work running on the main thread. The events for the
+     * main thread listeners are delivered in batches, with the superseded hover events coalesced.
+     */
+    fun isMainThreadRequired(): Boolean = true
+
     /**
      * Callback for input action events.
      *
-     * This is invoked on the main thread.
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
      * @see [getInputActionsToMonitor]
      * @see https://docs.godotengine.org/en/stable/classes/class_inputeventaction.html
      */
@@ -59,28 +138,82 @@ interface GastInputListener {
     /**
      * Callback for hover input events.
      *
-     * This is invoked on the main thread.
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
      */
     fun onMainInputHover(nodePath: String, pointerId: String, xPercent: Float, yPercent: Float)
 
+    /**
+     * Callback for hover input events, with the time at which the input was captured.
+     *
+     * [captureTimeNanos] is based on the same clock as [android.os.SystemClock.uptimeMillis].
+     * Defaults to [onMainInputHover] without the capture time.
+     *
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
+     */
+    fun onMainInputHover(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
+    ) {
+        onMainInputHover(nodePath, pointerId, xPercent, yPercent)
+    }
+
     /**
      * Callback for press input events.
      *
-     * This is invoked on the main thread.
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
      */
     fun onMainInputPress(nodePath: String, pointerId: String, xPercent: Float, yPercent: Float)
 
+    /**
+     * Callback for press input events, with the time at which the input was captured.
+     *
+     * [captureTimeNanos] is based on the same clock as [android.os.SystemClock.uptimeMillis].
+     * Defaults to [onMainInputPress] without the capture time.
+     *
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
+     */
+    fun onMainInputPress(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
+    ) {
+        onMainInputPress(nodePath, pointerId, xPercent, yPercent)
+    }
+
     /**
      * Callback for release input events.
      *
-     * This is invoked on the main thread.
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
      */
     fun onMainInputRelease(nodePath: String, pointerId: String, xPercent: Float, yPercent: Float)
 
+    /**
+     * Callback for release input events, with the time at which the input was captured.
+     *
+     * [captureTimeNanos] is based on the same clock as [android.os.SystemClock.uptimeMillis].
+     * Defaults to [onMainInputRelease] without the capture time.
+     *
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
+     */
+    fun onMainInputRelease(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
+    ) {
+        onMainInputRelease(nodePath, pointerId, xPercent, yPercent)
+    }
+
     /**
      * Callback for scroll input events.
      *
-     * This is invoked on the main thread.
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
      */
     fun onMainInputScroll(
         nodePath: String,
@@ -90,4 +223,45 @@ interface GastInputListener {
         horizontalDelta: Float,
         verticalDelta: Float
     )
+
+    /**
+     * Callback for scroll input events, with the time at which the input was captured.
+     *
+     * [captureTimeNanos] is based on the same clock as [android.os.SystemClock.uptimeMillis].
+     * Defaults to [onMainInputScroll] without the capture time.
+     *
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
+     */
+    fun onMainInputScroll(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        horizontalDelta: Float,
+        verticalDelta: Float,
+        captureTimeNanos: Long
+    ) {
+        onMainInputScroll(nodePath, pointerId, xPercent, yPercent, horizontalDelta, verticalDelta)
+    }
+
+    /**
+     * Callback for gesture input events.
+     *
+     * Coordinates are in percent of the node's dimensions, velocities in percent per second.
+     * [eventTimeNanos] is based on the same clock as [android.os.SystemClock.uptimeMillis].
+     *
+     * This is invoked on the main thread, unless [isMainThreadRequired] returns false.
+     * @see [getGestureTypesToMonitor]
+     */
+    fun onMainInputGesture(
+        nodePath: String,
+        pointerId: String,
+        gestureType: GestureType,
+        xPercent: Float,
+        yPercent: Float,
+        xVelocity: Float,
+        yVelocity: Float,
+        eventTimeNanos: Long
+    ) {
+    }
 }
@@ -0,0 +1,133 @@
+package org.godotengine.plugin.gast.input
+
+import android.os.Handler
+import android.os.HandlerThread
+import android.os.Process
+import java.util.concurrent.ConcurrentLinkedQueue
+import java.util.concurrent.atomic.AtomicBoolean
+
+/**
+ * Delivers the input events from the render thread to the [GastInputListener]s.
+ *
+ * The events are handed off through a lock-free queue to a dedicated high priority input thread,
+ * which invokes the listeners that don't touch views (see
+ * [GastInputListener.isMainThreadRequired]), so they aren't held up by the layout, WebView and
+ * other work running on the main thread.
+ *
+ * The events for the remaining listeners are marshalled to the main thread in batches: each
+ * batch holds all the events delivered since the previous one was dispatched, and the hover
+ * events superseded by a later hover of the same pointer are coalesced.
+ */
+internal class InputDeliveryPipeline(
+    private val mainThreadHandler: Handler,
+    private val latencyTracker: InputLatencyTracker
+) {
+
+    companion object {
+        private const val INPUT_THREAD_NAME = "GastInput"
+    }
+
+    private val inputThread =
+        HandlerThread(INPUT_THREAD_NAME, Process.THREAD_PRIORITY_URGENT_DISPLAY).apply { start() }
+    private val inputThreadHandler = Handler(inputThread.looper)
+
+    // Filled on the render thread, drained on the input thread.
+    private val inputThreadQueue = ConcurrentLinkedQueue<InputDispatcher>()
+    private val inputThreadDrainScheduled = AtomicBoolean(false)
+
+    // Filled on the input thread, drained on the main thread.
+    private val mainThreadQueue = ConcurrentLinkedQueue<InputDispatcher>()
+    private val mainThreadDrainScheduled = AtomicBoolean(false)
+
+    // Only accessed on the main thread.
+    private val mainThreadBatch = ArrayList<InputDispatcher>()
+    private val latestHovers = ArrayList<HoverEventData>()
+
+    private val drainInputThreadQueue = Runnable {
+        // Cleared ahead of the drain, so events enqueued past this point schedule a new one.
+        inputThreadDrainScheduled.set(false)
+        while (true) {
+            val dispatcher = inputThreadQueue.poll() ?: break
+            latencyTracker.record(
+                InputLatencyTracker.Stage.INPUT_THREAD,
+                dispatcher.eventData.captureTimeNanos
+            )
+            if (dispatcher.dispatch(false)) {
+                mainThreadQueue.offer(dispatcher)
+                if (mainThreadDrainScheduled.compareAndSet(false, true)) {
+                    mainThreadHandler.post(drainMainThreadQueue)
+                }
+            } else {
+                InputDispatcher.releaseInputDispatcher(dispatcher)
+            }
+        }
+    }
+
+    private val drainMainThreadQueue = Runnable {
+        mainThreadDrainScheduled.set(false)
+        while (true) {
+            mainThreadBatch.add(mainThreadQueue.poll() ?: break)
+        }
+
+        coalesceMainThreadBatch()
+        for (dispatcher in mainThreadBatch) {
+            if (!dispatcher.coalesced) {
+                latencyTracker.record(
+                    InputLatencyTracker.Stage.MAIN_THREAD,
+                    dispatcher.eventData.captureTimeNanos
+                )
+                dispatcher.dispatch(true)
+            }
+            InputDispatcher.releaseInputDispatcher(dispatcher)
+        }
+        mainThreadBatch.clear()
+    }
+
+    /**
+     * Enqueue the given dispatcher for delivery. Invoked on the render thread.
+     */
+    fun enqueue(dispatcher: InputDispatcher) {
+        inputThreadQueue.offer(dispatcher)
+        if (inputThreadDrainScheduled.compareAndSet(false, true)) {
+            inputThreadHandler.post(drainInputThreadQueue)
+        }
+    }
+
+    /**
+     * Stop the input thread. Pending events are dropped.
+     */
+    fun shutdown() {
+        inputThread.quitSafely()
+    }
+
+    /**
+     * Flag the hover events followed, within the batch, by another hover of the same pointer with
+     * no other event of that pointer in between.
+     */
+    private fun coalesceMainThreadBatch() {
+        for (i in mainThreadBatch.indices.reversed()) {
+            val dispatcher = mainThreadBatch[i]
+            val eventData = dispatcher.eventData
+            val latestHoverIndex = latestHovers.indexOfFirst { eventData.hasPointerOf(it) }
+            if (eventData is HoverEventData) {
+                if (latestHoverIndex == -1) {
+                    latestHovers.add(eventData)
+                } else {
+                    dispatcher.coalesced = true
+                }
+            } else if (latestHoverIndex != -1) {
+                latestHovers.removeAt(latestHoverIndex)
+            }
+        }
+        latestHovers.clear()
+    }
+
+    private fun InputEventData.hasPointerOf(hover: HoverEventData) = when (this) {
+        is ActionEventData -> false
+        is HoverEventData -> nodePath == hover.nodePath && pointerId == hover.pointerId
+        is PressEventData -> nodePath == hover.nodePath && pointerId == hover.pointerId
+        is ReleaseEventData -> nodePath == hover.nodePath && pointerId == hover.pointerId
+        is ScrollEventData -> nodePath == hover.nodePath && pointerId == hover.pointerId
+        is GestureEventData -> nodePath == hover.nodePath && pointerId == hover.pointerId
+    }
+}
@@ -4,7 +4,7 @@ import android.util.Log
 import androidx.core.util.Pools
 import java.util.Queue
 
-internal class InputDispatcher private constructor() : Runnable {
+internal class InputDispatcher private constructor() {
 
     companion object {
         private const val POOL_MAX_SIZE = 100
@@ -12,13 +12,19 @@ internal class InputDispatcher private constructor() : Runnable {
 
         private val inputDispatcherPool = Pools.SynchronizedPool<InputDispatcher>(POOL_MAX_SIZE)
 
+        /**
+         * @param nodeInputListeners Listeners subscribed to the event's node, notified after
+         * [gastInputListeners]
+         */
         fun acquireInputDispatcher(
-            gastInputListeners: Queue<GastInputListener>,
+            gastInputListeners: Queue<GastInputListener>?,
+            nodeInputListeners: Queue<GastInputListener>?,
             eventData: InputEventData
         ): InputDispatcher {
             val dispatcher = inputDispatcherPool.acquire() ?: InputDispatcher()
             dispatcher.apply {
                 this.gastInputListeners = gastInputListeners
+                this.nodeInputListeners = nodeInputListeners
                 this.eventData = eventData
             }
 
@@ -26,80 +32,115 @@ internal class InputDispatcher private constructor() : Runnable {
         }
 
         fun releaseInputDispatcher(dispatcher: InputDispatcher) {
+            dispatcher.gastInputListeners = null
+            dispatcher.nodeInputListeners = null
+            dispatcher.coalesced = false
             if (!inputDispatcherPool.release(dispatcher)) {
                 Log.w(TAG, "Input dispatcher pool reached its size limit (${POOL_MAX_SIZE})!")
             }
         }
     }
 
-    lateinit var gastInputListeners: Queue<GastInputListener>
+    var gastInputListeners: Queue<GastInputListener>? = null
+    var nodeInputListeners: Queue<GastInputListener>? = null
     lateinit var eventData: InputEventData
 
-    override fun run() {
+    /**
+     * Set when the event is superseded by a later event of the same main thread batch, in which
+     * case it's not dispatched to the main thread listeners.
+     */
+    var coalesced = false
 
-        when (eventData) {
+    /**
+     * Dispatch the event to the listeners running on the calling thread: the ones requiring the
+     * main thread if [mainThread] is true, the others otherwise.
+     *
+     * @return true if some listeners were skipped because they run on the other thread
+     */
+    fun dispatch(mainThread: Boolean): Boolean {
+        var skipped = gastInputListeners?.let { dispatchTo(it, mainThread) } ?: false
+        skipped = (nodeInputListeners?.let { dispatchTo(it, mainThread) } ?: false) || skipped
+        return skipped
+    }
+
+    private fun dispatchTo(listeners: Queue<GastInputListener>, mainThread: Boolean): Boolean {
+        var skipped = false
+        for (listener in listeners) {
+            if (listener.isMainThreadRequired() != mainThread) {
+                skipped = true
+                continue
+            }
+            dispatchTo(listener)
+        }
+        return skipped
+    }
+
+    private fun dispatchTo(listener: GastInputListener) {
+        when (val eventData = eventData) {
             is ActionEventData -> {
-                val actionEventData = eventData as ActionEventData
-                for (listener in gastInputListeners) {
-                    listener.onMainInputAction(
-                        actionEventData.action,
-                        actionEventData.pressState,
-                        actionEventData.strength
-                    )
-                }
+                listener.onMainInputAction(
+                    eventData.action,
+                    eventData.pressState,
+                    eventData.strength
+                )
             }
 
             is HoverEventData -> {
-                val hoverEventData = eventData as HoverEventData
-                for (listener in gastInputListeners) {
-                    listener.onMainInputHover(
-                        hoverEventData.nodePath,
-                        hoverEventData.pointerId,
-                        hoverEventData.xPercent,
-                        hoverEventData.yPercent
-                    )
-                }
+                listener.onMainInputHover(
+                    eventData.nodePath,
+                    eventData.pointerId,
+                    eventData.xPercent,
+                    eventData.yPercent,
+                    eventData.captureTimeNanos
+                )
             }
 
             is PressEventData -> {
-                val pressEventData = eventData as PressEventData
-                for (listener in gastInputListeners) {
-                    listener.onMainInputPress(
-                        pressEventData.nodePath,
-                        pressEventData.pointerId,
-                        pressEventData.xPercent,
-                        pressEventData.yPercent
-                    )
-                }
+                listener.onMainInputPress(
+                    eventData.nodePath,
+                    eventData.pointerId,
+                    eventData.xPercent,
+                    eventData.yPercent,
+                    eventData.captureTimeNanos
+                )
             }
 
             is ReleaseEventData -> {
-                val releaseEventData = eventData as ReleaseEventData
-                for (listener in gastInputListeners) {
-                    listener.onMainInputRelease(
-                        releaseEventData.nodePath,
-                        releaseEventData.pointerId,
-                        releaseEventData.xPercent,
-                        releaseEventData.yPercent
-                    )
-                }
+                listener.onMainInputRelease(
+                    eventData.nodePath,
+                    eventData.pointerId,
+                    eventData.xPercent,
+                    eventData.yPercent,
+                    eventData.captureTimeNanos
+                )
             }
 
             is ScrollEventData -> {
-                val scrollEventData = eventData as ScrollEventData
-                for (listener in gastInputListeners) {
-                    listener.onMainInputScroll(
-                        scrollEventData.nodePath,
-                        scrollEventData.pointerId,
-                        scrollEventData.xPercent,
-                        scrollEventData.yPercent,
-                        scrollEventData.horizontalDelta,
-                        scrollEventData.verticalDelta
+                listener.onMainInputScroll(
+                    eventData.nodePath,
+                    eventData.pointerId,
+                    eventData.xPercent,
+                    eventData.yPercent,
+                    eventData.horizontalDelta,
+                    eventData.verticalDelta,
+                    eventData.captureTimeNanos
+                )
+            }
+
+            is GestureEventData -> {
+                if (listener.getGestureTypesToMonitor().contains(eventData.gestureType)) {
+                    listener.onMainInputGesture(
+                        eventData.nodePath,
+                        eventData.pointerId,
+                        eventData.gestureType,
+                        eventData.xPercent,
+                        eventData.yPercent,
+                        eventData.xVelocity,
+                        eventData.yVelocity,
+                        eventData.eventTimeNanos
                     )
                 }
             }
         }
-
-        releaseInputDispatcher(this)
     }
 }
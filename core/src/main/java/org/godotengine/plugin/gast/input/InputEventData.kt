@@ -1,32 +1,42 @@
 package org.godotengine.plugin.gast.input
 
-internal sealed class InputEventData()
+/**
+ * @property captureTimeNanos Time at which the input was captured by the native code, based on
+ * the same clock as [android.os.SystemClock.uptimeMillis].
+ */
+internal sealed class InputEventData() {
+    abstract val captureTimeNanos: Long
+}
 
 internal data class ActionEventData(
     val action: String,
     val pressState: GastInputListener.InputPressState,
-    val strength: Float
+    val strength: Float,
+    override val captureTimeNanos: Long
 ) : InputEventData()
 
 internal data class HoverEventData(
     val nodePath: String,
     val pointerId: String,
     val xPercent: Float,
-    val yPercent: Float
+    val yPercent: Float,
+    override val captureTimeNanos: Long
 ) : InputEventData()
 
 internal data class PressEventData(
     val nodePath: String,
     val pointerId: String,
     val xPercent: Float,
-    val yPercent: Float
+    val yPercent: Float,
+    override val captureTimeNanos: Long
 ) : InputEventData()
 
 internal data class ReleaseEventData(
     val nodePath: String,
     val pointerId: String,
     val xPercent: Float,
-    val yPercent: Float
+    val yPercent: Float,
+    override val captureTimeNanos: Long
 ) : InputEventData()
 
 internal data class ScrollEventData(
@@ -35,5 +45,20 @@ internal data class ScrollEventData(
     val xPercent: Float,
     val yPercent: Float,
     val horizontalDelta: Float,
-    val verticalDelta: Float
+    val verticalDelta: Float,
+    override val captureTimeNanos: Long
 ) : InputEventData()
+
+internal data class GestureEventData(
+    val nodePath: String,
+    val pointerId: String,
+    val gestureType: GastInputListener.GestureType,
+    val xPercent: Float,
+    val yPercent: Float,
+    val xVelocity: Float,
+    val yVelocity: Float,
+    val eventTimeNanos: Long
+) : InputEventData() {
+    override val captureTimeNanos: Long
+        get() = eventTimeNanos
+}
@@ -0,0 +1,142 @@
+package org.godotengine.plugin.gast.input
+
+import java.util.concurrent.TimeUnit
+import kotlin.math.ceil
+import kotlin.math.max
+import kotlin.math.min
+
+/**
+ * Aggregates the latency of the input events at each stage of their delivery on the Kotlin side.
+ *
+ * The latencies are measured from the event's capture timestamp, sampled by the native code when
+ * the input was captured, and based on the same clock as [android.os.SystemClock.uptimeMillis]
+ * and [System.nanoTime]. They are recorded into fixed histograms, so percentiles are reported at
+ * the histogram bucket granularity (250us).
+ *
+ * The latencies of the native stages are available via
+ * [org.godotengine.plugin.gast.GastManager.getNativeInputLatencyPercentileNanos].
+ */
+class InputLatencyTracker internal constructor() {
+
+    companion object {
+        private val BUCKET_WIDTH_NANOS = TimeUnit.MICROSECONDS.toNanos(250)
+
+        /**
+         * The last bucket also holds the latencies past its range, i.e: 100ms and up.
+         */
+        private const val BUCKET_COUNT = 400
+    }
+
+    /**
+     * Stages of the input delivery on the Kotlin side.
+     */
+    enum class Stage {
+        /**
+         * Capture to the render thread callback.
+         */
+        RENDER_THREAD,
+
+        /**
+         * Capture to the dispatch to the [GastInputListener]s on the input thread.
+         */
+        INPUT_THREAD,
+
+        /**
+         * Capture to the dispatch to the [GastInputListener]s requiring the main thread.
+         */
+        MAIN_THREAD,
+
+        /**
+         * Capture to the dispatch of the synthesized [android.view.MotionEvent] to the views.
+         */
+        VIEW
+    }
+
+    /**
+     * Stages of the native input pipeline.
+     *
+     * Mirrors src/main/cpp/input/input_latency_tracker.h#InputLatencyStage
+     */
+    enum class NativeStage(internal val index: Int) {
+        /**
+         * Capture to the invocation of the render thread callback, including the time spent in
+         * the native gesture and scroll stages.
+         */
+        NATIVE_DISPATCH(0),
+
+        /**
+         * Duration of the render thread callback.
+         */
+        JNI_CALLBACK(1),
+
+        /**
+         * Age of the latest pointer sample at the end of each rendered frame input processing,
+         * with [org.godotengine.plugin.gast.GastManager.InputSamplingMode.PHYSICS_TICK].
+         */
+        PHYSICS_TICK_SAMPLE_AGE(2),
+
+        /**
+         * Age of the latest pointer sample at the end of each rendered frame input processing,
+         * with [org.godotengine.plugin.gast.GastManager.InputSamplingMode.RENDER_FRAME] or the
+         * [org.godotengine.plugin.gast.GastManager.PickingMode.BVH] picking mode.
+         */
+        RENDER_FRAME_SAMPLE_AGE(3)
+    }
+
+    private class Histogram {
+        val buckets = LongArray(BUCKET_COUNT)
+        var sampleCount = 0L
+    }
+
+    private val histograms = Array(Stage.values().size) { Histogram() }
+
+    internal fun record(stage: Stage, captureTimeNanos: Long) {
+        val latencyNanos = max(0L, System.nanoTime() - captureTimeNanos)
+        val bucket = min(latencyNanos / BUCKET_WIDTH_NANOS, BUCKET_COUNT - 1L).toInt()
+        val histogram = histograms[stage.ordinal]
+        synchronized(histogram) {
+            histogram.buckets[bucket]++
+            histogram.sampleCount++
+        }
+    }
+
+    /**
+     * Latency under which [percentile] (in [0, 100]) of the events recorded for [stage] fall, or
+     * 0 if no event was recorded.
+     */
+    fun getPercentileNanos(stage: Stage, percentile: Float): Long {
+        val histogram = histograms[stage.ordinal]
+        synchronized(histogram) {
+            if (histogram.sampleCount == 0L) {
+                return 0
+            }
+
+            val clampedPercentile = min(100f, max(0f, percentile))
+            val rank = max(1L, ceil(clampedPercentile / 100f * histogram.sampleCount).toLong())
+            var cumulativeCount = 0L
+            for (i in 0 until BUCKET_COUNT) {
+                cumulativeCount += histogram.buckets[i]
+                if (cumulativeCount >= rank) {
+                    return (i + 1) * BUCKET_WIDTH_NANOS
+                }
+            }
+            return BUCKET_COUNT * BUCKET_WIDTH_NANOS
+        }
+    }
+
+    fun getSampleCount(stage: Stage): Long {
+        val histogram = histograms[stage.ordinal]
+        synchronized(histogram) {
+            return histogram.sampleCount
+        }
+    }
+
+    fun reset() {
+        for (histogram in histograms) {
+            synchronized(histogram) {
+                histogram.buckets.fill(0)
+                histogram.sampleCount = 0
+            }
+        }
+    }
+}
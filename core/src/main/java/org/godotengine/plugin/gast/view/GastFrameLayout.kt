@@ -2,9 +2,11 @@ package org.godotengine.plugin.gast.view
 
 import android.content.Context
 import android.graphics.Canvas
+import android.graphics.Rect
 import android.util.AttributeSet
 import android.util.Log
 import android.view.View
+import android.view.ViewParent
 import android.view.ViewTreeObserver
 import android.widget.FrameLayout
 import androidx.annotation.AttrRes
@@ -17,19 +19,35 @@ class GastFrameLayout(
     attrs: AttributeSet?,
     @AttrRes defStyleAttr: Int,
     @StyleRes defStyleRes: Int
-) : FrameLayout(context, attrs, defStyleAttr, defStyleRes) {
+) : FrameLayout(context, attrs, defStyleAttr, defStyleRes), GastNode.TextureBudgetListener,
+    GastNode.HibernationListener {
 
     private val inputHandler: GastViewInputHandler = GastViewInputHandler(this)
     private val onPreDrawListener = ViewTreeObserver.OnPreDrawListener {
         if (isDirty) {
-            invalidate()
+            // Content update; wake up the node if needed.
+            gastNode?.rehydrate()
+            // Redraw without discarding the invalidated regions tracked for the children.
+            invalidateContent()
         }
         return@OnPreDrawListener true
     }
 
+    // Region invalidated by the children since the last draw, in this view's coordinates.
+    private val dirtyRegion = Rect()
+    private val descendantRect = Rect()
+    private val lockedDirtyRect = Rect()
+    // Set when the whole view must be redrawn.
+    private var fullRedrawPending = true
+
     private var textureWidth = MIN_TEXTURE_DIMENSION
     private var textureHeight = MIN_TEXTURE_DIMENSION
 
+    // Ratio of the texture size to the view size, lowered by the texture memory budget.
+    private var textureScale = 1f
+    private var surfaceUnbound = false
+    private var hibernating = false
+
     constructor(
         context: Context,
         attrs: AttributeSet?,
@@ -69,16 +87,27 @@ class GastFrameLayout(
         }
     }
 
-    private var gastManager: GastManager? = null
+    internal var gastManager: GastManager? = null
+        private set
     internal var gastNode: GastNode? = null
 
+    /**
+     * Opt-in to drawing the view hierarchy with a hardware accelerated canvas.
+     * Must be set prior to [initialize].
+     * @see [GastNode.hardwareCanvasEnabled]
+     */
+    var hardwareCanvasEnabled = false
+
     fun initialize(gastManager: GastManager, gastNode: GastNode) {
         Log.d(TAG, "Initializing GastFrameLayout...")
         this.gastManager = gastManager
         this.gastNode = gastNode
+        gastNode.hardwareCanvasEnabled = hardwareCanvasEnabled
         gastNode.bindSurface()
+        gastNode.textureBudgetListener = this
+        gastNode.hibernationListener = this
 
-        gastManager.registerGastInputListener(inputHandler)
+        gastManager.registerGastInputListener(inputHandler, gastNode)
         viewTreeObserver.addOnPreDrawListener(onPreDrawListener)
 
         updateTextureSizeIfNeeded()
@@ -88,14 +117,75 @@ class GastFrameLayout(
     fun shutdown() {
         Log.d(TAG, "Shutting down GastFrameLayout...")
         viewTreeObserver.removeOnPreDrawListener(onPreDrawListener)
-        gastManager?.unregisterGastInputListener(inputHandler)
+        gastNode?.let { gastManager?.unregisterGastInputListener(inputHandler, it) }
+        gastNode?.textureBudgetListener = null
+        gastNode?.hibernationListener = null
         this.gastNode = null
     }
 
+    override fun onHibernate(gastNode: GastNode) {
+        if (gastNode == this.gastNode) {
+            hibernating = true
+        }
+    }
+
+    override fun onRehydrate(gastNode: GastNode) {
+        if (gastNode == this.gastNode) {
+            hibernating = false
+            // The view may have been resized while hibernating.
+            updateTextureSizeIfNeeded()
+            invalidate()
+        }
+    }
+
+    override fun onTextureBudgetDecision(
+        gastNode: GastNode,
+        action: GastNode.TextureBudgetAction,
+        width: Int,
+        height: Int
+    ) {
+        if (gastNode != this.gastNode || hibernating) {
+            return
+        }
+
+        Log.d(TAG, "Texture budget decision: $action, X - $width, Y - $height")
+        when (action) {
+            GastNode.TextureBudgetAction.UNBIND -> {
+                gastNode.unbindSurface()
+                surfaceUnbound = true
+            }
+
+            GastNode.TextureBudgetAction.DOWNSCALE, GastNode.TextureBudgetAction.NONE -> {
+                if (surfaceUnbound) {
+                    gastNode.bindSurface()
+                    surfaceUnbound = false
+                }
+
+                val viewWidth = this.width
+                textureScale =
+                    if (action == GastNode.TextureBudgetAction.NONE || viewWidth == 0) {
+                        1f
+                    } else {
+                        (width.toFloat() / viewWidth).coerceIn(0f, 1f)
+                    }
+                gastNode.surfaceCanvasScale = textureScale
+
+                // Force the texture size update.
+                textureWidth = MIN_TEXTURE_DIMENSION - 1
+                textureHeight = MIN_TEXTURE_DIMENSION - 1
+                updateTextureSizeIfNeeded()
+            }
+        }
+    }
+
     private fun updateTextureSizeIfNeeded() {
+        if (surfaceUnbound || hibernating) {
+            return
+        }
+
         // Update the texture size
-        val widthInPixels = width
-        val heightInPixels = height
+        val widthInPixels = (width * textureScale).toInt()
+        val heightInPixels = (height * textureScale).toInt()
         if ((textureWidth != widthInPixels || textureHeight != heightInPixels)
             && widthInPixels >= MIN_TEXTURE_DIMENSION && heightInPixels >= MIN_TEXTURE_DIMENSION
         ) {
@@ -114,15 +204,82 @@ class GastFrameLayout(
         }
     }
 
+    override fun invalidate() {
+        fullRedrawPending = true
+        super.invalidate()
+    }
+
+    private fun invalidateContent() {
+        super.invalidate()
+    }
+
+    override fun onDescendantInvalidated(child: View, target: View) {
+        super.onDescendantInvalidated(child, target)
+        if (!target.matrix.isIdentity) {
+            // The transformed bounds are not tracked.
+            fullRedrawPending = true
+            return
+        }
+
+        descendantRect.set(0, 0, target.width, target.height)
+        offsetDescendantRectToMyCoords(target, descendantRect)
+        dirtyRegion.union(descendantRect)
+    }
+
+    @Suppress("DEPRECATION")
+    override fun invalidateChildInParent(location: IntArray, dirty: Rect): ViewParent? {
+        // Prior to API 26, the invalidated region is offset into this view's coordinates by the
+        // super implementation.
+        val parent = super.invalidateChildInParent(location, dirty)
+        dirtyRegion.union(dirty)
+        return parent
+    }
+
+    /**
+     * Lock the surface canvas, restricted to the region invalidated since the last draw.
+     */
+    private fun lockSurfaceCanvas(): Canvas? {
+        val gastNode = this.gastNode ?: return null
+        if (gastNode.isSurfaceCanvasLocked()) {
+            return gastNode.lockSurfaceCanvas()
+        }
+
+        val dirtyRect = if (fullRedrawPending || dirtyRegion.isEmpty) {
+            null
+        } else {
+            lockedDirtyRect.set(dirtyRegion)
+            if (!lockedDirtyRect.intersect(0, 0, width, height)) {
+                null
+            } else {
+                lockedDirtyRect
+            }
+        }
+        fullRedrawPending = false
+        dirtyRegion.setEmpty()
+        return gastNode.lockSurfaceCanvas(dirtyRect)
+    }
+
     override fun draw(canvas: Canvas) {
+        if (hibernating) {
+            return
+        }
+
         updateTextureSizeIfNeeded()
-        val surfaceCanvas = gastNode?.lockSurfaceCanvas() ?: canvas
+        if (surfaceUnbound) {
+            return
+        }
+
+        val surfaceCanvas = lockSurfaceCanvas() ?: canvas
         super.draw(surfaceCanvas)
         gastNode?.unlockSurfaceCanvas()
     }
 
     override fun dispatchDraw(canvas: Canvas) {
-        val surfaceCanvas = gastNode?.lockSurfaceCanvas() ?: canvas
+        if (surfaceUnbound || hibernating) {
+            return
+        }
+
+        val surfaceCanvas = lockSurfaceCanvas() ?: canvas
         super.dispatchDraw(surfaceCanvas)
         gastNode?.unlockSurfaceCanvas()
     }
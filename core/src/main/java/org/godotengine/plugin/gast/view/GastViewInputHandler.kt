@@ -1,12 +1,11 @@
 package org.godotengine.plugin.gast.view
 
-import android.os.SystemClock
 import android.view.InputDevice
 import android.view.MotionEvent
 import androidx.collection.ArraySet
 import org.godotengine.plugin.gast.input.GastInputListener
-import kotlin.math.max
-import kotlin.math.min
+import org.godotengine.plugin.gast.input.InputLatencyTracker
+import java.util.concurrent.TimeUnit
 
 /**
  * Utility class used to handle common input related logic.
@@ -20,15 +19,14 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         private const val HOVER_INPUT_SOURCE = InputDevice.SOURCE_CLASS_POINTER
 
         /**
-         * Multiplier to convert the scrolling speed of controller to the speed in Android
-         * scroll event.
+         * Android scroll units (see [MotionEvent.AXIS_VSCROLL]) per unit of scroll delta.
+         *
+         * The native scroll engine emits at most one scroll event per frame, carrying the delta
+         * accumulated over that frame, so the scroll speed (and its acceleration and fling) is
+         * fully controlled by the engine regardless of the render rate. At the default engine
+         * speed, a scroll action held at full strength scrolls by 9.6 units per second.
          */
-        private const val SCROLL_SENSITIVITY = 1.6F
-
-        /**
-         * Upper bound of the speed in the scrolling event.
-         */
-        private const val SCROLL_SPEED_LIMIT = 0.16f
+        private const val SCROLL_UNITS_PER_DELTA = 0.16f
     }
 
     /**
@@ -43,8 +41,14 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
 
     private val pointerIdsTracker = ArraySet<String>(5)
 
-    private fun getScrollByDelta(delta: Float) =
-        max(-SCROLL_SPEED_LIMIT, min(SCROLL_SPEED_LIMIT, SCROLL_SENSITIVITY * delta))
+    private fun getScrollByDelta(delta: Float) = SCROLL_UNITS_PER_DELTA * delta
+
+    private fun recordViewLatency(captureTimeNanos: Long) {
+        gastView.gastManager?.inputLatencyTracker?.record(
+            InputLatencyTracker.Stage.VIEW,
+            captureTimeNanos
+        )
+    }
 
     private fun obtainMotionEvent(
         pointerId: String,
@@ -116,6 +120,9 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         )
     }
 
+    // The input events are dispatched to the views.
+    override fun isMainThreadRequired() = true
+
     override fun onMainInputAction(
         action: String,
         pressState: GastInputListener.InputPressState,
@@ -128,12 +135,23 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         pointerId: String,
         xPercent: Float,
         yPercent: Float
+    ) {
+        onMainInputHover(nodePath, pointerId, xPercent, yPercent, System.nanoTime())
+    }
+
+    override fun onMainInputHover(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
         if (nodePath.isBlank() || nodePath != gastView.gastNode?.nodePath) {
             return
         }
 
-        val eventTime = SystemClock.uptimeMillis()
+        // The capture time and the motion events times share the same clock.
+        val eventTime = TimeUnit.NANOSECONDS.toMillis(captureTimeNanos)
 
         // xPercent and yPercent being less than 0 indicates this is no longer being looked at.
         if (!onDownSet.contains(pointerId) && xPercent < 0 && yPercent < 0) {
@@ -181,6 +199,7 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
                 motionEvent.recycle()
             }
         }
+        recordViewLatency(captureTimeNanos)
     }
 
     override fun onMainInputPress(
@@ -188,12 +207,23 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         pointerId: String,
         xPercent: Float,
         yPercent: Float
+    ) {
+        onMainInputPress(nodePath, pointerId, xPercent, yPercent, System.nanoTime())
+    }
+
+    override fun onMainInputPress(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
         if (nodePath.isBlank() || nodePath != gastView.gastNode?.nodePath) {
             return
         }
 
-        val eventTime = SystemClock.uptimeMillis()
+        // The capture time and the motion events times share the same clock.
+        val eventTime = TimeUnit.NANOSECONDS.toMillis(captureTimeNanos)
         val xCoord = xPercent * gastView.width
         val yCoord = yPercent * gastView.height
 
@@ -224,6 +254,7 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         gastView.dispatchTouchEvent(motionEvent)
         onDownSet.add(pointerId)
         motionEvent.recycle()
+        recordViewLatency(captureTimeNanos)
     }
 
     override fun onMainInputRelease(
@@ -231,6 +262,16 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         pointerId: String,
         xPercent: Float,
         yPercent: Float
+    ) {
+        onMainInputRelease(nodePath, pointerId, xPercent, yPercent, System.nanoTime())
+    }
+
+    override fun onMainInputRelease(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        captureTimeNanos: Long
     ) {
         if (nodePath.isBlank() || nodePath != gastView.gastNode?.nodePath) {
             return
@@ -240,7 +281,8 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
             return
         }
 
-        val eventTime = SystemClock.uptimeMillis()
+        // The capture time and the motion events times share the same clock.
+        val eventTime = TimeUnit.NANOSECONDS.toMillis(captureTimeNanos)
         val xCoord = xPercent * gastView.width
         val yCoord = yPercent * gastView.height
 
@@ -256,6 +298,7 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         gastView.dispatchTouchEvent(motionEvent)
         onDownSet.remove(pointerId)
         motionEvent.recycle()
+        recordViewLatency(captureTimeNanos)
     }
 
     override fun onMainInputScroll(
@@ -265,12 +308,33 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
         yPercent: Float,
         horizontalDelta: Float,
         verticalDelta: Float
+    ) {
+        onMainInputScroll(
+            nodePath,
+            pointerId,
+            xPercent,
+            yPercent,
+            horizontalDelta,
+            verticalDelta,
+            System.nanoTime()
+        )
+    }
+
+    override fun onMainInputScroll(
+        nodePath: String,
+        pointerId: String,
+        xPercent: Float,
+        yPercent: Float,
+        horizontalDelta: Float,
+        verticalDelta: Float,
+        captureTimeNanos: Long
     ) {
         if (nodePath.isBlank() || nodePath != gastView.gastNode?.nodePath) {
             return
         }
 
-        val eventTime = SystemClock.uptimeMillis()
+        // The capture time and the motion events times share the same clock.
+        val eventTime = TimeUnit.NANOSECONDS.toMillis(captureTimeNanos)
         val xCoord = xPercent * gastView.width
         val yCoord = yPercent * gastView.height
 
@@ -281,6 +345,7 @@ internal class GastViewInputHandler(private val gastView: GastFrameLayout) : Gas
             obtainScrollEvent(pointerId, eventTime, xCoord, yCoord, scrollByX, scrollByY)
         gastView.dispatchGenericMotionEvent(motionEvent)
         motionEvent.recycle()
+        recordViewLatency(captureTimeNanos)
     }
 
     private fun getMotionEventPointerId(godotPointerId: String): Int {
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "memory/allocation_tracker.h"
+#include "scene/ray_cast_collisions.h"
+
+// Compares the RayCastCollisions container with the std::map<String, std::shared_ptr<...>> it
+// replaced in GastNode, on the per physics tick collision bookkeeping.
+//
+// Each tick, every ray cast collides with the node and its collision state is looked up (and
+// added if needed) then updated. Every kTicksPerReentry ticks, the ray casts leave the node and
+// their state is removed.
+
+using namespace gast;
+
+namespace {
+constexpr int kTickCount = 1000000;
+constexpr int kTicksPerReentry = 64;
+constexpr int kMaxRayCastCount = 4;
+
+// Paths of the ray casts, as returned by Node::get_path().
+const char *const kRayCastPaths[kMaxRayCastCount] = {
+        "/root/Main/ARVROrigin/LeftController/RayCast",
+        "/root/Main/ARVROrigin/RightController/RayCast",
+        "/root/Main/ARVROrigin/ARVRCamera/GazeRayCast",
+        "/root/Main/ARVROrigin/LeftHand/PinchRayCast",
+};
+
+// Collision state tracked by GastNode before RayCastCollisions.
+struct CollisionInfo {
+    bool press_in_progress;
+    Vector3 collision_point;
+    Vector3 collision_normal;
+};
+
+struct BenchmarkResult {
+    double nanos_per_tick;
+    double allocations_per_tick;
+};
+
+template<typename Tick>
+BenchmarkResult run(Tick tick) {
+    // Warm up, so the steady state is measured.
+    for (int i = 0; i < kTicksPerReentry; i++) {
+        tick(i);
+    }
+
+    // The whole run is counted as a single allocation tracker frame.
+    AllocationTracker::on_frame();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTickCount; i++) {
+        tick(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    AllocationTracker::on_frame();
+    int64_t allocations = AllocationTracker::get_allocations_per_frame();
+
+    return BenchmarkResult{
+            std::chrono::duration<double, std::nano>(elapsed).count() / kTickCount,
+            static_cast<double>(allocations) / kTickCount};
+}
+
+BenchmarkResult run_map(int ray_cast_count) {
+    std::map<String, std::shared_ptr<CollisionInfo>> colliding_raycast_paths;
+    return run([&](int tick) {
+        for (int i = 0; i < ray_cast_count; i++) {
+            // The path was rebuilt from the ray cast on each access.
+            String ray_cast_path(kRayCastPaths[i]);
+            std::shared_ptr<CollisionInfo> collision_info;
+            if (colliding_raycast_paths.count(ray_cast_path) == 0) {
+                collision_info = std::make_shared<CollisionInfo>();
+                collision_info->press_in_progress = false;
+                colliding_raycast_paths[ray_cast_path] = collision_info;
+            } else {
+                collision_info = colliding_raycast_paths[ray_cast_path];
+            }
+            collision_info->collision_point = Vector3(tick, i, 0);
+            collision_info->collision_normal = Vector3(0, 0, 1);
+        }
+
+        if (tick % kTicksPerReentry == kTicksPerReentry - 1) {
+            for (int i = 0; i < ray_cast_count; i++) {
+                colliding_raycast_paths.erase(String(kRayCastPaths[i]));
+            }
+        }
+    });
+}
+
+BenchmarkResult run_ray_cast_collisions(int ray_cast_count) {
+    RayCastCollisions colliding_ray_casts;
+    return run([&](int tick) {
+        for (int i = 0; i < ray_cast_count; i++) {
+            // The instance id is at hand, the path is only needed when the ray cast is added.
+            int64_t ray_cast_id = 1000 + i;
+            RayCastCollision *collision = colliding_ray_casts.find(ray_cast_id);
+            if (!collision) {
+                collision = &colliding_ray_casts.get_or_add(ray_cast_id,
+                                                            String(kRayCastPaths[i]));
+            }
+            collision->collision_point = Vector3(tick, i, 0);
+            collision->collision_normal = Vector3(0, 0, 1);
+        }
+
+        if (tick % kTicksPerReentry == kTicksPerReentry - 1) {
+            for (int i = 0; i < ray_cast_count; i++) {
+                colliding_ray_casts.remove(1000 + i);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+int main() {
+    printf("%-10s %-22s %12s %16s\n", "ray casts", "container", "ns / tick", "allocs / tick");
+    for (int ray_cast_count = 1; ray_cast_count <= kMaxRayCastCount; ray_cast_count++) {
+        BenchmarkResult map_result = run_map(ray_cast_count);
+        BenchmarkResult flat_result = run_ray_cast_collisions(ray_cast_count);
+        printf("%-10d %-22s %12.1f %16.3f\n", ray_cast_count, "std::map<String, ...>",
+               map_result.nanos_per_tick, map_result.allocations_per_tick);
+        printf("%-10d %-22s %12.1f %16.3f\n", ray_cast_count, "RayCastCollisions",
+               flat_result.nanos_per_tick, flat_result.allocations_per_tick);
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gdn/gast_node.h"
+#include "scene/gast_node_bvh.h"
+#include "scene/gast_node_registry.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+constexpr float kTolerance = 0.0001f;
+// Ray along -z, as cast from a viewer in front of the quads.
+const Vector3 kForward(0, 0, -1);
+
+void test_empty_hierarchy() {
+    GastNodeRegistry registry;
+    GastNodeBvh bvh;
+    bvh.update(registry);
+
+    GastNodePickResult result;
+    EXPECT_EQ(0u, bvh.get_leaf_count());
+    EXPECT_FALSE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+}
+
+void test_pick_hit_and_miss() {
+    GastNodeRegistry registry;
+    GastNode gast_node;
+    gast_node.set_translation(Vector3(1, 1, 0));
+    gast_node.size = Vector2(2, 1);
+    registry.add(&gast_node);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+    EXPECT_EQ(1u, bvh.get_leaf_count());
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(1.5f, 1.25f, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &gast_node);
+    EXPECT_NEAR(5, result.distance, kTolerance);
+    EXPECT_NEAR(0.5f, result.local_position.x, kTolerance);
+    EXPECT_NEAR(0.25f, result.local_position.y, kTolerance);
+    EXPECT_NEAR(1.5f, result.position.x, kTolerance);
+    EXPECT_NEAR(1.25f, result.position.y, kTolerance);
+    // The normal faces the ray.
+    EXPECT_NEAR(1, result.normal.z, kTolerance);
+
+    // Past the quad edges.
+    EXPECT_FALSE(bvh.pick(Vector3(2.1f, 1, 5), kForward, 100, &result));
+    EXPECT_FALSE(bvh.pick(Vector3(1, 1.6f, 5), kForward, 100, &result));
+    // Beyond the max distance.
+    EXPECT_FALSE(bvh.pick(Vector3(1, 1, 5), kForward, 4, &result));
+    // Pointing away.
+    EXPECT_FALSE(bvh.pick(Vector3(1, 1, 5), -kForward, 100, &result));
+    // Parallel to the quad.
+    EXPECT_FALSE(bvh.pick(Vector3(-5, 1, 0), Vector3(1, 0, 0), 100, &result));
+}
+
+void test_pick_rotated_node() {
+    GastNodeRegistry registry;
+    GastNode gast_node;
+    // Facing +x.
+    gast_node.set_global_transform(
+            Transform(Basis(Vector3(0, 1, 0), M_PI / 2), Vector3(3, 0, 0)));
+    registry.add(&gast_node);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(10, 0.5f, 0.5f), Vector3(-1, 0, 0), 100, &result));
+    EXPECT_NEAR(7, result.distance, kTolerance);
+    EXPECT_NEAR(1, result.normal.x, kTolerance);
+    EXPECT_NEAR(0.5f, result.local_position.y, kTolerance);
+    EXPECT_FALSE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+}
+
+void test_pick_closest_hit() {
+    GastNodeRegistry registry;
+    GastNode far, near;
+    far.set_translation(Vector3(0, 0, -3));
+    near.set_translation(Vector3(0, 0, -1));
+    registry.add(&far);
+    registry.add(&near);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &near);
+    EXPECT_NEAR(6, result.distance, kTolerance);
+
+    // From behind, the other one is the closest.
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, -10), -kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &far);
+}
+
+void test_pick_collision_mask() {
+    GastNodeRegistry registry;
+    GastNode near, far;
+    near.set_translation(Vector3(0, 0, -1));
+    near.collision_layer = 0b10;
+    far.set_translation(Vector3(0, 0, -3));
+    far.collision_layer = 0b01;
+    registry.add(&near);
+    registry.add(&far);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &near);
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result, 0b10));
+    EXPECT_TRUE(result.gast_node == &near);
+
+    // The ray goes through the nodes on other layers.
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result, 0b01));
+    EXPECT_TRUE(result.gast_node == &far);
+    EXPECT_FALSE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result, 0b100));
+}
+
+void test_skips_invisible_and_non_collidable_nodes() {
+    GastNodeRegistry registry;
+    GastNode invisible, non_collidable, behind;
+    invisible.set_visible(false);
+    non_collidable.registry_flags = kGastNodeFlagCurved;
+    non_collidable.set_translation(Vector3(0, 0, -1));
+    behind.set_translation(Vector3(0, 0, -2));
+    registry.add(&invisible);
+    registry.add(&non_collidable);
+    registry.add(&behind);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+    EXPECT_EQ(1u, bvh.get_leaf_count());
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &behind);
+
+    // Toggling the visibility or the flags rebuilds the hierarchy.
+    registry.update_visibility(invisible, true);
+    registry.update_flags(behind, kGastNodeFlagNone);
+    bvh.update(registry);
+    EXPECT_EQ(1u, bvh.get_leaf_count());
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &invisible);
+}
+
+void test_build_over_many_nodes() {
+    constexpr int kColumns = 10;
+    GastNodeRegistry registry;
+    std::vector<std::unique_ptr<GastNode>> gast_nodes;
+    for (int i = 0; i < kColumns * kColumns; i++) {
+        gast_nodes.emplace_back(new GastNode());
+        gast_nodes.back()->set_translation(
+                Vector3((i % kColumns) * 3, (i / kColumns) * 3, -(i % 7)));
+        registry.add(gast_nodes.back().get());
+    }
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+    EXPECT_EQ(gast_nodes.size(), bvh.get_leaf_count());
+
+    GastNodePickResult result;
+    for (int i = 0; i < kColumns * kColumns; i++) {
+        Vector3 origin((i % kColumns) * 3 + 0.5f, (i / kColumns) * 3 - 0.5f, 5);
+        EXPECT_TRUE(bvh.pick(origin, kForward, 100, &result));
+        EXPECT_TRUE(result.gast_node == gast_nodes[i].get());
+        EXPECT_NEAR(5 + (i % 7), result.distance, kTolerance);
+
+        // Between the quads.
+        EXPECT_FALSE(bvh.pick(origin + Vector3(1, 0, 0), kForward, 100, &result));
+    }
+}
+
+void test_refit_after_transform_change() {
+    GastNodeRegistry registry;
+    GastNode first, second, third;
+    first.set_translation(Vector3(-5, 0, 0));
+    second.set_translation(Vector3(0, 0, 0));
+    third.set_translation(Vector3(5, 0, 0));
+    registry.add(&first);
+    registry.add(&second);
+    registry.add(&third);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+    EXPECT_FALSE(registry.has_dirty_bounds());
+
+    // Move the first node outside of the hierarchy's initial bounds.
+    first.set_translation(Vector3(0, 20, -2));
+    registry.update_global_transform(first, first.get_global_transform());
+    uint64_t layout_version = registry.get_layout_version();
+    bvh.update(registry);
+    EXPECT_EQ(layout_version, registry.get_layout_version());
+    EXPECT_FALSE(registry.has_dirty_bounds());
+
+    GastNodePickResult result;
+    EXPECT_FALSE(bvh.pick(Vector3(-5, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(bvh.pick(Vector3(0, 20, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &first);
+    EXPECT_NEAR(7, result.distance, kTolerance);
+
+    // Resizing refits as well.
+    registry.update_size(third, Vector2(20, 2));
+    bvh.update(registry);
+    EXPECT_TRUE(bvh.pick(Vector3(14, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &third);
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &second);
+}
+
+void test_rebuild_after_removal() {
+    GastNodeRegistry registry;
+    GastNode first, second;
+    second.set_translation(Vector3(0, 0, -1));
+    registry.add(&first);
+    registry.add(&second);
+
+    GastNodeBvh bvh;
+    bvh.update(registry);
+
+    registry.remove(&first);
+    bvh.update(registry);
+    EXPECT_EQ(1u, bvh.get_leaf_count());
+
+    GastNodePickResult result;
+    EXPECT_TRUE(bvh.pick(Vector3(0, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &second);
+
+    // The swapped entry's bounds are still tracked by the refit.
+    second.set_translation(Vector3(10, 0, -1));
+    registry.update_global_transform(second, second.get_global_transform());
+    bvh.update(registry);
+    EXPECT_TRUE(bvh.pick(Vector3(10, 0, 5), kForward, 100, &result));
+    EXPECT_TRUE(result.gast_node == &second);
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_empty_hierarchy);
+    RUN_TEST(test_pick_hit_and_miss);
+    RUN_TEST(test_pick_rotated_node);
+    RUN_TEST(test_pick_closest_hit);
+    RUN_TEST(test_pick_collision_mask);
+    RUN_TEST(test_skips_invisible_and_non_collidable_nodes);
+    RUN_TEST(test_build_over_many_nodes);
+    RUN_TEST(test_refit_after_transform_change);
+    RUN_TEST(test_rebuild_after_removal);
+    return GAST_TEST_RESULT();
+}
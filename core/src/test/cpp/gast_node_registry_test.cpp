@@ -0,0 +1,204 @@
+#include <cstdint>
+#include <vector>
+
+#include "gdn/gast_node.h"
+#include "scene/gast_node_registry.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+
+void test_add_fills_the_arrays() {
+    GastNodeRegistry registry;
+    GastNode gast_node;
+    gast_node.set_translation(Vector3(1, 2, 3));
+    gast_node.size = Vector2(4, 5);
+    gast_node.registry_flags = kGastNodeFlagCollidable | kGastNodeFlagCurved;
+    gast_node.external_texture_id = 7;
+    gast_node.set_visible(false);
+    gast_node.path = "/root/Container/GastNode";
+
+    registry.add(&gast_node);
+    EXPECT_EQ(1u, registry.size());
+    EXPECT_EQ(0, registry.get_index(gast_node));
+    EXPECT_TRUE(registry.get_nodes()[0] == &gast_node);
+    EXPECT_TRUE(registry.get_global_transforms()[0] == gast_node.get_global_transform());
+    EXPECT_TRUE(registry.get_sizes()[0] == Vector2(4, 5));
+    EXPECT_TRUE(registry.has_flags(0, kGastNodeFlagCurved));
+    EXPECT_FALSE(registry.has_flags(0, kGastNodeFlagGazeTracking));
+    EXPECT_EQ(7, registry.get_texture_ids()[0]);
+    EXPECT_FALSE(registry.is_visible(0));
+    EXPECT_EQ(String("/root/Container/GastNode").hash(), registry.get_path_hashes()[0]);
+    EXPECT_TRUE(registry.is_bounds_dirty(0));
+
+    // Adding twice is a no-op.
+    registry.add(&gast_node);
+    EXPECT_EQ(1u, registry.size());
+}
+
+void test_remove_swaps_the_last_entry() {
+    GastNodeRegistry registry;
+    GastNode first, second, third;
+    first.path = "/root/First";
+    second.path = "/root/Second";
+    third.path = "/root/Third";
+    third.size = Vector2(3, 3);
+    third.external_texture_id = 3;
+    registry.add(&first);
+    registry.add(&second);
+    registry.add(&third);
+
+    registry.remove(&first);
+    EXPECT_EQ(2u, registry.size());
+    EXPECT_EQ(kInvalidRegistryIndex, registry.get_index(first));
+    EXPECT_EQ(0, registry.get_index(third));
+    EXPECT_EQ(1, registry.get_index(second));
+    EXPECT_TRUE(registry.get_nodes()[0] == &third);
+    EXPECT_TRUE(registry.get_sizes()[0] == Vector2(3, 3));
+    EXPECT_EQ(3, registry.get_texture_ids()[0]);
+    EXPECT_EQ(String("/root/Third").hash(), registry.get_path_hashes()[0]);
+
+    // Removing the last entry doesn't move any other.
+    registry.remove(&second);
+    EXPECT_EQ(1u, registry.size());
+    EXPECT_EQ(0, registry.get_index(third));
+
+    // Removing an unregistered node is a no-op.
+    registry.remove(&first);
+    registry.remove(nullptr);
+    EXPECT_EQ(1u, registry.size());
+}
+
+void test_contains() {
+    GastNodeRegistry registry;
+    GastNode first, second;
+    EXPECT_FALSE(registry.contains(&first));
+    EXPECT_FALSE(registry.contains(nullptr));
+
+    registry.add(&first);
+    registry.add(&second);
+    EXPECT_TRUE(registry.contains(&first));
+    EXPECT_TRUE(registry.contains(&second));
+
+    // A node removed while iterating over a copy of the nodes is skipped by the callers.
+    std::vector<GastNode *> nodes = registry.get_nodes();
+    registry.remove(&first);
+    EXPECT_FALSE(registry.contains(nodes[0]));
+    EXPECT_TRUE(registry.contains(nodes[1]));
+}
+
+void test_updates_only_apply_to_registered_nodes() {
+    GastNodeRegistry registry;
+    GastNode registered, unregistered;
+    registry.add(&registered);
+
+    Transform transform(Basis(), Vector3(0, 0, -2));
+    registry.update_global_transform(registered, transform);
+    registry.update_size(registered, Vector2(6, 8));
+    registry.update_texture_id(registered, 12);
+    registry.update_path_hash(registered, 1234);
+    EXPECT_TRUE(registry.get_global_transforms()[0] == transform);
+    EXPECT_TRUE(registry.get_sizes()[0] == Vector2(6, 8));
+    EXPECT_EQ(12, registry.get_texture_ids()[0]);
+    EXPECT_EQ(1234u, registry.get_path_hashes()[0]);
+
+    registry.update_size(unregistered, Vector2(1, 1));
+    registry.update_path_hash(unregistered, 1);
+    EXPECT_EQ(1u, registry.size());
+    EXPECT_TRUE(registry.get_sizes()[0] == Vector2(6, 8));
+    EXPECT_EQ(1234u, registry.get_path_hashes()[0]);
+}
+
+void test_layout_version() {
+    GastNodeRegistry registry;
+    GastNode gast_node;
+    uint64_t version = registry.get_layout_version();
+
+    registry.add(&gast_node);
+    EXPECT_TRUE(registry.get_layout_version() > version);
+
+    // Bounds, texture and path updates don't change the layout.
+    version = registry.get_layout_version();
+    registry.update_size(gast_node, Vector2(1, 1));
+    registry.update_texture_id(gast_node, 1);
+    registry.update_path_hash(gast_node, 1);
+    EXPECT_EQ(version, registry.get_layout_version());
+
+    // Neither do flags and visibility updates to the same value.
+    registry.update_flags(gast_node, gast_node.registry_flags);
+    registry.update_visibility(gast_node, true);
+    EXPECT_EQ(version, registry.get_layout_version());
+
+    registry.update_flags(gast_node, kGastNodeFlagNone);
+    EXPECT_TRUE(registry.get_layout_version() > version);
+
+    version = registry.get_layout_version();
+    registry.update_visibility(gast_node, false);
+    EXPECT_TRUE(registry.get_layout_version() > version);
+
+    version = registry.get_layout_version();
+    registry.remove(&gast_node);
+    EXPECT_TRUE(registry.get_layout_version() > version);
+}
+
+void test_dirty_bounds() {
+    GastNodeRegistry registry;
+    GastNode first, second;
+    registry.add(&first);
+    registry.add(&second);
+    EXPECT_TRUE(registry.has_dirty_bounds());
+
+    registry.clear_dirty_bounds();
+    EXPECT_FALSE(registry.has_dirty_bounds());
+    EXPECT_FALSE(registry.is_bounds_dirty(0));
+    EXPECT_FALSE(registry.is_bounds_dirty(1));
+
+    registry.update_flags(second, kGastNodeFlagCurved);
+    registry.update_texture_id(second, 4);
+    EXPECT_FALSE(registry.has_dirty_bounds());
+
+    registry.update_size(second, Vector2(3, 1));
+    EXPECT_TRUE(registry.has_dirty_bounds());
+    EXPECT_FALSE(registry.is_bounds_dirty(0));
+    EXPECT_TRUE(registry.is_bounds_dirty(1));
+
+    registry.clear_dirty_bounds();
+    registry.update_global_transform(first, Transform(Basis(), Vector3(1, 0, 0)));
+    EXPECT_TRUE(registry.is_bounds_dirty(0));
+
+    // The dirty flag follows the entry when it's swapped.
+    registry.clear_dirty_bounds();
+    registry.update_size(second, Vector2(2, 2));
+    registry.remove(&first);
+    EXPECT_TRUE(registry.is_bounds_dirty(0));
+}
+
+void test_clear() {
+    GastNodeRegistry registry;
+    GastNode first, second;
+    registry.add(&first);
+    registry.add(&second);
+
+    registry.clear();
+    EXPECT_EQ(0u, registry.size());
+    EXPECT_EQ(kInvalidRegistryIndex, registry.get_index(first));
+    EXPECT_EQ(kInvalidRegistryIndex, registry.get_index(second));
+    EXPECT_TRUE(registry.get_path_hashes().empty());
+
+    registry.add(&second);
+    EXPECT_EQ(0, registry.get_index(second));
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_add_fills_the_arrays);
+    RUN_TEST(test_remove_swaps_the_last_entry);
+    RUN_TEST(test_contains);
+    RUN_TEST(test_updates_only_apply_to_registered_nodes);
+    RUN_TEST(test_layout_version);
+    RUN_TEST(test_dirty_bounds);
+    RUN_TEST(test_clear);
+    return GAST_TEST_RESULT();
+}
@@ -0,0 +1,211 @@
+#include <cstdint>
+#include <vector>
+
+#include "gdn/gast_node.h"
+#include "input/gesture_recognizer.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+constexpr int64_t kNanosPerMilli = 1000000;
+constexpr float kTolerance = 0.0001f;
+
+const String kNodePath = "/root/Container/GastNode";
+const String kPointerId = "/root/RayCast";
+
+/// Records the gestures emitted by the recognizer.
+class GestureRecorder {
+public:
+    GestureRecorder() : recognizer([this](const GestureEvent &event) {
+        events.push_back(event);
+    }) {}
+
+    std::vector<GestureType> get_types() const {
+        std::vector<GestureType> types;
+        for (const GestureEvent &event : events) {
+            types.push_back(event.type);
+        }
+        return types;
+    }
+
+    void tap(Vector2 position, int64_t timestamp_nanos) {
+        recognizer.on_press(&gast_node, kNodePath, kPointerId, position, timestamp_nanos);
+        recognizer.on_release(&gast_node, kNodePath, kPointerId, position,
+                              timestamp_nanos + 50 * kNanosPerMilli);
+    }
+
+    GastNode gast_node;
+    std::vector<GestureEvent> events;
+    GestureRecognizer recognizer;
+};
+
+void test_tap() {
+    GestureRecorder recorder;
+    recorder.tap(Vector2(0.5f, 0.5f), 0);
+
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kTap}));
+    const GestureEvent &event = recorder.events[0];
+    EXPECT_TRUE(event.gast_node == &recorder.gast_node);
+    EXPECT_TRUE(event.node_path == kNodePath);
+    EXPECT_TRUE(event.pointer_id == kPointerId);
+    EXPECT_TRUE(event.position == Vector2(0.5f, 0.5f));
+}
+
+void test_tap_within_touch_slop() {
+    GestureRecorder recorder;
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.5f, 0.5f),
+                                 0);
+    recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId,
+                                 Vector2(0.51f, 0.5f), 16 * kNanosPerMilli);
+    recorder.recognizer.on_release(&recorder.gast_node, kNodePath, kPointerId,
+                                   Vector2(0.51f, 0.5f), 32 * kNanosPerMilli);
+
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kTap}));
+}
+
+void test_double_tap() {
+    GestureRecorder recorder;
+    recorder.tap(Vector2(0.5f, 0.5f), 0);
+    recorder.recognizer.on_frame(100 * kNanosPerMilli);
+    recorder.tap(Vector2(0.52f, 0.5f), 200 * kNanosPerMilli);
+
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kTap, kTap, kDoubleTap}));
+
+    // A third tap starts over.
+    recorder.tap(Vector2(0.52f, 0.5f), 400 * kNanosPerMilli);
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kTap, kTap, kDoubleTap, kTap}));
+}
+
+void test_slow_or_distant_taps_are_not_double_taps() {
+    GestureRecorder slow;
+    slow.tap(Vector2(0.5f, 0.5f), 0);
+    slow.tap(Vector2(0.5f, 0.5f), 400 * kNanosPerMilli);
+    EXPECT_TRUE(slow.get_types() == std::vector<GestureType>({kTap, kTap}));
+
+    GestureRecorder distant;
+    distant.tap(Vector2(0.5f, 0.5f), 0);
+    distant.tap(Vector2(0.7f, 0.5f), 100 * kNanosPerMilli);
+    EXPECT_TRUE(distant.get_types() == std::vector<GestureType>({kTap, kTap}));
+}
+
+void test_long_press() {
+    GestureRecorder recorder;
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.5f, 0.5f),
+                                 0);
+    recorder.recognizer.on_frame(400 * kNanosPerMilli);
+    EXPECT_TRUE(recorder.events.empty());
+
+    recorder.recognizer.on_frame(500 * kNanosPerMilli);
+    recorder.recognizer.on_frame(600 * kNanosPerMilli);
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kLongPress}));
+
+    // Neither moving nor releasing after a long press emit anything else.
+    recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId,
+                                 Vector2(0.8f, 0.5f), 700 * kNanosPerMilli);
+    recorder.recognizer.on_release(&recorder.gast_node, kNodePath, kPointerId,
+                                   Vector2(0.8f, 0.5f), 800 * kNanosPerMilli);
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kLongPress}));
+}
+
+void test_drag_and_fling() {
+    GestureRecorder recorder;
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.2f, 0.5f),
+                                 0);
+    for (int i = 1; i <= 5; i++) {
+        recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId,
+                                     Vector2(0.2f + 0.05f * i, 0.5f), i * 16 * kNanosPerMilli);
+    }
+    recorder.recognizer.on_release(&recorder.gast_node, kNodePath, kPointerId,
+                                   Vector2(0.5f, 0.5f), 6 * 16 * kNanosPerMilli);
+
+    EXPECT_TRUE(recorder.get_types() ==
+                std::vector<GestureType>({kDragStart, kDragUpdate, kDragUpdate, kDragUpdate,
+                                          kDragUpdate, kDragUpdate, kDragEnd, kFling}));
+    // The drag starts where the pointer went down.
+    EXPECT_TRUE(recorder.events[0].position == Vector2(0.2f, 0.5f));
+    EXPECT_NEAR(0.25f, recorder.events[1].position.x, kTolerance);
+    const GestureEvent &fling = recorder.events.back();
+    EXPECT_TRUE(fling.velocity.x > 0.5f);
+    EXPECT_NEAR(0, fling.velocity.y, kTolerance);
+}
+
+void test_slow_drag_does_not_fling() {
+    GestureRecorder recorder;
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.2f, 0.5f),
+                                 0);
+    recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.3f, 0.5f),
+                                 100 * kNanosPerMilli);
+    // Held still for a while before releasing.
+    for (int i = 2; i <= 10; i++) {
+        recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId,
+                                     Vector2(0.3f, 0.5f), i * 100 * kNanosPerMilli);
+    }
+    recorder.recognizer.on_release(&recorder.gast_node, kNodePath, kPointerId,
+                                   Vector2(0.3f, 0.5f), 1100 * kNanosPerMilli);
+
+    EXPECT_EQ(kDragEnd, recorder.events.back().type);
+    // The drag started before the long press timeout, so it's not a long press either.
+    for (const GestureEvent &event : recorder.events) {
+        EXPECT_TRUE(event.type != kFling && event.type != kLongPress);
+    }
+}
+
+void test_hover_without_press_is_ignored() {
+    GestureRecorder recorder;
+    recorder.recognizer.on_hover(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.2f, 0.5f),
+                                 0);
+    recorder.recognizer.on_release(&recorder.gast_node, kNodePath, kPointerId,
+                                   Vector2(0.2f, 0.5f), 0);
+    EXPECT_TRUE(recorder.events.empty());
+    EXPECT_EQ(0u, recorder.recognizer.get_pointer_count());
+}
+
+void test_pointers_are_tracked_separately() {
+    GestureRecorder recorder;
+    GastNode other_node;
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.5f, 0.5f),
+                                 0);
+    recorder.recognizer.on_press(&other_node, "/root/Other", kPointerId, Vector2(0.5f, 0.5f), 0);
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, "/root/OtherRayCast",
+                                 Vector2(0.5f, 0.5f), 0);
+    EXPECT_EQ(3u, recorder.recognizer.get_pointer_count());
+
+    recorder.recognizer.on_release(&other_node, "/root/Other", kPointerId, Vector2(0.5f, 0.5f),
+                                   50 * kNanosPerMilli);
+    EXPECT_TRUE(recorder.get_types() == std::vector<GestureType>({kTap}));
+    EXPECT_TRUE(recorder.events[0].gast_node == &other_node);
+}
+
+void test_released_pointers_are_dropped() {
+    GestureRecorder recorder;
+    recorder.tap(Vector2(0.5f, 0.5f), 0);
+    EXPECT_EQ(1u, recorder.recognizer.get_pointer_count());
+
+    // Kept until the double tap window expires.
+    recorder.recognizer.on_frame(200 * kNanosPerMilli);
+    EXPECT_EQ(1u, recorder.recognizer.get_pointer_count());
+    recorder.recognizer.on_frame(400 * kNanosPerMilli);
+    EXPECT_EQ(0u, recorder.recognizer.get_pointer_count());
+
+    recorder.recognizer.on_press(&recorder.gast_node, kNodePath, kPointerId, Vector2(0.5f, 0.5f),
+                                 0);
+    recorder.recognizer.reset();
+    EXPECT_EQ(0u, recorder.recognizer.get_pointer_count());
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_tap);
+    RUN_TEST(test_tap_within_touch_slop);
+    RUN_TEST(test_double_tap);
+    RUN_TEST(test_slow_or_distant_taps_are_not_double_taps);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_drag_and_fling);
+    RUN_TEST(test_slow_drag_does_not_fling);
+    RUN_TEST(test_hover_without_press_is_ignored);
+    RUN_TEST(test_pointers_are_tracked_separately);
+    RUN_TEST(test_released_pointers_are_dropped);
+    return GAST_TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+#include <cstdint>
+
+#include "memory/growth_watchdog.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+
+// Drives the watchdog with synthetic timestamps, one sample per call.
+class WatchdogClock {
+public:
+    explicit WatchdogClock(GrowthWatchdog &watchdog) : watchdog_(watchdog) {
+        // The first frame only starts the sampling interval.
+        watchdog_.on_frame(timestamp_nanos_);
+    }
+
+    void sample() {
+        timestamp_nanos_ += kGrowthWatchdogSamplingIntervalNanos;
+        watchdog_.on_frame(timestamp_nanos_);
+    }
+
+private:
+    GrowthWatchdog &watchdog_;
+    int64_t timestamp_nanos_ = 1;
+};
+
+void test_sustained_growth_is_flagged() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    watchdog.add_gauge("leaking", [&value]() { return value; });
+    WatchdogClock clock(watchdog);
+
+    for (int i = 0; i < kGrowthWatchdogSamplesThreshold - 1; i++) {
+        value++;
+        clock.sample();
+    }
+    EXPECT_TRUE(watchdog.get_growing_gauges().empty());
+
+    value++;
+    clock.sample();
+    EXPECT_EQ(1u, watchdog.get_growing_gauges().size());
+}
+
+void test_step_then_plateau_is_not_flagged() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    watchdog.add_gauge("pool", [&value]() { return value; });
+    WatchdogClock clock(watchdog);
+
+    // A pool filled once, then used in steady state.
+    value = 8;
+    for (int i = 0; i < kGrowthWatchdogSamplesThreshold * 10; i++) {
+        clock.sample();
+    }
+    EXPECT_TRUE(watchdog.get_growing_gauges().empty());
+}
+
+void test_slow_growth_is_flagged() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    watchdog.add_gauge("slow_leak", [&value]() { return value; });
+    WatchdogClock clock(watchdog);
+
+    // Growing on every other sample only.
+    for (int i = 0; i < kGrowthWatchdogSamplesThreshold; i++) {
+        value += i % 2;
+        clock.sample();
+    }
+    EXPECT_EQ(1u, watchdog.get_growing_gauges().size());
+}
+
+void test_decrease_resets_the_run() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    watchdog.add_gauge("oscillating", [&value]() { return value; });
+    WatchdogClock clock(watchdog);
+
+    for (int run = 0; run < 10; run++) {
+        for (int i = 0; i < kGrowthWatchdogSamplesThreshold - 1; i++) {
+            value++;
+            clock.sample();
+        }
+        value = 0;
+        clock.sample();
+    }
+    EXPECT_TRUE(watchdog.get_growing_gauges().empty());
+}
+
+void test_decrease_clears_the_flag() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    watchdog.add_gauge("reclaimed", [&value]() { return value; });
+    WatchdogClock clock(watchdog);
+
+    for (int i = 0; i < kGrowthWatchdogSamplesThreshold; i++) {
+        value++;
+        clock.sample();
+    }
+    EXPECT_EQ(1u, watchdog.get_growing_gauges().size());
+
+    value--;
+    clock.sample();
+    EXPECT_TRUE(watchdog.get_growing_gauges().empty());
+}
+
+void test_samples_at_the_interval_only() {
+    GrowthWatchdog watchdog;
+    int64_t value = 0;
+    int sample_count = 0;
+    watchdog.add_gauge("counted", [&value, &sample_count]() {
+        sample_count++;
+        return value;
+    });
+    // add_gauge() reads the initial value.
+    EXPECT_EQ(1, sample_count);
+
+    int64_t timestamp_nanos = 1;
+    for (int frame = 0; frame < 1000; frame++) {
+        watchdog.on_frame(timestamp_nanos);
+        timestamp_nanos += 16 * 1000000LL;
+    }
+    // 16 seconds worth of frames.
+    EXPECT_EQ(1, sample_count);
+
+    watchdog.on_frame(timestamp_nanos + kGrowthWatchdogSamplingIntervalNanos);
+    EXPECT_EQ(2, sample_count);
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_sustained_growth_is_flagged);
+    RUN_TEST(test_step_then_plateau_is_not_flagged);
+    RUN_TEST(test_slow_growth_is_flagged);
+    RUN_TEST(test_decrease_resets_the_run);
+    RUN_TEST(test_decrease_clears_the_flag);
+    RUN_TEST(test_samples_at_the_interval_only);
+    return GAST_TEST_RESULT();
+}
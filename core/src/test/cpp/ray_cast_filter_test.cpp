@@ -0,0 +1,174 @@
+#include <cmath>
+
+#include "scene/ray_cast_filter.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+constexpr float kTolerance = 0.0001f;
+constexpr uint32_t kDefaultLayer = 1;
+
+// 2x2 quad at the origin, facing +z.
+RayCastFilter::Target make_default_target(uint32_t collision_layer = kDefaultLayer) {
+    return RayCastFilter::make_target(Transform(), Vector2(2, 2), collision_layer);
+}
+
+RayCastSegment make_segment(const Vector3 &from, const Vector3 &to,
+                            uint32_t collision_mask = kDefaultLayer) {
+    RayCastSegment segment;
+    segment.ray_cast = nullptr;
+    segment.from = from;
+    segment.to = to;
+    segment.collision_mask = collision_mask;
+    return segment;
+}
+
+void test_make_target() {
+    RayCastFilter::Target target = make_default_target(4);
+    EXPECT_NEAR(0, target.center.length(), kTolerance);
+    EXPECT_NEAR(1, target.normal.z, kTolerance);
+    EXPECT_NEAR(std::sqrt(2.0f), target.radius, 0.01f);
+    EXPECT_EQ(4u, target.collision_layer);
+
+    // The normal follows the node's rotation.
+    Transform global_transform;
+    global_transform.basis = Basis(Vector3(0, 1, 0), M_PI / 2);
+    global_transform.origin = Vector3(3, 0, 0);
+    target = RayCastFilter::make_target(global_transform, Vector2(2, 2), kDefaultLayer);
+    EXPECT_NEAR(3, target.center.x, kTolerance);
+    EXPECT_NEAR(1, target.normal.x, kTolerance);
+    EXPECT_NEAR(0, target.normal.z, kTolerance);
+}
+
+void test_crossing_segment_is_candidate() {
+    RayCastFilter filter;
+    RayCastFilter::Target target = make_default_target();
+    EXPECT_TRUE(filter.is_candidate(make_segment(Vector3(0, 0, 5), Vector3(0, 0, -5)), target));
+    // Near the corner, still within the bounding sphere.
+    EXPECT_TRUE(filter.is_candidate(make_segment(Vector3(1, 1, 5), Vector3(1, 1, -5)), target));
+    // Ending right on the plane.
+    EXPECT_TRUE(filter.is_candidate(make_segment(Vector3(0, 0, 5), Vector3(0, 0, 0)), target));
+    EXPECT_EQ(0, filter.get_total_culled_pairs());
+}
+
+void test_mask_layer_cull() {
+    RayCastFilter filter;
+    RayCastFilter::Target target = make_default_target(0b10);
+    Vector3 from(0, 0, 5);
+    Vector3 to(0, 0, -5);
+    EXPECT_FALSE(filter.is_candidate(make_segment(from, to, 0b01), target));
+    EXPECT_FALSE(filter.is_candidate(make_segment(from, to, 0), target));
+    EXPECT_TRUE(filter.is_candidate(make_segment(from, to, 0b10), target));
+    EXPECT_TRUE(filter.is_candidate(make_segment(from, to, 0b11), target));
+    EXPECT_EQ(2, filter.get_total_culled_pairs());
+}
+
+void test_behind_plane_cull() {
+    RayCastFilter filter;
+    RayCastFilter::Target target = make_default_target();
+    // Stops short of the node.
+    EXPECT_FALSE(filter.is_candidate(make_segment(Vector3(0, 0, 5), Vector3(0, 0, 1)), target));
+    // Points away from the node.
+    EXPECT_FALSE(filter.is_candidate(make_segment(Vector3(0, 0, 1), Vector3(0, 0, 5)), target));
+    // Entirely behind the node.
+    EXPECT_FALSE(filter.is_candidate(make_segment(Vector3(0, 0, -1), Vector3(0, 0, -5)), target));
+    // Grazing the plane within the margin isn't culled.
+    EXPECT_TRUE(filter.is_candidate(make_segment(Vector3(0, 0, 5), Vector3(0, 0, 0.0005f)),
+                                    target));
+    EXPECT_EQ(3, filter.get_total_culled_pairs());
+}
+
+void test_out_of_reach_cull() {
+    RayCastFilter filter;
+    RayCastFilter::Target target = make_default_target();
+    // Crosses the plane, away from the quad.
+    EXPECT_FALSE(filter.is_candidate(make_segment(Vector3(5, 0, 5), Vector3(5, 0, -5)), target));
+    EXPECT_FALSE(filter.is_candidate(make_segment(Vector3(0, -3, 1), Vector3(0, -3, -1)), target));
+    // Crosses the plane at a slant, passing through the bounding sphere.
+    EXPECT_TRUE(filter.is_candidate(make_segment(Vector3(5, 0, 5), Vector3(-5, 0, -5)), target));
+    EXPECT_EQ(2, filter.get_total_culled_pairs());
+}
+
+void test_counter_rollover() {
+    RayCastFilter filter;
+    RayCastFilter::Target target = make_default_target();
+    RayCastSegment hit = make_segment(Vector3(0, 0, 5), Vector3(0, 0, -5));
+    RayCastSegment miss = make_segment(Vector3(5, 0, 5), Vector3(5, 0, -5));
+    Array ray_casts;
+
+    filter.update(ray_casts, 0);
+    EXPECT_EQ(0, filter.get_tested_pairs_per_frame());
+    EXPECT_EQ(0, filter.get_culled_pairs_per_frame());
+
+    filter.is_candidate(hit, target);
+    filter.is_candidate(miss, target);
+    filter.is_candidate(miss, target);
+    // The per frame counts only change once the frame is completed.
+    EXPECT_EQ(0, filter.get_tested_pairs_per_frame());
+    EXPECT_EQ(2, filter.get_total_culled_pairs());
+
+    filter.update(ray_casts, 1);
+    EXPECT_TRUE(filter.is_up_to_date(1));
+    EXPECT_EQ(3, filter.get_tested_pairs_per_frame());
+    EXPECT_EQ(2, filter.get_culled_pairs_per_frame());
+
+    filter.is_candidate(hit, target);
+    filter.update(ray_casts, 2);
+    EXPECT_EQ(1, filter.get_tested_pairs_per_frame());
+    EXPECT_EQ(0, filter.get_culled_pairs_per_frame());
+
+    // An idle frame resets the per frame counts, but not the total.
+    filter.update(ray_casts, 3);
+    EXPECT_EQ(0, filter.get_tested_pairs_per_frame());
+    EXPECT_EQ(0, filter.get_culled_pairs_per_frame());
+    EXPECT_EQ(2, filter.get_total_culled_pairs());
+}
+
+void test_update_segments() {
+    RayCast enabled_ray_cast;
+    Transform global_transform;
+    global_transform.origin = Vector3(1, 2, 3);
+    enabled_ray_cast.set_global_transform(global_transform);
+    enabled_ray_cast.set_cast_to(Vector3(0, 0, -10));
+    enabled_ray_cast.set_collision_mask(0b110);
+
+    RayCast disabled_ray_cast;
+    disabled_ray_cast.set_enabled(false);
+
+    Array ray_casts;
+    ray_casts.append(&disabled_ray_cast);
+    ray_casts.append(Variant());
+    ray_casts.append(&enabled_ray_cast);
+
+    RayCastFilter filter;
+    EXPECT_FALSE(filter.is_up_to_date(kUnboundPhysicsFrame + 1));
+    filter.update(ray_casts, kUnboundPhysicsFrame);
+    EXPECT_TRUE(filter.is_up_to_date(kUnboundPhysicsFrame));
+
+    // Disabled ray casts and non ray cast entries are skipped.
+    EXPECT_EQ(1u, filter.get_segments().size());
+    const RayCastSegment &segment = filter.get_segments()[0];
+    EXPECT_TRUE(segment.ray_cast == &enabled_ray_cast);
+    EXPECT_TRUE(segment.from == Vector3(1, 2, 3));
+    EXPECT_TRUE(segment.to == Vector3(1, 2, -7));
+    EXPECT_EQ(0b110u, segment.collision_mask);
+
+    // Stale segments are dropped on the next update.
+    enabled_ray_cast.set_enabled(false);
+    filter.update(ray_casts, 0);
+    EXPECT_TRUE(filter.get_segments().empty());
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_make_target);
+    RUN_TEST(test_crossing_segment_is_candidate);
+    RUN_TEST(test_mask_layer_cull);
+    RUN_TEST(test_behind_plane_cull);
+    RUN_TEST(test_out_of_reach_cull);
+    RUN_TEST(test_counter_rollover);
+    RUN_TEST(test_update_segments);
+    return GAST_TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+#include <cstdint>
+#include <vector>
+
+#include "gdn/gast_node.h"
+#include "input/scroll_engine.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+namespace {
+constexpr int64_t kNanosPerMilli = 1000000;
+constexpr int64_t kFrameNanos = 16 * kNanosPerMilli;
+constexpr float kFrameSeconds = 0.016f;
+constexpr float kTolerance = 0.001f;
+
+const String kNodePath = "/root/Container/GastNode";
+const String kPointerId = "/root/RayCast";
+
+/// Records the scrolls emitted by the engine, and drives it frame by frame.
+class ScrollRecorder {
+public:
+    ScrollRecorder() : engine([this](const ScrollEvent &event) { events.push_back(event); }) {}
+
+    void scroll(Vector2 strength) {
+        engine.on_scroll(&gast_node, kNodePath, kPointerId, Vector2(0.5f, 0.5f), strength,
+                         timestamp_nanos);
+    }
+
+    void frame() {
+        engine.on_frame(timestamp_nanos);
+        timestamp_nanos += kFrameNanos;
+    }
+
+    GastNode gast_node;
+    std::vector<ScrollEvent> events;
+    ScrollEngine engine;
+    int64_t timestamp_nanos = kFrameNanos;
+};
+
+void test_one_event_per_frame() {
+    ScrollRecorder recorder;
+    ScrollSettings settings = recorder.engine.get_settings();
+    // The first frame only starts the frame clock.
+    recorder.frame();
+
+    // Several input ticks within the frame.
+    recorder.scroll(Vector2(0, 1));
+    recorder.scroll(Vector2(0, 1));
+    recorder.scroll(Vector2(0, 1));
+    recorder.frame();
+    EXPECT_EQ(1u, recorder.events.size());
+
+    const ScrollEvent &event = recorder.events[0];
+    EXPECT_TRUE(event.gast_node == &recorder.gast_node);
+    EXPECT_TRUE(event.node_path == kNodePath);
+    EXPECT_TRUE(event.pointer_id == kPointerId);
+    EXPECT_NEAR(0, event.delta.x, kTolerance);
+    // One frame worth of scroll at full strength, not accelerated yet.
+    EXPECT_NEAR(settings.speed * kFrameSeconds, event.delta.y, kTolerance);
+    EXPECT_EQ(recorder.timestamp_nanos - kFrameNanos, event.capture_timestamp_nanos);
+
+    // The next frames are accelerated.
+    recorder.scroll(Vector2(0, 1));
+    recorder.frame();
+    float multiplier = 1 + settings.acceleration * kFrameSeconds;
+    EXPECT_NEAR(settings.speed * multiplier * kFrameSeconds, recorder.events[1].delta.y,
+                kTolerance);
+}
+
+void test_acceleration_is_capped() {
+    ScrollRecorder recorder;
+    ScrollSettings settings = recorder.engine.get_settings();
+    recorder.frame();
+
+    // Held for 10 seconds: past the acceleration cap.
+    for (int i = 0; i < 625; i++) {
+        recorder.scroll(Vector2(1, 0));
+        recorder.frame();
+    }
+    EXPECT_EQ(625u, recorder.events.size());
+    float max_delta = settings.speed * settings.max_acceleration_multiplier * kFrameSeconds;
+    EXPECT_NEAR(max_delta, recorder.events.back().delta.x, kTolerance);
+
+    // The deltas keep growing while accelerating.
+    EXPECT_TRUE(recorder.events[100].delta.x > recorder.events[10].delta.x);
+    EXPECT_TRUE(recorder.events[100].delta.x < max_delta);
+}
+
+void test_fling_decays_after_release() {
+    ScrollRecorder recorder;
+    recorder.frame();
+    for (int i = 0; i < 10; i++) {
+        recorder.scroll(Vector2(0, -1));
+        recorder.frame();
+    }
+    float held_delta = recorder.events.back().delta.y;
+    recorder.engine.on_scroll_released(kNodePath, kPointerId);
+
+    size_t held_event_count = recorder.events.size();
+    int frames = 0;
+    while (recorder.engine.get_pointer_count() > 0 && frames < 1000) {
+        recorder.frame();
+        frames++;
+    }
+    EXPECT_EQ(0u, recorder.engine.get_pointer_count());
+    EXPECT_TRUE(recorder.events.size() > held_event_count + 10);
+
+    // The fling continues in the same direction, slowing down.
+    float previous_delta = held_delta;
+    for (size_t i = held_event_count; i < recorder.events.size(); i++) {
+        EXPECT_TRUE(recorder.events[i].delta.y < 0);
+        EXPECT_TRUE(recorder.events[i].delta.y > previous_delta);
+        previous_delta = recorder.events[i].delta.y;
+    }
+}
+
+void test_no_fling_without_friction() {
+    ScrollRecorder recorder;
+    ScrollSettings settings;
+    settings.fling_friction = 0;
+    recorder.engine.set_settings(settings);
+    recorder.frame();
+    recorder.scroll(Vector2(0, 1));
+    recorder.frame();
+    recorder.engine.on_scroll_released(kNodePath, kPointerId);
+
+    size_t event_count = recorder.events.size();
+    recorder.frame();
+    EXPECT_EQ(event_count, recorder.events.size());
+    EXPECT_EQ(0u, recorder.engine.get_pointer_count());
+}
+
+void test_release_timeout() {
+    ScrollRecorder recorder;
+    recorder.frame();
+    recorder.scroll(Vector2(0, 1));
+    recorder.frame();
+
+    // The scroll action is no longer reported, e.g: the pointer moved off the node.
+    for (int i = 0; i < 7; i++) {
+        recorder.frame();
+    }
+    float delta_before_timeout = recorder.events.back().delta.y;
+    recorder.frame();
+    // Past the timeout, the velocity decays.
+    EXPECT_TRUE(recorder.events.back().delta.y < delta_before_timeout);
+}
+
+void test_stalled_frame_is_clamped() {
+    ScrollRecorder recorder;
+    ScrollSettings settings = recorder.engine.get_settings();
+    recorder.frame();
+    recorder.scroll(Vector2(0, 1));
+    recorder.timestamp_nanos += 10 * kFrameNanos;
+    recorder.scroll(Vector2(0, 1));
+    recorder.timestamp_nanos += 1000 * kNanosPerMilli;
+    recorder.scroll(Vector2(0, 1));
+    recorder.frame();
+
+    EXPECT_EQ(1u, recorder.events.size());
+    // At most 100ms worth of scroll, at the maximum multiplier.
+    EXPECT_TRUE(recorder.events[0].delta.y <=
+                settings.speed * settings.max_acceleration_multiplier * 0.1f + kTolerance);
+}
+
+void test_pointers_are_tracked_separately() {
+    ScrollRecorder recorder;
+    GastNode other_node;
+    recorder.frame();
+    recorder.scroll(Vector2(0, 1));
+    recorder.engine.on_scroll(&other_node, "/root/Other", kPointerId, Vector2(), Vector2(1, 0),
+                              recorder.timestamp_nanos);
+    EXPECT_EQ(2u, recorder.engine.get_pointer_count());
+
+    recorder.frame();
+    EXPECT_EQ(2u, recorder.events.size());
+    for (const ScrollEvent &event : recorder.events) {
+        if (event.gast_node == &other_node) {
+            EXPECT_TRUE(event.node_path == String("/root/Other"));
+            EXPECT_TRUE(event.delta.x > 0);
+        } else {
+            EXPECT_TRUE(event.gast_node == &recorder.gast_node);
+            EXPECT_TRUE(event.delta.y > 0);
+        }
+    }
+
+    recorder.engine.reset();
+    EXPECT_EQ(0u, recorder.engine.get_pointer_count());
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_one_event_per_frame);
+    RUN_TEST(test_acceleration_is_capped);
+    RUN_TEST(test_fling_decays_after_release);
+    RUN_TEST(test_no_fling_without_friction);
+    RUN_TEST(test_release_timeout);
+    RUN_TEST(test_stalled_frame_is_clamped);
+    RUN_TEST(test_pointers_are_tracked_separately);
+    return GAST_TEST_RESULT();
+}
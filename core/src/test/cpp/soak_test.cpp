@@ -0,0 +1,533 @@
+#include <algorithm>
+#include <core/Godot.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <gen/Camera.hpp>
+#include <gen/Engine.hpp>
+#include <gen/Input.hpp>
+#include <gen/RayCast.hpp>
+#include <gen/SceneTree.hpp>
+#include <gen/Spatial.hpp>
+#include <jni.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gast_manager.h"
+#include "host_clock.h"
+#include "test_utils.h"
+
+using namespace gast;
+
+// JNI entry points of jni/gast_manager_jni.cpp and jni/gast_node_jni.cpp, as invoked by the
+// Kotlin GastManager and GastNode classes.
+extern "C" {
+void Java_org_godotengine_plugin_gast_GastManager_initialize(JNIEnv *env, jobject object);
+
+void Java_org_godotengine_plugin_gast_GastManager_shutdown(JNIEnv *env, jobject object);
+
+void Java_org_godotengine_plugin_gast_GastManager_setInputActionsToMonitor(
+        JNIEnv *env, jobject object, jobjectArray input_actions_to_monitor);
+
+void Java_org_godotengine_plugin_gast_GastManager_setGestureDetectionEnabled(
+        JNIEnv *env, jobject object, jboolean enabled);
+
+void Java_org_godotengine_plugin_gast_GastManager_nativeSetPickingMode(JNIEnv *env,
+                                                                      jobject object,
+                                                                      jint picking_mode);
+
+jlong Java_org_godotengine_plugin_gast_GastManager_nativeAcquireAndBindGastNode(
+        JNIEnv *env, jobject object, jstring parent_node_path, jboolean empty_parent);
+
+jlong Java_org_godotengine_plugin_gast_GastManager_nativeRequestGastNode(
+        JNIEnv *env, jobject object, jstring parent_node_path, jboolean empty_parent,
+        jboolean high_priority);
+
+void Java_org_godotengine_plugin_gast_GastManager_nativeCancelGastNodeRequest(
+        JNIEnv *env, jobject object, jlong request_id);
+
+jlong Java_org_godotengine_plugin_gast_GastManager_nativePick(
+        JNIEnv *env, jobject object, jfloat origin_x, jfloat origin_y, jfloat origin_z,
+        jfloat direction_x, jfloat direction_y, jfloat direction_z, jfloat max_distance,
+        jfloatArray result_values);
+
+jobjectArray Java_org_godotengine_plugin_gast_GastManager_nativeGetGrowingResources(
+        JNIEnv *env, jobject object);
+
+void Java_org_godotengine_plugin_gast_GastNode_unbindAndReleaseGastNode(JNIEnv *env,
+                                                                       jobject object,
+                                                                       jlong node_pointer);
+
+jboolean Java_org_godotengine_plugin_gast_GastNode_updateGastNodeParent(
+        JNIEnv *env, jobject object, jlong node_pointer, jstring new_parent_node_path,
+        jboolean empty_parent);
+
+void Java_org_godotengine_plugin_gast_GastNode_updateGastNodeLocalTranslation(
+        JNIEnv *env, jobject object, jlong node_pointer, jfloat x_translation,
+        jfloat y_translation, jfloat z_translation);
+
+void Java_org_godotengine_plugin_gast_GastNode_nativeRecordTextureMemory(
+        JNIEnv *env, jobject object, jlong node_pointer, jint width, jint height,
+        jint bits_per_pixel);
+}
+
+namespace {
+constexpr int64_t kFrameDurationNanos = 16 * 1000000LL;
+// Simulated session length. Only the first frames of each sampling interval are simulated, the
+// rest of the interval is skipped.
+constexpr int kSimulatedHours = 4;
+constexpr int kSamplesPerHour = 3600 * 1000000000LL / kGrowthWatchdogSamplingIntervalNanos;
+constexpr int kFramesPerSample = 90;
+
+constexpr size_t kMaxLiveNodes = 32;
+// Grid the nodes are laid out on, facing the ray casts.
+constexpr int kGridColumns = 8;
+constexpr float kGridSpacing = 2.5f;
+
+const char *kGastManagerClassName = "org/godotengine/plugin/gast/GastManager";
+const char *kContainerPaths[] = {"/root/Main/LeftContainer", "/root/Main/RightContainer"};
+
+/// Scope of a call from the Kotlin side. The JVM releases the local references created during
+/// the call when it returns, which the local frame emulates.
+class JavaCallScope {
+public:
+    explicit JavaCallScope(JNIEnv *env) : env_(env) {
+        env_->PushLocalFrame(16);
+    }
+
+    ~JavaCallScope() {
+        env_->PopLocalFrame(nullptr);
+    }
+
+private:
+    JNIEnv *env_;
+};
+
+/// Session of the real GastManager, driven through its JNI entry points the way the Kotlin side
+/// does, while the input is fed through the ray casts of a host scene tree.
+class SoakSession {
+public:
+    explicit SoakSession(bool leak_released_nodes)
+            : leak_released_nodes_(leak_released_nodes) {
+        initial_live_node_count_ = GastNode::get_live_instance_count();
+
+        GastManager::gdn_initialize(&gast_loader_);
+        godot::android_env = &env_;
+        env_.set_call_listener([this](const _jmethodID &method, const std::vector<jvalue> &args) {
+            on_kotlin_callback(method, args);
+        });
+
+        set_up_scene();
+
+        JavaCallScope scope(&env_);
+        callback_ = env_.NewGlobalRef(env_.AllocObject(env_.FindClass(kGastManagerClassName)));
+        Java_org_godotengine_plugin_gast_GastManager_initialize(&env_, callback_);
+        Java_org_godotengine_plugin_gast_GastManager_nativeSetPickingMode(&env_, callback_,
+                                                                          kBvhPicking);
+        Java_org_godotengine_plugin_gast_GastManager_setGestureDetectionEnabled(&env_, callback_,
+                                                                                JNI_TRUE);
+        set_input_actions_to_monitor(get_ray_cast_actions());
+    }
+
+    ~SoakSession() {
+        {
+            JavaCallScope scope(&env_);
+            for (jlong request_id : pending_requests_) {
+                Java_org_godotengine_plugin_gast_GastManager_nativeCancelGastNodeRequest(
+                        &env_, callback_, request_id);
+            }
+            for (jlong handle : handles_) {
+                Java_org_godotengine_plugin_gast_GastNode_unbindAndReleaseGastNode(&env_,
+                                                                                  callback_,
+                                                                                  handle);
+            }
+        }
+
+        // The nodes are freed along the tree, while the GDNative side is still initialized.
+        scene_tree_.reset();
+        godot::Engine::get_singleton()->set_main_loop(nullptr);
+
+        Java_org_godotengine_plugin_gast_GastManager_shutdown(&env_, callback_);
+        GastManager::gdn_shutdown();
+        env_.DeleteGlobalRef(callback_);
+        godot::android_env = nullptr;
+
+        EXPECT_EQ(0, env_.get_global_reference_count());
+        EXPECT_EQ(0, env_.get_pinned_elements_count());
+        EXPECT_EQ(0, env_.get_error_count());
+        // The manager doesn't free its reusable pool on shutdown.
+        EXPECT_TRUE(GastNode::get_live_instance_count() - initial_live_node_count_ <=
+                    static_cast<int64_t>(kMaxReusablePoolSize));
+    }
+
+    /// Brings the containers to their high water marks, then simulates the given number of
+    /// sampling intervals before the results are checked.
+    void warm_up(int sample_count) {
+        while (handles_.size() < kMaxLiveNodes) {
+            acquire();
+        }
+        run_frame();
+        while (handles_.size() > kMaxLiveNodes / 2) {
+            release();
+        }
+
+        for (int sample = 0; sample < sample_count; sample++) {
+            run_sample();
+        }
+    }
+
+    /// Simulates the given number of watchdog sampling intervals. Returns false as soon as a
+    /// resource is reported as growing to the Kotlin side.
+    bool run(int sample_count) {
+        for (int sample = 0; sample < sample_count; sample++) {
+            run_sample();
+
+            std::vector<std::string> growing_resources = get_growing_resources();
+            if (!growing_resources.empty()) {
+                for (const std::string &resource : growing_resources) {
+                    fprintf(stderr, "Sustained growth of %s after %d samples.\n",
+                            resource.c_str(), sample + 1);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    JNIEnv &get_env() {
+        return env_;
+    }
+
+    jobject get_callback() const {
+        return callback_;
+    }
+
+    int get_local_reference_leak() const {
+        return max_local_reference_leak_;
+    }
+
+    int64_t get_callback_count(const std::string &method_name) const {
+        auto it = callback_counts_.find(method_name);
+        return it == callback_counts_.end() ? 0 : it->second;
+    }
+
+    int64_t get_pick_count() const {
+        return pick_count_;
+    }
+
+    void set_input_actions_to_monitor(const std::vector<String> &actions) {
+        JavaCallScope scope(&env_);
+        jclass string_class = env_.FindClass("java/lang/String");
+        jobjectArray input_actions = env_.NewObjectArray(actions.size(), string_class, nullptr);
+        for (size_t i = 0; i < actions.size(); i++) {
+            jstring action = env_.NewStringUTF(actions[i].utf8().get_data());
+            env_.SetObjectArrayElement(input_actions, i, action);
+            env_.DeleteLocalRef(action);
+        }
+
+        env_.reset_peak_local_reference_count();
+        Java_org_godotengine_plugin_gast_GastManager_setInputActionsToMonitor(&env_, callback_,
+                                                                              input_actions);
+    }
+
+private:
+    struct RayCastState {
+        godot::RayCast *ray_cast;
+        String click_action;
+        String scroll_action;
+        bool pressed = false;
+        int frames_until_toggle = 0;
+    };
+
+    void set_up_scene() {
+        scene_tree_ = std::make_unique<godot::SceneTree>();
+        godot::Engine::get_singleton()->set_main_loop(scene_tree_.get());
+
+        auto *main = new godot::Spatial();
+        main->set_name("Main");
+        scene_tree_->get_root()->add_child(main);
+        for (const char *container_name : {"LeftContainer", "RightContainer"}) {
+            auto *container = new godot::Spatial();
+            container->set_name(container_name);
+            main->add_child(container);
+        }
+
+        auto *camera = new godot::Camera();
+        camera->set_name("Camera");
+        camera->set_translation(Vector3(0, 0, 10));
+        main->add_child(camera);
+
+        for (const char *ray_cast_name : {"LeftRayCast", "RightRayCast"}) {
+            auto *ray_cast = new godot::RayCast();
+            ray_cast->set_name(ray_cast_name);
+            ray_cast->set_cast_to(Vector3(0, 0, -10));
+            ray_cast->add_to_group(kGastRayCasterGroupName);
+            main->add_child(ray_cast);
+
+            // Same action names as the GastNode's, derived from the ray cast path.
+            String action_prefix = String(ray_cast->get_path()).replace("/", "_");
+            ray_casts_.push_back({ray_cast, action_prefix + "_click",
+                                  action_prefix + "_up_scroll"});
+        }
+    }
+
+    std::vector<String> get_ray_cast_actions() const {
+        std::vector<String> actions;
+        for (const RayCastState &state : ray_casts_) {
+            actions.push_back(state.click_action);
+            actions.push_back(state.scroll_action);
+        }
+        return actions;
+    }
+
+    void on_kotlin_callback(const _jmethodID &method, const std::vector<jvalue> &args) {
+        callback_counts_[method.name]++;
+        if (method.name == "onGastNodeReady") {
+            pending_requests_.erase(args[0].j);
+            if (args[1].j != 0) {
+                ready_handles_.push_back(args[1].j);
+            }
+        }
+    }
+
+    void run_sample() {
+        for (int frame = 0; frame < kFramesPerSample; frame++) {
+            run_frame();
+        }
+        advance_host_clock(kGrowthWatchdogSamplingIntervalNanos -
+                           kFramesPerSample * kFrameDurationNanos);
+    }
+
+    void run_frame() {
+        advance_host_clock(kFrameDurationNanos);
+        godot::Engine::get_singleton()->iterate();
+
+        // The nodes requested on the previous frames are handed to the Kotlin side.
+        for (jlong handle : ready_handles_) {
+            handles_.push_back(handle);
+            move(handle);
+        }
+        ready_handles_.clear();
+
+        int action = std::uniform_int_distribution<int>(0, 99)(random_);
+        if (action < 4 && get_node_count() < kMaxLiveNodes) {
+            acquire();
+        } else if (action < 8 && get_node_count() < kMaxLiveNodes) {
+            request();
+        } else if (action < 16 && !handles_.empty()) {
+            release();
+        } else if (action < 24 && !handles_.empty()) {
+            reparent(pick_handle());
+        } else if (action < 40 && !handles_.empty()) {
+            move(pick_handle());
+        } else if (action < 44 && !pending_requests_.empty()) {
+            cancel_request();
+        } else if (action < 50) {
+            pick();
+        }
+
+        for (RayCastState &state : ray_casts_) {
+            update_ray_cast(state);
+        }
+
+        // The Godot thread never returns to the JVM, so the local references created by the
+        // Kotlin callbacks must be deleted by the native code.
+        int local_reference_count = env_.get_local_reference_count();
+        GastManager::get_singleton_instance()->on_process();
+        scene_tree_->flush_delete_queue();
+        max_local_reference_leak_ =
+                std::max(max_local_reference_leak_,
+                         env_.get_local_reference_count() - local_reference_count);
+    }
+
+    size_t get_node_count() const {
+        return handles_.size() + pending_requests_.size() + ready_handles_.size();
+    }
+
+    void acquire() {
+        JavaCallScope scope(&env_);
+        jlong handle = Java_org_godotengine_plugin_gast_GastManager_nativeAcquireAndBindGastNode(
+                &env_, callback_, env_.NewStringUTF(pick_container_path()), JNI_FALSE);
+        EXPECT_TRUE(handle != 0);
+        handles_.push_back(handle);
+        move(handle);
+        Java_org_godotengine_plugin_gast_GastNode_nativeRecordTextureMemory(&env_, callback_,
+                                                                           handle, 512, 512, 32);
+    }
+
+    void request() {
+        JavaCallScope scope(&env_);
+        bool high_priority = std::uniform_int_distribution<int>(0, 3)(random_) == 0;
+        jlong request_id = Java_org_godotengine_plugin_gast_GastManager_nativeRequestGastNode(
+                &env_, callback_, env_.NewStringUTF(pick_container_path()), JNI_FALSE,
+                high_priority);
+        pending_requests_.insert(request_id);
+    }
+
+    void cancel_request() {
+        JavaCallScope scope(&env_);
+        auto it = pending_requests_.begin();
+        std::advance(it, std::uniform_int_distribution<size_t>(0, pending_requests_.size() - 1)(
+                random_));
+        Java_org_godotengine_plugin_gast_GastManager_nativeCancelGastNodeRequest(&env_, callback_,
+                                                                                 *it);
+        pending_requests_.erase(it);
+    }
+
+    void release() {
+        auto it = handles_.begin() +
+                  std::uniform_int_distribution<size_t>(0, handles_.size() - 1)(random_);
+        jlong handle = *it;
+        handles_.erase(it);
+        if (leak_released_nodes_) {
+            // Simulated leak: the Kotlin side drops the node without releasing it.
+            return;
+        }
+
+        JavaCallScope scope(&env_);
+        Java_org_godotengine_plugin_gast_GastNode_unbindAndReleaseGastNode(&env_, callback_,
+                                                                          handle);
+    }
+
+    void reparent(jlong handle) {
+        JavaCallScope scope(&env_);
+        Java_org_godotengine_plugin_gast_GastNode_updateGastNodeParent(
+                &env_, callback_, handle, env_.NewStringUTF(pick_container_path()), JNI_FALSE);
+    }
+
+    void move(jlong handle) {
+        JavaCallScope scope(&env_);
+        Vector3 position = random_grid_position();
+        Java_org_godotengine_plugin_gast_GastNode_updateGastNodeLocalTranslation(
+                &env_, callback_, handle, position.x, position.y, position.z);
+    }
+
+    void pick() {
+        JavaCallScope scope(&env_);
+        Vector3 origin = random_grid_position() + Vector3(0.1f, 0.1f, 5);
+        jfloatArray result_values = env_.NewFloatArray(3);
+        if (Java_org_godotengine_plugin_gast_GastManager_nativePick(
+                &env_, callback_, origin.x, origin.y, origin.z, 0, 0, -1, 10,
+                result_values) != 0) {
+            pick_count_++;
+        }
+    }
+
+    void update_ray_cast(RayCastState &state) {
+        // The ray casts mostly linger on a node, and occasionally jump to another one.
+        if (std::uniform_int_distribution<int>(0, 99)(random_) < 5) {
+            state.ray_cast->set_translation(random_grid_position() + Vector3(0.1f, 0.1f, 5));
+        }
+
+        godot::Input *input = godot::Input::get_singleton();
+        if (--state.frames_until_toggle <= 0) {
+            state.pressed = !state.pressed;
+            state.frames_until_toggle = std::uniform_int_distribution<int>(1, 40)(random_);
+            if (state.pressed) {
+                input->action_press(state.click_action);
+            } else {
+                input->action_release(state.click_action);
+                input->action_release(state.scroll_action);
+            }
+        } else if (state.pressed) {
+            input->action_press(state.scroll_action, 0.5f);
+        }
+    }
+
+    std::vector<std::string> get_growing_resources() {
+        JavaCallScope scope(&env_);
+        jobjectArray growing_resources =
+                Java_org_godotengine_plugin_gast_GastManager_nativeGetGrowingResources(
+                        &env_, callback_);
+        std::vector<std::string> resources;
+        for (jsize i = 0; i < env_.GetArrayLength(growing_resources); i++) {
+            auto resource = (jstring) env_.GetObjectArrayElement(growing_resources, i);
+            resources.push_back(env_.GetStringUTFChars(resource, nullptr));
+            env_.ReleaseStringUTFChars(resource, resources.back().c_str());
+        }
+        return resources;
+    }
+
+    jlong pick_handle() {
+        return handles_[std::uniform_int_distribution<size_t>(0, handles_.size() - 1)(random_)];
+    }
+
+    const char *pick_container_path() {
+        return kContainerPaths[std::uniform_int_distribution<int>(0, 1)(random_)];
+    }
+
+    Vector3 random_grid_position() {
+        int cell = std::uniform_int_distribution<int>(0, kGridColumns * kGridColumns - 1)(random_);
+        return Vector3((cell % kGridColumns) * kGridSpacing, (cell / kGridColumns) * kGridSpacing,
+                       0);
+    }
+
+    bool leak_released_nodes_;
+    std::mt19937 random_{42};
+    int64_t initial_live_node_count_;
+
+    JNIEnv env_;
+    GastLoader gast_loader_;
+    jobject callback_ = nullptr;
+    std::unique_ptr<godot::SceneTree> scene_tree_;
+    std::vector<RayCastState> ray_casts_;
+
+    // Pointers of the nodes held by the Kotlin side.
+    std::vector<jlong> handles_;
+    std::set<jlong> pending_requests_;
+    std::vector<jlong> ready_handles_;
+
+    std::map<std::string, int64_t> callback_counts_;
+    int64_t pick_count_ = 0;
+    int max_local_reference_leak_ = 0;
+};
+
+void test_steady_state_has_no_sustained_growth() {
+    SoakSession session(false);
+    session.warm_up(kSamplesPerHour / 6);
+    EXPECT_TRUE(session.run(kSimulatedHours * kSamplesPerHour));
+    EXPECT_EQ(0, session.get_local_reference_leak());
+    EXPECT_EQ(0, session.get_env().get_error_count());
+
+    // Make sure the simulation actually exercised the input paths.
+    EXPECT_TRUE(session.get_pick_count() > 0);
+    EXPECT_TRUE(session.get_callback_count("onGastNodeReady") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputAction") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputHover") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputPress") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputRelease") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputScroll") > 0);
+    EXPECT_TRUE(session.get_callback_count("onRenderInputGesture") > 0);
+}
+
+void test_leak_is_detected() {
+    // Guards against the soak passing vacuously.
+    SoakSession session(true);
+    session.warm_up(kSamplesPerHour / 6);
+    EXPECT_FALSE(session.run(kSamplesPerHour));
+}
+
+void test_many_monitored_actions_dont_overflow_local_references() {
+    SoakSession session(false);
+    std::vector<String> actions;
+    for (int i = 0; i < 2 * JNIEnv::kMaxLocalReferences; i++) {
+        actions.push_back(String("action_") + String::num_int64(i));
+    }
+
+    int local_reference_count = session.get_env().get_local_reference_count();
+    session.set_input_actions_to_monitor(actions);
+    EXPECT_TRUE(session.get_env().get_peak_local_reference_count() - local_reference_count < 8);
+    EXPECT_EQ(0, session.get_env().get_error_count());
+}
+
+}  // namespace
+
+int main() {
+    RUN_TEST(test_steady_state_has_no_sustained_growth);
+    RUN_TEST(test_leak_is_detected);
+    RUN_TEST(test_many_monitored_actions_dont_overflow_local_references);
+    return GAST_TEST_RESULT();
+}
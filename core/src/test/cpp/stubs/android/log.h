@@ -0,0 +1,49 @@
+#ifndef GAST_TEST_STUBS_ANDROID_LOG_H
+#define GAST_TEST_STUBS_ANDROID_LOG_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+/// Host stand-in for the NDK logging API, writing to stderr.
+enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT,
+};
+
+inline int __android_log_write(int priority, const char *tag, const char *text) {
+    return fprintf(stderr, "%d/%s: %s\n", priority, tag, text);
+}
+
+inline int __android_log_vprint(int priority, const char *tag, const char *format,
+                                va_list args) {
+    char message[1024];
+    vsnprintf(message, sizeof(message), format, args);
+    return __android_log_write(priority, tag, message);
+}
+
+inline int __android_log_print(int priority, const char *tag, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int result = __android_log_vprint(priority, tag, format, args);
+    va_end(args);
+    return result;
+}
+
+[[noreturn]] inline void __android_log_assert(const char *condition, const char *tag,
+                                              const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    __android_log_vprint(ANDROID_LOG_FATAL, tag, format, args);
+    va_end(args);
+    abort();
+}
+
+#endif // GAST_TEST_STUBS_ANDROID_LOG_H
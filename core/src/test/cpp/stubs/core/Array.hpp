@@ -0,0 +1,39 @@
+#ifndef GAST_TEST_STUBS_ARRAY_HPP
+#define GAST_TEST_STUBS_ARRAY_HPP
+
+#include <vector>
+
+#include "Variant.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::Array.
+class Array {
+public:
+    int size() const {
+        return static_cast<int>(values_.size());
+    }
+
+    bool empty() const {
+        return values_.empty();
+    }
+
+    void append(const Variant &value) {
+        values_.push_back(value);
+    }
+
+    Variant &operator[](int index) {
+        return values_[index];
+    }
+
+    const Variant &operator[](int index) const {
+        return values_[index];
+    }
+
+private:
+    std::vector<Variant> values_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_ARRAY_HPP
@@ -0,0 +1,99 @@
+#ifndef GAST_TEST_STUBS_BASIS_HPP
+#define GAST_TEST_STUBS_BASIS_HPP
+
+#include <cmath>
+
+#include "Vector3.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::Basis. The rows are stored in `elements`.
+struct Basis {
+    Vector3 elements[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)};
+
+    Basis() = default;
+
+    Basis(const Vector3 &row0, const Vector3 &row1, const Vector3 &row2) {
+        elements[0] = row0;
+        elements[1] = row1;
+        elements[2] = row2;
+    }
+
+    /// Rotation of `phi` radians around the given normalized axis.
+    Basis(const Vector3 &axis, real_t phi) {
+        real_t cosine = std::cos(phi);
+        real_t sine = std::sin(phi);
+        real_t t = 1 - cosine;
+        elements[0] = Vector3(t * axis.x * axis.x + cosine, t * axis.x * axis.y - sine * axis.z,
+                              t * axis.x * axis.z + sine * axis.y);
+        elements[1] = Vector3(t * axis.x * axis.y + sine * axis.z, t * axis.y * axis.y + cosine,
+                              t * axis.y * axis.z - sine * axis.x);
+        elements[2] = Vector3(t * axis.x * axis.z - sine * axis.y,
+                              t * axis.y * axis.z + sine * axis.x, t * axis.z * axis.z + cosine);
+    }
+
+    const Vector3 &operator[](int row) const {
+        return elements[row];
+    }
+
+    Vector3 &operator[](int row) {
+        return elements[row];
+    }
+
+    /// Length of the columns, negated for a basis with a negative determinant.
+    Vector3 get_scale() const {
+        real_t sign = elements[0].dot(elements[1].cross(elements[2])) < 0 ? -1 : 1;
+        return Vector3(Vector3(elements[0].x, elements[1].x, elements[2].x).length(),
+                       Vector3(elements[0].y, elements[1].y, elements[2].y).length(),
+                       Vector3(elements[0].z, elements[1].z, elements[2].z).length()) *
+               sign;
+    }
+
+    Basis operator*(const Basis &other) const {
+        Basis result;
+        for (int row = 0; row < 3; row++) {
+            for (int column = 0; column < 3; column++) {
+                result.elements[row][column] = elements[row][0] * other.elements[0][column] +
+                                               elements[row][1] * other.elements[1][column] +
+                                               elements[row][2] * other.elements[2][column];
+            }
+        }
+        return result;
+    }
+
+    Vector3 xform(const Vector3 &vector) const {
+        return Vector3(elements[0].dot(vector), elements[1].dot(vector), elements[2].dot(vector));
+    }
+
+    real_t determinant() const {
+        return elements[0].dot(elements[1].cross(elements[2]));
+    }
+
+    Basis inverse() const {
+        // Rows of the inverse are the columns of the adjugate.
+        Vector3 c0 = elements[1].cross(elements[2]);
+        Vector3 c1 = elements[2].cross(elements[0]);
+        Vector3 c2 = elements[0].cross(elements[1]);
+        real_t inverse_determinant = 1 / determinant();
+        return Basis(Vector3(c0.x, c1.x, c2.x) * inverse_determinant,
+                     Vector3(c0.y, c1.y, c2.y) * inverse_determinant,
+                     Vector3(c0.z, c1.z, c2.z) * inverse_determinant);
+    }
+
+    Basis scaled(const Vector3 &scale) const {
+        return Basis(elements[0] * scale.x, elements[1] * scale.y, elements[2] * scale.z);
+    }
+
+    bool operator==(const Basis &other) const {
+        return elements[0] == other.elements[0] && elements[1] == other.elements[1] &&
+               elements[2] == other.elements[2];
+    }
+
+    bool operator!=(const Basis &other) const {
+        return !(*this == other);
+    }
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_BASIS_HPP
@@ -0,0 +1,26 @@
+#ifndef GAST_TEST_STUBS_DEFS_HPP
+#define GAST_TEST_STUBS_DEFS_HPP
+
+#include <cstdio>
+
+/// Host stand-ins for the godot-cpp error macros.
+
+#define ERR_FAIL_NULL(param)                                                                \
+    do {                                                                                    \
+        if (!(param)) {                                                                     \
+            fprintf(stderr, "%s:%d: parameter \"" #param "\" is null.\n", __FILE__,         \
+                    __LINE__);                                                              \
+            return;                                                                         \
+        }                                                                                   \
+    } while (0)
+
+#define ERR_FAIL_NULL_V(param, ret)                                                         \
+    do {                                                                                    \
+        if (!(param)) {                                                                     \
+            fprintf(stderr, "%s:%d: parameter \"" #param "\" is null.\n", __FILE__,         \
+                    __LINE__);                                                              \
+            return ret;                                                                     \
+        }                                                                                   \
+    } while (0)
+
+#endif // GAST_TEST_STUBS_DEFS_HPP
@@ -0,0 +1,27 @@
+#ifndef GAST_TEST_STUBS_GODOT_HPP
+#define GAST_TEST_STUBS_GODOT_HPP
+
+#include <jni.h>
+
+#include "Array.hpp"
+#include "Defs.hpp"
+#include "String.hpp"
+#include "Variant.hpp"
+
+namespace godot {
+
+/// Host stand-in for the GDNative Android extension API.
+struct AndroidApi {
+    JNIEnv *(*godot_android_get_env)();
+};
+
+/// Environment returned by android_api->godot_android_get_env(), set by the tests.
+inline JNIEnv *android_env = nullptr;
+
+inline const AndroidApi host_android_api = {[]() { return android_env; }};
+
+inline const AndroidApi *android_api = &host_android_api;
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_GODOT_HPP
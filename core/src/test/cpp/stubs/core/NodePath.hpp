@@ -0,0 +1,35 @@
+#ifndef GAST_TEST_STUBS_NODE_PATH_HPP
+#define GAST_TEST_STUBS_NODE_PATH_HPP
+
+#include "String.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::NodePath, holding the path as a string.
+class NodePath {
+public:
+    NodePath() = default;
+
+    NodePath(const String &path) : path_(path) {}
+
+    NodePath(const char *path) : path_(path) {}
+
+    bool is_empty() const {
+        return path_.empty();
+    }
+
+    bool is_absolute() const {
+        return path_.length() > 0 && path_.c_str()[0] == '/';
+    }
+
+    operator String() const {
+        return path_;
+    }
+
+private:
+    String path_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_NODE_PATH_HPP
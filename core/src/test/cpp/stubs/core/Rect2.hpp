@@ -0,0 +1,29 @@
+#ifndef GAST_TEST_STUBS_RECT2_HPP
+#define GAST_TEST_STUBS_RECT2_HPP
+
+#include "Vector2.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::Rect2.
+struct Rect2 {
+    Vector2 position;
+    Vector2 size;
+
+    Rect2() = default;
+
+    Rect2(real_t x, real_t y, real_t width, real_t height)
+            : position(x, y), size(width, height) {}
+
+    bool operator==(const Rect2 &other) const {
+        return position == other.position && size == other.size;
+    }
+
+    bool operator!=(const Rect2 &other) const {
+        return !(*this == other);
+    }
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_RECT2_HPP
@@ -0,0 +1,83 @@
+#ifndef GAST_TEST_STUBS_REF_HPP
+#define GAST_TEST_STUBS_REF_HPP
+
+#include <gen/Reference.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Ref, holding a reference counted Reference.
+template<typename T>
+class Ref {
+public:
+    Ref() = default;
+
+    explicit Ref(T *reference) {
+        ref(reference);
+    }
+
+    Ref(const Ref &other) {
+        ref(other.reference_);
+    }
+
+    ~Ref() {
+        unref();
+    }
+
+    Ref &operator=(const Ref &other) {
+        if (this != &other) {
+            T *reference = other.reference_;
+            unref();
+            ref(reference);
+        }
+        return *this;
+    }
+
+    bool is_valid() const {
+        return reference_ != nullptr;
+    }
+
+    bool is_null() const {
+        return reference_ == nullptr;
+    }
+
+    void unref() {
+        if (reference_ && reference_->unreference()) {
+            delete reference_;
+        }
+        reference_ = nullptr;
+    }
+
+    T *operator->() const {
+        return reference_;
+    }
+
+    T *operator*() const {
+        return reference_;
+    }
+
+    T *ptr() const {
+        return reference_;
+    }
+
+    bool operator==(const Ref &other) const {
+        return reference_ == other.reference_;
+    }
+
+    bool operator!=(const Ref &other) const {
+        return reference_ != other.reference_;
+    }
+
+private:
+    void ref(T *reference) {
+        reference_ = reference;
+        if (reference_) {
+            reference_->reference();
+        }
+    }
+
+    T *reference_ = nullptr;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_REF_HPP
@@ -0,0 +1,114 @@
+#ifndef GAST_TEST_STUBS_STRING_HPP
+#define GAST_TEST_STUBS_STRING_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace godot {
+
+/// Host stand-in for godot::CharString, owning a utf8 copy of the characters.
+class CharString {
+public:
+    explicit CharString(std::string data) : data_(std::move(data)) {}
+
+    const char *get_data() const {
+        return data_.c_str();
+    }
+
+    int length() const {
+        return static_cast<int>(data_.length());
+    }
+
+private:
+    std::string data_;
+};
+
+/// Host stand-in for godot::String, backed by a shared std::string. Like Godot's copy on write
+/// strings, copies share the characters instead of allocating.
+class String {
+public:
+    String() = default;
+
+    String(const char *value) : value_(std::make_shared<const std::string>(value)) {}
+
+    String(std::string value) : value_(std::make_shared<const std::string>(std::move(value))) {}
+
+    static String num_int64(int64_t value) {
+        return String(std::to_string(value));
+    }
+
+    int length() const {
+        return static_cast<int>(get().length());
+    }
+
+    bool empty() const {
+        return get().empty();
+    }
+
+    /// Godot's String::hash, i.e: djb2 over the characters.
+    uint32_t hash() const {
+        uint32_t hash = 5381;
+        for (unsigned char c : get()) {
+            hash = ((hash << 5) + hash) + c;
+        }
+        return hash;
+    }
+
+    const char *c_str() const {
+        return get().c_str();
+    }
+
+    CharString utf8() const {
+        return CharString(get());
+    }
+
+    String replace(const String &what, const String &forwhat) const {
+        if (what.empty()) {
+            return *this;
+        }
+        std::string result = get();
+        for (size_t position = result.find(what.get()); position != std::string::npos;
+             position = result.find(what.get(), position + forwhat.length())) {
+            result.replace(position, what.length(), forwhat.get());
+        }
+        return String(std::move(result));
+    }
+
+    bool begins_with(const String &prefix) const {
+        return get().compare(0, prefix.length(), prefix.get()) == 0;
+    }
+
+    String operator+(const String &other) const {
+        return String(get() + other.get());
+    }
+
+    String &operator+=(const String &other) {
+        *this = *this + other;
+        return *this;
+    }
+
+    bool operator==(const String &other) const {
+        return get() == other.get();
+    }
+
+    bool operator!=(const String &other) const {
+        return get() != other.get();
+    }
+
+    bool operator<(const String &other) const {
+        return get() < other.get();
+    }
+
+private:
+    const std::string &get() const {
+        static const std::string empty_value;
+        return value_ ? *value_ : empty_value;
+    }
+
+    std::shared_ptr<const std::string> value_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_STRING_HPP
@@ -0,0 +1,46 @@
+#ifndef GAST_TEST_STUBS_TRANSFORM_HPP
+#define GAST_TEST_STUBS_TRANSFORM_HPP
+
+#include "Basis.hpp"
+#include "Vector3.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::Transform.
+struct Transform {
+    Basis basis;
+    Vector3 origin;
+
+    Transform() = default;
+
+    Transform(const Basis &basis, const Vector3 &origin) : basis(basis), origin(origin) {}
+
+    Transform operator*(const Transform &other) const {
+        return Transform(basis * other.basis, xform(other.origin));
+    }
+
+    Vector3 xform(const Vector3 &vector) const {
+        return basis.xform(vector) + origin;
+    }
+
+    Transform affine_inverse() const {
+        Basis inverse_basis = basis.inverse();
+        return Transform(inverse_basis, inverse_basis.xform(-origin));
+    }
+
+    Transform inverse() const {
+        return affine_inverse();
+    }
+
+    bool operator==(const Transform &other) const {
+        return basis == other.basis && origin == other.origin;
+    }
+
+    bool operator!=(const Transform &other) const {
+        return !(*this == other);
+    }
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_TRANSFORM_HPP
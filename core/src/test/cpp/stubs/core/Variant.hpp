@@ -0,0 +1,34 @@
+#ifndef GAST_TEST_STUBS_VARIANT_HPP
+#define GAST_TEST_STUBS_VARIANT_HPP
+
+#include <gen/Object.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Variant. Only holds objects.
+class Variant {
+public:
+    enum Type {
+        NIL,
+        OBJECT,
+    };
+
+    Variant() = default;
+
+    Variant(Object *object) : object_(object) {}
+
+    Type get_type() const {
+        return object_ ? OBJECT : NIL;
+    }
+
+    operator Object *() const {
+        return object_;
+    }
+
+private:
+    Object *object_ = nullptr;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_VARIANT_HPP
@@ -0,0 +1,83 @@
+#ifndef GAST_TEST_STUBS_VECTOR2_HPP
+#define GAST_TEST_STUBS_VECTOR2_HPP
+
+#include <cmath>
+
+namespace godot {
+
+typedef float real_t;
+
+/// Host stand-in for godot::Vector2.
+struct Vector2 {
+    real_t x = 0;
+    real_t y = 0;
+
+    Vector2() = default;
+
+    Vector2(real_t x, real_t y) : x(x), y(y) {}
+
+    Vector2 operator+(const Vector2 &other) const {
+        return Vector2(x + other.x, y + other.y);
+    }
+
+    Vector2 operator-(const Vector2 &other) const {
+        return Vector2(x - other.x, y - other.y);
+    }
+
+    Vector2 operator-() const {
+        return Vector2(-x, -y);
+    }
+
+    Vector2 operator*(real_t scalar) const {
+        return Vector2(x * scalar, y * scalar);
+    }
+
+    Vector2 operator/(real_t scalar) const {
+        return Vector2(x / scalar, y / scalar);
+    }
+
+    Vector2 &operator+=(const Vector2 &other) {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
+
+    Vector2 &operator-=(const Vector2 &other) {
+        x -= other.x;
+        y -= other.y;
+        return *this;
+    }
+
+    bool operator==(const Vector2 &other) const {
+        return x == other.x && y == other.y;
+    }
+
+    bool operator!=(const Vector2 &other) const {
+        return !(*this == other);
+    }
+
+    real_t length_squared() const {
+        return x * x + y * y;
+    }
+
+    real_t length() const {
+        return std::sqrt(length_squared());
+    }
+
+    real_t distance_to(const Vector2 &other) const {
+        return (*this - other).length();
+    }
+
+    real_t dot(const Vector2 &other) const {
+        return x * other.x + y * other.y;
+    }
+
+    Vector2 normalized() const {
+        real_t l = length();
+        return l == 0 ? Vector2() : *this / l;
+    }
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_VECTOR2_HPP
@@ -0,0 +1,96 @@
+#ifndef GAST_TEST_STUBS_VECTOR3_HPP
+#define GAST_TEST_STUBS_VECTOR3_HPP
+
+#include <cmath>
+
+#include "Vector2.hpp"
+
+namespace godot {
+
+/// Host stand-in for godot::Vector3.
+struct Vector3 {
+    real_t x = 0;
+    real_t y = 0;
+    real_t z = 0;
+
+    Vector3() = default;
+
+    Vector3(real_t x, real_t y, real_t z) : x(x), y(y), z(z) {}
+
+    real_t operator[](int axis) const {
+        return axis == 0 ? x : (axis == 1 ? y : z);
+    }
+
+    real_t &operator[](int axis) {
+        return axis == 0 ? x : (axis == 1 ? y : z);
+    }
+
+    Vector3 operator+(const Vector3 &other) const {
+        return Vector3(x + other.x, y + other.y, z + other.z);
+    }
+
+    Vector3 operator-(const Vector3 &other) const {
+        return Vector3(x - other.x, y - other.y, z - other.z);
+    }
+
+    Vector3 operator-() const {
+        return Vector3(-x, -y, -z);
+    }
+
+    Vector3 operator*(real_t scalar) const {
+        return Vector3(x * scalar, y * scalar, z * scalar);
+    }
+
+    Vector3 operator/(real_t scalar) const {
+        return Vector3(x / scalar, y / scalar, z / scalar);
+    }
+
+    Vector3 &operator+=(const Vector3 &other) {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    bool operator==(const Vector3 &other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    bool operator!=(const Vector3 &other) const {
+        return !(*this == other);
+    }
+
+    real_t dot(const Vector3 &other) const {
+        return x * other.x + y * other.y + z * other.z;
+    }
+
+    Vector3 cross(const Vector3 &other) const {
+        return Vector3(y * other.z - z * other.y, z * other.x - x * other.z,
+                       x * other.y - y * other.x);
+    }
+
+    real_t length_squared() const {
+        return dot(*this);
+    }
+
+    real_t length() const {
+        return std::sqrt(length_squared());
+    }
+
+    real_t distance_to(const Vector3 &other) const {
+        return (*this - other).length();
+    }
+
+    real_t distance_squared_to(const Vector3 &other) const {
+        return (*this - other).length_squared();
+    }
+
+    Vector3 normalized() const {
+        real_t l = length();
+        return l == 0 ? Vector3() : *this / l;
+    }
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_VECTOR3_HPP
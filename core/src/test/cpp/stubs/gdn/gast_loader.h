@@ -0,0 +1,59 @@
+#ifndef GAST_LOADER_H
+#define GAST_LOADER_H
+
+#include <core/String.hpp>
+#include <cstdint>
+
+namespace gast {
+
+using namespace godot;
+
+/// Host stand-in for the GastLoader, counting the signals emitted to GDScript.
+class GastLoader {
+public:
+    int64_t gast_node_ready_count = 0;
+    int64_t texture_budget_decision_count = 0;
+    int64_t hover_event_count = 0;
+    int64_t press_event_count = 0;
+    int64_t release_event_count = 0;
+    int64_t scroll_event_count = 0;
+    int64_t gesture_event_count = 0;
+
+    void emitGastNodeReady(int64_t request_id, const String &node_path) {
+        gast_node_ready_count++;
+    }
+
+    void emitTextureBudgetDecision(const String &node_path, int action, int width, int height) {
+        texture_budget_decision_count++;
+    }
+
+    void emitHoverEvent(const String &node_path, const String &event_origin_id, float x_percent,
+                        float y_percent) {
+        hover_event_count++;
+    }
+
+    void emitPressEvent(const String &node_path, const String &event_origin_id, float x_percent,
+                        float y_percent) {
+        press_event_count++;
+    }
+
+    void emitReleaseEvent(const String &node_path, const String &event_origin_id,
+                          float x_percent, float y_percent) {
+        release_event_count++;
+    }
+
+    void emitScrollEvent(const String &node_path, const String &event_origin_id, float x_percent,
+                         float y_percent, float horizontal_delta, float vertical_delta) {
+        scroll_event_count++;
+    }
+
+    void emitGestureEvent(const String &node_path, const String &event_origin_id,
+                          int gesture_type, float x_percent, float y_percent, float x_velocity,
+                          float y_velocity) {
+        gesture_event_count++;
+    }
+};
+
+}  // namespace gast
+
+#endif // GAST_LOADER_H
@@ -0,0 +1,325 @@
+#include "gdn/gast_node.h"
+
+#include <gen/Input.hpp>
+
+#include "gast_manager.h"
+
+namespace gast {
+
+namespace {
+const Vector2 kInvalidCoordinate = Vector2(-1, -1);
+const char *kCapturedGastRayCastGroupName = "captured_gast_ray_casts";
+}  // namespace
+
+GastNode::~GastNode() {
+    // Leave the tree while the _exit_tree() callback can still be dispatched to this node.
+    if (get_parent()) {
+        get_parent()->remove_child(this);
+    }
+
+    live_instance_count--;
+
+    if (shared_texture_source) {
+        std::vector<GastNode *> &source_nodes = shared_texture_source->shared_texture_nodes;
+        source_nodes.erase(std::remove(source_nodes.begin(), source_nodes.end(), this),
+                           source_nodes.end());
+        shared_texture_source = nullptr;
+    }
+
+    std::vector<GastNode *> released_shared_texture_nodes;
+    released_shared_texture_nodes.swap(shared_texture_nodes);
+    for (GastNode *shared_texture_node : released_shared_texture_nodes) {
+        shared_texture_node->shared_texture_source = nullptr;
+    }
+
+    GastManager::on_gast_node_destroyed(this, released_shared_texture_nodes);
+}
+
+void GastNode::_enter_tree() {
+    setup_material();
+    GastManager::get_singleton_instance()->get_node_registry().add(this);
+}
+
+void GastNode::_exit_tree() {
+    release_captured_ray_casts();
+    GastManager::get_singleton_instance()->get_node_registry().remove(this);
+}
+
+void GastNode::_notification(int64_t what) {
+    if (!is_inside_tree()) {
+        return;
+    }
+
+    switch (what) {
+        case NOTIFICATION_VISIBILITY_CHANGED:
+            GastManager::get_singleton_instance()->get_node_registry().update_visibility(
+                    *this, is_visible_in_tree());
+            break;
+        case NOTIFICATION_TRANSFORM_CHANGED:
+            GastManager::get_singleton_instance()->get_node_registry().update_global_transform(
+                    *this, get_global_transform());
+            break;
+        case NOTIFICATION_PATH_CHANGED:
+            update_registry_path_hash();
+            break;
+    }
+}
+
+void GastNode::setup_material() {
+    if (external_texture_ref.is_valid()) {
+        return;
+    }
+
+    external_texture_ref = Ref<ExternalTexture>(ExternalTexture::_new());
+    external_texture_id = external_texture_ref->get_external_texture_id();
+}
+
+void GastNode::set_size(Vector2 size) {
+    this->size = size;
+    if (is_inside_tree()) {
+        GastManager::get_singleton_instance()->get_node_registry().update_size(*this, size);
+    }
+}
+
+int GastNode::get_external_texture_id(int surface_index) const {
+    if (shared_texture_source) {
+        return shared_texture_source->get_external_texture_id(surface_index);
+    }
+    if (atlas_texture_ref.is_valid()) {
+        return atlas_texture_ref->get_external_texture_id();
+    }
+    return external_texture_id;
+}
+
+void GastNode::set_registry_flag(uint32_t flag, bool enabled) {
+    uint32_t flags = enabled ? registry_flags | flag : registry_flags & ~flag;
+    if (flags == registry_flags) {
+        return;
+    }
+
+    registry_flags = flags;
+    if (is_inside_tree()) {
+        GastManager::get_singleton_instance()->get_node_registry().update_flags(*this, flags);
+    }
+}
+
+void GastNode::bind_to_texture_atlas(const Ref<ExternalTexture> &atlas_texture, Rect2 uv_rect) {
+    this->atlas_texture_ref = atlas_texture;
+    this->uv_rect = uv_rect;
+}
+
+void GastNode::unbind_from_texture_atlas() {
+    atlas_texture_ref.unref();
+    uv_rect = kDefaultUvRect;
+}
+
+bool GastNode::bind_to_shared_texture(GastNode *source_node) {
+    if (source_node && source_node->shared_texture_source) {
+        source_node = source_node->shared_texture_source;
+    }
+
+    if (source_node == shared_texture_source) {
+        return true;
+    }
+
+    if (!source_node) {
+        unbind_from_shared_texture();
+        return true;
+    }
+
+    if (source_node == this || !shared_texture_nodes.empty()) {
+        return false;
+    }
+
+    unbind_from_shared_texture();
+    shared_texture_source = source_node;
+    source_node->shared_texture_nodes.push_back(this);
+    return true;
+}
+
+void GastNode::unbind_from_shared_texture() {
+    if (!shared_texture_source) {
+        return;
+    }
+
+    std::vector<GastNode *> &source_nodes = shared_texture_source->shared_texture_nodes;
+    source_nodes.erase(std::remove(source_nodes.begin(), source_nodes.end(), this),
+                       source_nodes.end());
+    shared_texture_source = nullptr;
+}
+
+void GastNode::release_shared_texture_nodes() {
+    std::vector<GastNode *> nodes = shared_texture_nodes;
+    for (GastNode *shared_texture_node : nodes) {
+        shared_texture_node->unbind_from_shared_texture();
+    }
+}
+
+bool GastNode::set_static_snapshot(const uint8_t *rgba_data, int width, int height) {
+    if (!rgba_data || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    has_snapshot = true;
+    return true;
+}
+
+void GastNode::update_registry_path_hash() {
+    if (registry_index == kInvalidRegistryIndex) {
+        return;
+    }
+    GastManager::get_singleton_instance()->get_node_registry().update_path_hash(
+            *this, String(get_path()).hash());
+}
+
+RayCastInputActions GastNode::get_input_actions_from_node_path(const String &node_path) {
+    String action_prefix = node_path.replace("/", "_");
+    RayCastInputActions input_actions;
+    input_actions.click = action_prefix + "_click";
+    input_actions.horizontal_left_scroll = action_prefix + "_left_scroll";
+    input_actions.horizontal_right_scroll = action_prefix + "_right_scroll";
+    input_actions.vertical_up_scroll = action_prefix + "_up_scroll";
+    input_actions.vertical_down_scroll = action_prefix + "_down_scroll";
+    return input_actions;
+}
+
+bool GastNode::process_ray_cast_collision(RayCast &ray_cast, bool collides_with_node,
+                                          bool ray_cast_colliding, Vector3 collision_point,
+                                          Vector3 collision_normal,
+                                          int64_t capture_timestamp_nanos) {
+    int64_t ray_cast_id = ray_cast.get_instance_id();
+    RayCastCollision *collision = colliding_ray_casts.find(ray_cast_id);
+
+    // Unlike the real node, the press in progress is kept at its last collision point rather
+    // than projected on the node's plane.
+    if (!collides_with_node && !ray_cast_colliding && collision &&
+        collision->press_in_progress) {
+        collides_with_node = true;
+        collision_point = collision->collision_point;
+        collision_normal = collision->collision_normal;
+    }
+
+    if (collides_with_node) {
+        String ray_cast_path = collision ? collision->ray_cast_path : String(ray_cast.get_path());
+        RayCastInputActions input_actions = collision
+                                            ? collision->input_actions
+                                            : get_input_actions_from_node_path(ray_cast_path);
+
+        Vector2 relative_collision_point = get_relative_collision_point(collision_point);
+        bool press_in_progress = handle_ray_cast_input(ray_cast_path, input_actions,
+                                                       relative_collision_point,
+                                                       capture_timestamp_nanos);
+
+        RayCastCollision &collision_entry = colliding_ray_casts.get_or_add(ray_cast_id,
+                                                                           ray_cast_path,
+                                                                           input_actions);
+        collision_entry.press_in_progress = press_in_progress;
+        collision_entry.collision_normal = collision_normal;
+        collision_entry.collision_point = collision_point;
+
+        ray_cast.add_to_group(kCapturedGastRayCastGroupName);
+        return true;
+    }
+
+    if (collision) {
+        GastNode *input_target = get_input_target();
+        String node_path = input_target->get_path();
+        String ray_cast_path = collision->ray_cast_path;
+        Vector2 last_coordinate = get_relative_collision_point(collision->collision_point);
+        bool press_in_progress = collision->press_in_progress;
+
+        colliding_ray_casts.remove(ray_cast_id);
+
+        if (press_in_progress) {
+            GastManager::get_singleton_instance()->on_render_input_release(
+                    input_target, node_path, ray_cast_path, last_coordinate.x, last_coordinate.y,
+                    capture_timestamp_nanos);
+        } else {
+            GastManager::get_singleton_instance()->on_render_input_hover(
+                    input_target, node_path, ray_cast_path, last_coordinate.x, last_coordinate.y,
+                    capture_timestamp_nanos);
+        }
+
+        ray_cast.remove_from_group(kCapturedGastRayCastGroupName);
+    }
+    return false;
+}
+
+void GastNode::release_captured_ray_casts() {
+    GastNode *input_target = get_input_target();
+    String node_path = input_target->get_path();
+    int64_t capture_timestamp_nanos = get_monotonic_time_nanos();
+    for (const RayCastCollision &entry : colliding_ray_casts) {
+        if (entry.press_in_progress) {
+            Vector2 last_coordinate = get_relative_collision_point(entry.collision_point);
+            GastManager::get_singleton_instance()->on_render_input_release(
+                    input_target, node_path, entry.ray_cast_path, last_coordinate.x,
+                    last_coordinate.y, capture_timestamp_nanos);
+        }
+
+        Node *node = get_node_or_null(NodePath(entry.ray_cast_path));
+        if (node) {
+            node->remove_from_group(kCapturedGastRayCastGroupName);
+        }
+    }
+    colliding_ray_casts.clear();
+    GastManager::get_singleton_instance()->on_ray_cast_captures_released(this);
+}
+
+bool GastNode::handle_ray_cast_input(const String &ray_cast_path,
+                                     const RayCastInputActions &input_actions,
+                                     Vector2 relative_collision_point,
+                                     int64_t capture_timestamp_nanos) {
+    GastManager *gast_manager = GastManager::get_singleton_instance();
+    GastNode *input_target = get_input_target();
+    gast_manager->get_texture_memory_budget().mark_used(input_target, capture_timestamp_nanos);
+    Input *input = Input::get_singleton();
+    String node_path = input_target->get_path();
+
+    float x_percent = relative_collision_point.x;
+    float y_percent = relative_collision_point.y;
+
+    const bool press_in_progress = input->is_action_pressed(input_actions.click);
+    if (input->is_action_just_pressed(input_actions.click)) {
+        gast_manager->on_render_input_press(input_target, node_path, ray_cast_path, x_percent,
+                                            y_percent, capture_timestamp_nanos);
+    } else if (input->is_action_just_released(input_actions.click)) {
+        gast_manager->on_render_input_release(input_target, node_path, ray_cast_path, x_percent,
+                                              y_percent, capture_timestamp_nanos);
+    } else {
+        gast_manager->on_render_input_hover(input_target, node_path, ray_cast_path, x_percent,
+                                            y_percent, capture_timestamp_nanos);
+    }
+
+    float horizontal_scroll_delta =
+            input->get_action_strength(input_actions.horizontal_right_scroll) -
+            input->get_action_strength(input_actions.horizontal_left_scroll);
+    float vertical_scroll_delta = input->get_action_strength(input_actions.vertical_up_scroll) -
+                                  input->get_action_strength(input_actions.vertical_down_scroll);
+    if (horizontal_scroll_delta != 0 || vertical_scroll_delta != 0) {
+        gast_manager->on_render_input_scroll_action(
+                input_target, node_path, ray_cast_path, x_percent, y_percent,
+                horizontal_scroll_delta, vertical_scroll_delta, capture_timestamp_nanos);
+    } else {
+        gast_manager->on_render_input_scroll_released(node_path, ray_cast_path);
+    }
+
+    return press_in_progress;
+}
+
+Vector2 GastNode::get_relative_collision_point(Vector3 absolute_collision_point) {
+    Vector2 node_size = get_size();
+    if (node_size.x <= 0 || node_size.y <= 0) {
+        return kInvalidCoordinate;
+    }
+
+    Vector3 local_point = to_local(absolute_collision_point);
+    float x_percent = (local_point.x + node_size.x / 2) / node_size.x;
+    float y_percent = 1 - (local_point.y + node_size.y / 2) / node_size.y;
+
+    Rect2 sampled_uv_rect = get_sampled_uv_rect();
+    return Vector2(sampled_uv_rect.position.x + x_percent * sampled_uv_rect.size.x,
+                   sampled_uv_rect.position.y + y_percent * sampled_uv_rect.size.y);
+}
+
+}  // namespace gast
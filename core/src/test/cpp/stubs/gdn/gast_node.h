@@ -0,0 +1,216 @@
+#ifndef GAST_NODE_H
+#define GAST_NODE_H
+
+#include <algorithm>
+#include <core/NodePath.hpp>
+#include <core/Rect2.hpp>
+#include <core/Ref.hpp>
+#include <core/String.hpp>
+#include <core/Transform.hpp>
+#include <core/Vector2.hpp>
+#include <core/Vector3.hpp>
+#include <cstdint>
+#include <gen/ExternalTexture.hpp>
+#include <gen/RayCast.hpp>
+#include <gen/Spatial.hpp>
+#include <vector>
+
+#include "scene/gast_node_registry.h"
+#include "scene/ray_cast_collisions.h"
+#include "scene/ray_cast_filter.h"
+
+namespace gast {
+
+namespace {
+using namespace godot;
+constexpr int kInvalidTexId = -1;
+constexpr int kInvalidSurfaceIndex = -1;
+const bool kDefaultCollidable = true;
+const bool kDefaultCurveValue = false;
+const bool kDefaultGazeTracking = false;
+const bool kDefaultRenderOnTop = false;
+const float kDefaultGradientHeightRatio = 0.0f;
+const Rect2 kDefaultUvRect = Rect2(0, 0, 1, 1);
+}  // namespace
+
+/// Host stand-in for the GastNode.
+///
+/// The state read by the registry is exposed as plain fields, so the registry tests can set it
+/// directly. Outside of the scene tree the node doesn't push its updates to the registry: the
+/// tests do it explicitly through the GastNodeRegistry::update_* methods. Inside the scene tree
+/// it registers itself and forwards its updates like the real node, and runs the same ray cast
+/// input logic, so the GastManager and the JNI entry points can be driven on the host.
+///
+/// There's no mesh, shader or physics body: the material is reduced to the external texture,
+/// and the ray casts are only resolved by the manager's BVH picking.
+class GastNode : public Spatial {
+public:
+    Vector2 size = Vector2(2, 2);
+    uint32_t registry_flags = kGastNodeFlagCollidable;
+    uint32_t collision_layer = 1;
+    int external_texture_id = 0;
+    // Path reported outside of the scene tree, if set.
+    String path;
+
+    GastNode() {
+        live_instance_count++;
+    }
+
+    ~GastNode() override;
+
+    static GastNode *_new() {
+        return new GastNode();
+    }
+
+    static int64_t get_live_instance_count() {
+        return live_instance_count;
+    }
+
+    void _enter_tree() override;
+
+    void _exit_tree() override;
+
+    void _notification(int64_t what) override;
+
+    void setup_material();
+
+    NodePath get_path() const {
+        return path.empty() ? Node::get_path() : NodePath(path);
+    }
+
+    Vector2 get_size() const {
+        return size;
+    }
+
+    void set_size(Vector2 size);
+
+    uint32_t get_registry_flags() const {
+        return registry_flags;
+    }
+
+    uint32_t get_collision_layer() const {
+        return collision_layer;
+    }
+
+    int get_external_texture_id(int surface_index = kInvalidSurfaceIndex) const;
+
+    void set_collidable(bool collidable) {
+        set_registry_flag(kGastNodeFlagCollidable, collidable);
+    }
+
+    bool is_collidable() const {
+        return registry_flags & kGastNodeFlagCollidable;
+    }
+
+    void set_curved(bool curved) {
+        set_registry_flag(kGastNodeFlagCurved, curved);
+    }
+
+    bool is_curved() const {
+        return registry_flags & kGastNodeFlagCurved;
+    }
+
+    void set_gaze_tracking(bool gaze_tracking) {
+        set_registry_flag(kGastNodeFlagGazeTracking, gaze_tracking);
+    }
+
+    bool is_gaze_tracking() const {
+        return registry_flags & kGastNodeFlagGazeTracking;
+    }
+
+    void set_render_on_top(bool enable) {
+        set_registry_flag(kGastNodeFlagRenderOnTop, enable);
+    }
+
+    bool is_render_on_top() const {
+        return registry_flags & kGastNodeFlagRenderOnTop;
+    }
+
+    float get_gradient_height_ratio() const {
+        return gradient_height_ratio;
+    }
+
+    void set_gradient_height_ratio(float ratio) {
+        gradient_height_ratio = std::min(1.0f, std::max(0.0f, ratio));
+    }
+
+    void bind_to_texture_atlas(const Ref<ExternalTexture> &atlas_texture, Rect2 uv_rect);
+
+    void unbind_from_texture_atlas();
+
+    bool is_bound_to_texture_atlas() const {
+        return atlas_texture_ref.is_valid();
+    }
+
+    bool bind_to_shared_texture(GastNode *source_node);
+
+    void unbind_from_shared_texture();
+
+    bool is_bound_to_shared_texture() const {
+        return shared_texture_source != nullptr;
+    }
+
+    void release_shared_texture_nodes();
+
+    void on_shared_texture_source_destroyed() {}
+
+    bool set_static_snapshot(const uint8_t *rgba_data, int width, int height);
+
+    void clear_static_snapshot() {
+        has_snapshot = false;
+    }
+
+    bool has_static_snapshot() const {
+        return has_snapshot;
+    }
+
+    bool process_ray_cast_collision(RayCast &ray_cast, bool collides_with_node,
+                                    bool ray_cast_colliding, Vector3 collision_point,
+                                    Vector3 collision_normal, int64_t capture_timestamp_nanos);
+
+    /// No-op: there's no physics engine on the host, so the ray casts never collide.
+    void sample_ray_casts(RayCastFilter &ray_cast_filter, int64_t capture_timestamp_nanos) {}
+
+    void release_captured_ray_casts();
+
+    void update_registry_path_hash();
+
+    Vector2 get_relative_collision_point(Vector3 absolute_collision_point);
+
+private:
+    friend class GastNodeRegistry;
+
+    static inline int64_t live_instance_count = 0;
+
+    GastNode *get_input_target() {
+        return shared_texture_source ? shared_texture_source : this;
+    }
+
+    Rect2 get_sampled_uv_rect() const {
+        return shared_texture_source ? shared_texture_source->uv_rect : uv_rect;
+    }
+
+    // Same mapping as the real node: the '/' characters of the path are replaced with '_'.
+    static RayCastInputActions get_input_actions_from_node_path(const String &node_path);
+
+    bool handle_ray_cast_input(const String &ray_cast_path,
+                               const RayCastInputActions &input_actions,
+                               Vector2 relative_collision_point, int64_t capture_timestamp_nanos);
+
+    void set_registry_flag(uint32_t flag, bool enabled);
+
+    float gradient_height_ratio = 0;
+    bool has_snapshot = false;
+    Ref<ExternalTexture> external_texture_ref;
+    Ref<ExternalTexture> atlas_texture_ref;
+    Rect2 uv_rect = kDefaultUvRect;
+    GastNode *shared_texture_source = nullptr;
+    std::vector<GastNode *> shared_texture_nodes;
+    RayCastCollisions colliding_ray_casts;
+
+    int registry_index = kInvalidRegistryIndex;
+};
+
+}  // namespace gast
+
+#endif // GAST_NODE_H
@@ -0,0 +1,13 @@
+#ifndef GAST_TEST_STUBS_CAMERA_HPP
+#define GAST_TEST_STUBS_CAMERA_HPP
+
+#include <gen/Spatial.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Camera.
+class Camera : public Spatial {};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_CAMERA_HPP
@@ -0,0 +1,50 @@
+#ifndef GAST_TEST_STUBS_ENGINE_HPP
+#define GAST_TEST_STUBS_ENGINE_HPP
+
+#include <cstdint>
+#include <gen/MainLoop.hpp>
+#include <gen/Object.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Engine. The tests install the main loop, and advance the frames.
+class Engine : public Object {
+public:
+    static Engine *get_singleton() {
+        static Engine engine;
+        return &engine;
+    }
+
+    MainLoop *get_main_loop() const {
+        return main_loop_;
+    }
+
+    int64_t get_idle_frames() const {
+        return idle_frames_;
+    }
+
+    int64_t get_physics_frames() const {
+        return physics_frames_;
+    }
+
+    // Host only
+
+    void set_main_loop(MainLoop *main_loop) {
+        main_loop_ = main_loop;
+    }
+
+    /// Starts a new frame, with one physics step.
+    void iterate() {
+        idle_frames_++;
+        physics_frames_++;
+    }
+
+private:
+    MainLoop *main_loop_ = nullptr;
+    int64_t idle_frames_ = 0;
+    int64_t physics_frames_ = 0;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_ENGINE_HPP
@@ -0,0 +1,40 @@
+#ifndef GAST_TEST_STUBS_EXTERNAL_TEXTURE_HPP
+#define GAST_TEST_STUBS_EXTERNAL_TEXTURE_HPP
+
+#include <core/Vector2.hpp>
+#include <gen/Reference.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::ExternalTexture. The texture ids are unique for the process
+/// lifetime.
+class ExternalTexture : public Reference {
+public:
+    static ExternalTexture *_new() {
+        return new ExternalTexture();
+    }
+
+    int get_external_texture_id() const {
+        return external_texture_id_;
+    }
+
+    Vector2 get_size() const {
+        return size_;
+    }
+
+    void set_size(const Vector2 &size) {
+        size_ = size;
+    }
+
+private:
+    ExternalTexture() : external_texture_id_(next_external_texture_id_++) {}
+
+    static inline int next_external_texture_id_ = 1;
+
+    int external_texture_id_;
+    Vector2 size_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_EXTERNAL_TEXTURE_HPP
@@ -0,0 +1,75 @@
+#ifndef GAST_TEST_STUBS_INPUT_HPP
+#define GAST_TEST_STUBS_INPUT_HPP
+
+#include <core/String.hpp>
+#include <core/Vector2.hpp>
+#include <cstdint>
+#include <gen/Engine.hpp>
+#include <gen/Object.hpp>
+#include <map>
+
+namespace godot {
+
+/// Host stand-in for godot::Input. The actions are pressed and released by the tests, and are
+/// "just" pressed / released during the frame (see Engine::iterate()) they changed in.
+class Input : public Object {
+public:
+    static Input *get_singleton() {
+        static Input input;
+        return &input;
+    }
+
+    void action_press(const String &action, real_t strength = 1) {
+        ActionState &state = actions_[action];
+        if (!state.pressed) {
+            state.pressed = true;
+            state.frame = Engine::get_singleton()->get_idle_frames();
+        }
+        state.strength = strength;
+    }
+
+    void action_release(const String &action) {
+        ActionState &state = actions_[action];
+        if (state.pressed) {
+            state.pressed = false;
+            state.frame = Engine::get_singleton()->get_idle_frames();
+        }
+        state.strength = 0;
+    }
+
+    bool is_action_pressed(const String &action) const {
+        auto it = actions_.find(action);
+        return it != actions_.end() && it->second.pressed;
+    }
+
+    bool is_action_just_pressed(const String &action) const {
+        auto it = actions_.find(action);
+        return it != actions_.end() && it->second.pressed &&
+               it->second.frame == Engine::get_singleton()->get_idle_frames();
+    }
+
+    bool is_action_just_released(const String &action) const {
+        auto it = actions_.find(action);
+        return it != actions_.end() && !it->second.pressed &&
+               it->second.frame == Engine::get_singleton()->get_idle_frames();
+    }
+
+    real_t get_action_strength(const String &action) const {
+        auto it = actions_.find(action);
+        return it == actions_.end() ? 0 : it->second.strength;
+    }
+
+private:
+    struct ActionState {
+        bool pressed = false;
+        // Frame of the last press or release.
+        int64_t frame = -1;
+        real_t strength = 0;
+    };
+
+    std::map<String, ActionState> actions_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_INPUT_HPP
@@ -0,0 +1,13 @@
+#ifndef GAST_TEST_STUBS_INPUT_EVENT_ACTION_HPP
+#define GAST_TEST_STUBS_INPUT_EVENT_ACTION_HPP
+
+#include <gen/Reference.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::InputEventAction. The actions are driven through Input instead.
+class InputEventAction : public Reference {};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_INPUT_EVENT_ACTION_HPP
@@ -0,0 +1,13 @@
+#ifndef GAST_TEST_STUBS_MAIN_LOOP_HPP
+#define GAST_TEST_STUBS_MAIN_LOOP_HPP
+
+#include <gen/Object.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::MainLoop.
+class MainLoop : public Object {};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_MAIN_LOOP_HPP
@@ -0,0 +1,221 @@
+#include <gen/Node.hpp>
+
+#include <algorithm>
+#include <gen/Engine.hpp>
+#include <gen/SceneTree.hpp>
+#include <string>
+
+namespace godot {
+
+namespace {
+SceneTree *get_scene_tree() {
+    return Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+}
+}  // namespace
+
+Node::~Node() {
+    if (parent_) {
+        parent_->remove_child(this);
+    }
+
+    std::vector<Node *> children;
+    children.swap(children_);
+    for (Node *child : children) {
+        if (child->tree_) {
+            child->propagate_exit_tree();
+        }
+        child->parent_ = nullptr;
+        delete child;
+    }
+
+    if (SceneTree *scene_tree = get_scene_tree()) {
+        scene_tree->cancel_delete(this);
+    }
+}
+
+void Node::set_name(const String &name) {
+    name_ = name;
+    if (parent_) {
+        parent_->validate_child_name(this);
+    }
+    if (tree_) {
+        propagate_notification(NOTIFICATION_PATH_CHANGED);
+    }
+}
+
+NodePath Node::get_path() const {
+    if (!tree_) {
+        return NodePath();
+    }
+
+    String path;
+    for (const Node *node = this; node; node = node->parent_) {
+        path = String("/") + node->name_ + path;
+    }
+    return NodePath(path);
+}
+
+Array Node::get_children() const {
+    Array children;
+    for (Node *child : children_) {
+        children.append(child);
+    }
+    return children;
+}
+
+void Node::add_child(Node *node) {
+    if (!node || node->parent_) {
+        return;
+    }
+
+    validate_child_name(node);
+    node->parent_ = this;
+    children_.push_back(node);
+    if (tree_) {
+        node->propagate_enter_tree(tree_);
+    }
+}
+
+void Node::remove_child(Node *node) {
+    auto it = std::find(children_.begin(), children_.end(), node);
+    if (it == children_.end()) {
+        return;
+    }
+
+    if (node->tree_) {
+        node->propagate_exit_tree();
+    }
+    children_.erase(std::find(children_.begin(), children_.end(), node));
+    node->parent_ = nullptr;
+}
+
+Node *Node::get_node_or_null(const NodePath &path) const {
+    std::string path_string = String(path).c_str();
+    const Node *node = this;
+    size_t start = 0;
+    if (path.is_absolute()) {
+        while (node->parent_) {
+            node = node->parent_;
+        }
+        if (!node->tree_) {
+            return nullptr;
+        }
+
+        // The first name is the root's.
+        size_t end = path_string.find('/', 1);
+        if (path_string.substr(1, end == std::string::npos ? end : end - 1) !=
+            node->name_.c_str()) {
+            return nullptr;
+        }
+        start = end == std::string::npos ? path_string.size() : end + 1;
+    }
+
+    while (node && start < path_string.size()) {
+        size_t end = path_string.find('/', start);
+        std::string name = path_string.substr(start, end == std::string::npos ? end : end - start);
+        start = end == std::string::npos ? path_string.size() : end + 1;
+
+        if (name == "..") {
+            node = node->parent_;
+            continue;
+        }
+        if (name.empty() || name == ".") {
+            continue;
+        }
+
+        const Node *parent = node;
+        node = nullptr;
+        for (Node *child : parent->children_) {
+            if (name == child->name_.c_str()) {
+                node = child;
+                break;
+            }
+        }
+    }
+    return const_cast<Node *>(node);
+}
+
+Node *Node::find_node(const String &mask, bool recursive, bool owned) const {
+    for (Node *child : children_) {
+        if (child->name_ == mask && (!owned || child->owner_)) {
+            return child;
+        }
+    }
+
+    if (recursive) {
+        for (Node *child : children_) {
+            Node *node = child->find_node(mask, true, owned);
+            if (node) {
+                return node;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void Node::add_to_group(const String &group) {
+    if (!is_in_group(group)) {
+        groups_.push_back(group);
+    }
+}
+
+void Node::remove_from_group(const String &group) {
+    auto it = std::find(groups_.begin(), groups_.end(), group);
+    if (it != groups_.end()) {
+        groups_.erase(it);
+    }
+}
+
+bool Node::is_in_group(const String &group) const {
+    return std::find(groups_.begin(), groups_.end(), group) != groups_.end();
+}
+
+void Node::queue_free() {
+    SceneTree *scene_tree = tree_ ? tree_ : get_scene_tree();
+    if (scene_tree) {
+        scene_tree->queue_delete(this);
+    }
+}
+
+void Node::propagate_notification(int64_t what) {
+    _notification(what);
+    // Copy the children, which may be updated by the notified nodes.
+    std::vector<Node *> children = children_;
+    for (Node *child : children) {
+        child->propagate_notification(what);
+    }
+}
+
+void Node::propagate_enter_tree(SceneTree *tree) {
+    tree_ = tree;
+    _notification(NOTIFICATION_ENTER_TREE);
+    _enter_tree();
+    std::vector<Node *> children = children_;
+    for (Node *child : children) {
+        child->propagate_enter_tree(tree);
+    }
+}
+
+void Node::propagate_exit_tree() {
+    std::vector<Node *> children = children_;
+    for (Node *child : children) {
+        child->propagate_exit_tree();
+    }
+    _exit_tree();
+    _notification(NOTIFICATION_EXIT_TREE);
+    tree_ = nullptr;
+}
+
+void Node::validate_child_name(Node *child) const {
+    if (child->name_.empty()) {
+        child->name_ = String("@Node@") + String::num_int64(child->get_instance_id());
+    }
+    for (Node *sibling : children_) {
+        if (sibling != child && sibling->name_ == child->name_) {
+            child->name_ += String::num_int64(child->get_instance_id());
+            break;
+        }
+    }
+}
+
+}  // namespace godot
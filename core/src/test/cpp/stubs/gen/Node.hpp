@@ -0,0 +1,117 @@
+#ifndef GAST_TEST_STUBS_NODE_HPP
+#define GAST_TEST_STUBS_NODE_HPP
+
+#include <core/Array.hpp>
+#include <core/NodePath.hpp>
+#include <core/String.hpp>
+#include <cstdint>
+#include <gen/Object.hpp>
+#include <vector>
+
+namespace godot {
+
+class SceneTree;
+
+/// Host stand-in for godot::Node.
+///
+/// Models the parts of the scene tree the native code relies on: the parent / children links,
+/// the paths, the groups and the deferred deletion. The _enter_tree() / _exit_tree() callbacks
+/// are invoked in the same order as Godot (parents first on enter, children first on exit), and
+/// the notifications are sent synchronously.
+///
+/// Deleting a node frees its children, after removing it from its parent. Like Godot's
+/// NOTIFICATION_PREDELETE, the subclasses with an _exit_tree() callback must remove themselves
+/// from their parent in their own destructor, while the callback can still be dispatched to them.
+class Node : public Object {
+public:
+    static constexpr int64_t NOTIFICATION_ENTER_TREE = 10;
+    static constexpr int64_t NOTIFICATION_EXIT_TREE = 11;
+    static constexpr int64_t NOTIFICATION_PATH_CHANGED = 23;
+
+    Node() = default;
+
+    ~Node() override;
+
+    String get_name() const {
+        return name_;
+    }
+
+    void set_name(const String &name);
+
+    /// Absolute path of the node, or an empty path outside of the scene tree.
+    NodePath get_path() const;
+
+    Node *get_parent() const {
+        return parent_;
+    }
+
+    Array get_children() const;
+
+    int get_child_count() const {
+        return static_cast<int>(children_.size());
+    }
+
+    void add_child(Node *node);
+
+    void remove_child(Node *node);
+
+    Node *get_node_or_null(const NodePath &path) const;
+
+    /// Only matches the exact names, the wildcards aren't supported.
+    Node *find_node(const String &mask, bool recursive = true, bool owned = true) const;
+
+    Node *get_owner() const {
+        return owner_;
+    }
+
+    void set_owner(Node *owner) {
+        owner_ = owner;
+    }
+
+    void add_to_group(const String &group);
+
+    void remove_from_group(const String &group);
+
+    bool is_in_group(const String &group) const;
+
+    bool is_inside_tree() const {
+        return tree_ != nullptr;
+    }
+
+    SceneTree *get_tree() const {
+        return tree_;
+    }
+
+    void queue_free();
+
+    virtual void _enter_tree() {}
+
+    virtual void _exit_tree() {}
+
+    virtual void _notification(int64_t what) {}
+
+protected:
+    /// Sends the given notification to the node and its descendants.
+    void propagate_notification(int64_t what);
+
+private:
+    friend class SceneTree;
+
+    void propagate_enter_tree(SceneTree *tree);
+
+    void propagate_exit_tree();
+
+    // Ensures the name is set and unique among the siblings, as Godot does when adding a child.
+    void validate_child_name(Node *child) const;
+
+    String name_;
+    Node *parent_ = nullptr;
+    Node *owner_ = nullptr;
+    std::vector<Node *> children_;
+    std::vector<String> groups_;
+    SceneTree *tree_ = nullptr;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_NODE_HPP
@@ -0,0 +1,36 @@
+#ifndef GAST_TEST_STUBS_OBJECT_HPP
+#define GAST_TEST_STUBS_OBJECT_HPP
+
+#include <cstdint>
+
+namespace godot {
+
+/// Host stand-in for godot::Object. The instance ids are unique for the process lifetime.
+class Object {
+public:
+    Object() : instance_id_(next_instance_id_++) {}
+
+    Object(const Object &) = delete;
+
+    Object &operator=(const Object &) = delete;
+
+    virtual ~Object() = default;
+
+    int64_t get_instance_id() const {
+        return instance_id_;
+    }
+
+    template<typename T>
+    static T *cast_to(const Object *object) {
+        return dynamic_cast<T *>(const_cast<Object *>(object));
+    }
+
+private:
+    static inline int64_t next_instance_id_ = 1;
+
+    int64_t instance_id_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_OBJECT_HPP
@@ -0,0 +1,52 @@
+#ifndef GAST_TEST_STUBS_RAY_CAST_HPP
+#define GAST_TEST_STUBS_RAY_CAST_HPP
+
+#include <core/Vector3.hpp>
+#include <cstdint>
+#include <gen/Spatial.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::RayCast. There's no physics engine on the host, so the ray cast
+/// never collides.
+class RayCast : public Spatial {
+public:
+    bool is_enabled() const {
+        return enabled_;
+    }
+
+    void set_enabled(bool enabled) {
+        enabled_ = enabled;
+    }
+
+    Vector3 get_cast_to() const {
+        return cast_to_;
+    }
+
+    void set_cast_to(const Vector3 &cast_to) {
+        cast_to_ = cast_to;
+    }
+
+    uint32_t get_collision_mask() const {
+        return collision_mask_;
+    }
+
+    void set_collision_mask(uint32_t collision_mask) {
+        collision_mask_ = collision_mask;
+    }
+
+    void force_raycast_update() {}
+
+    bool is_colliding() const {
+        return false;
+    }
+
+private:
+    bool enabled_ = true;
+    Vector3 cast_to_ = Vector3(0, -1, 0);
+    uint32_t collision_mask_ = 1;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_RAY_CAST_HPP
@@ -0,0 +1,26 @@
+#ifndef GAST_TEST_STUBS_REFERENCE_HPP
+#define GAST_TEST_STUBS_REFERENCE_HPP
+
+#include <gen/Object.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Reference, freed by the last Ref holding it.
+class Reference : public Object {
+public:
+    void reference() {
+        reference_count_++;
+    }
+
+    /// Returns true when the last reference is dropped, and the object must be freed.
+    bool unreference() {
+        return --reference_count_ == 0;
+    }
+
+private:
+    int reference_count_ = 0;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_REFERENCE_HPP
@@ -0,0 +1,75 @@
+#include <gen/SceneTree.hpp>
+
+#include <algorithm>
+
+namespace godot {
+
+namespace {
+Camera *find_camera(const Node *node) {
+    Array children = node->get_children();
+    for (int i = 0; i < children.size(); i++) {
+        Node *child = Object::cast_to<Node>(children[i]);
+        if (auto *camera = Object::cast_to<Camera>(child)) {
+            return camera;
+        }
+        if (Camera *camera = find_camera(child)) {
+            return camera;
+        }
+    }
+    return nullptr;
+}
+
+void collect_group(const Node *node, const String &group, Array *nodes) {
+    if (node->is_in_group(group)) {
+        nodes->append(const_cast<Node *>(node));
+    }
+    Array children = node->get_children();
+    for (int i = 0; i < children.size(); i++) {
+        collect_group(Object::cast_to<Node>(children[i]), group, nodes);
+    }
+}
+}  // namespace
+
+Camera *Viewport::get_camera() const {
+    return find_camera(this);
+}
+
+SceneTree::SceneTree() : root_(new Viewport()) {
+    root_->set_name("root");
+    root_->propagate_enter_tree(this);
+}
+
+SceneTree::~SceneTree() {
+    flush_delete_queue();
+    root_->propagate_exit_tree();
+    delete root_;
+}
+
+Array SceneTree::get_nodes_in_group(const String &group) const {
+    Array nodes;
+    collect_group(root_, group, &nodes);
+    return nodes;
+}
+
+void SceneTree::queue_delete(Node *node) {
+    if (std::find(delete_queue_.begin(), delete_queue_.end(), node) == delete_queue_.end()) {
+        delete_queue_.push_back(node);
+    }
+}
+
+void SceneTree::flush_delete_queue() {
+    while (!delete_queue_.empty()) {
+        Node *node = delete_queue_.back();
+        delete_queue_.pop_back();
+        delete node;
+    }
+}
+
+void SceneTree::cancel_delete(Node *node) {
+    auto it = std::find(delete_queue_.begin(), delete_queue_.end(), node);
+    if (it != delete_queue_.end()) {
+        delete_queue_.erase(it);
+    }
+}
+
+}  // namespace godot
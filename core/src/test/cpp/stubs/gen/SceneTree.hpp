@@ -0,0 +1,45 @@
+#ifndef GAST_TEST_STUBS_SCENE_TREE_HPP
+#define GAST_TEST_STUBS_SCENE_TREE_HPP
+
+#include <core/Array.hpp>
+#include <core/String.hpp>
+#include <gen/MainLoop.hpp>
+#include <gen/Node.hpp>
+#include <gen/Viewport.hpp>
+#include <vector>
+
+namespace godot {
+
+/// Host stand-in for godot::SceneTree, with a root viewport named "root".
+class SceneTree : public MainLoop {
+public:
+    SceneTree();
+
+    /// Frees the nodes queued for deletion, then the whole tree.
+    ~SceneTree() override;
+
+    Viewport *get_root() const {
+        return root_;
+    }
+
+    /// The nodes of the group, in tree order.
+    Array get_nodes_in_group(const String &group) const;
+
+    void queue_delete(Node *node);
+
+    // Host only
+
+    /// Frees the nodes queued for deletion, as done at the end of each frame.
+    void flush_delete_queue();
+
+    /// Invoked when a queued node is freed by other means, e.g: along its parent.
+    void cancel_delete(Node *node);
+
+private:
+    Viewport *root_;
+    std::vector<Node *> delete_queue_;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_SCENE_TREE_HPP
@@ -0,0 +1,111 @@
+#ifndef GAST_TEST_STUBS_SPATIAL_HPP
+#define GAST_TEST_STUBS_SPATIAL_HPP
+
+#include <cmath>
+#include <core/Transform.hpp>
+#include <core/Vector3.hpp>
+#include <gen/Node.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Spatial.
+///
+/// The transform notifications are sent synchronously to the node and its descendants, rather
+/// than deferred to the end of the frame.
+class Spatial : public Node {
+public:
+    static constexpr int64_t NOTIFICATION_VISIBILITY_CHANGED = 43;
+    static constexpr int64_t NOTIFICATION_TRANSFORM_CHANGED = 2000;
+
+    Transform get_transform() const {
+        return transform_;
+    }
+
+    void set_transform(const Transform &transform) {
+        transform_ = transform;
+        propagate_notification(NOTIFICATION_TRANSFORM_CHANGED);
+    }
+
+    Transform get_global_transform() const {
+        const Spatial *parent = get_parent_spatial();
+        return parent ? parent->get_global_transform() * transform_ : transform_;
+    }
+
+    void set_global_transform(const Transform &global_transform) {
+        const Spatial *parent = get_parent_spatial();
+        set_transform(parent ? parent->get_global_transform().affine_inverse() * global_transform
+                             : global_transform);
+    }
+
+    Vector3 get_translation() const {
+        return transform_.origin;
+    }
+
+    void set_translation(const Vector3 &translation) {
+        transform_.origin = translation;
+        propagate_notification(NOTIFICATION_TRANSFORM_CHANGED);
+    }
+
+    /// The basis is rebuilt from the rotation and the scale, in Godot's YXZ order.
+    void set_rotation_degrees(const Vector3 &rotation_degrees) {
+        rotation_degrees_ = rotation_degrees;
+        update_basis();
+    }
+
+    void set_scale(const Vector3 &scale) {
+        scale_ = scale;
+        update_basis();
+    }
+
+    Vector3 to_local(const Vector3 &global_point) const {
+        return get_global_transform().affine_inverse().xform(global_point);
+    }
+
+    Vector3 to_global(const Vector3 &local_point) const {
+        return get_global_transform().xform(local_point);
+    }
+
+    bool is_visible() const {
+        return visible_;
+    }
+
+    void set_visible(bool visible) {
+        if (visible_ == visible) {
+            return;
+        }
+        visible_ = visible;
+        propagate_notification(NOTIFICATION_VISIBILITY_CHANGED);
+    }
+
+    bool is_visible_in_tree() const {
+        for (const Spatial *spatial = this; spatial; spatial = spatial->get_parent_spatial()) {
+            if (!spatial->visible_) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const Spatial *get_parent_spatial() const {
+        return Object::cast_to<Spatial>(get_parent());
+    }
+
+    void update_basis() {
+        constexpr real_t kDegreesToRadians = 3.14159265358979f / 180;
+        Basis rotation = Basis(Vector3(0, 1, 0), rotation_degrees_.y * kDegreesToRadians) *
+                         Basis(Vector3(1, 0, 0), rotation_degrees_.x * kDegreesToRadians) *
+                         Basis(Vector3(0, 0, 1), rotation_degrees_.z * kDegreesToRadians);
+        transform_.basis = rotation * Basis().scaled(scale_);
+        propagate_notification(NOTIFICATION_TRANSFORM_CHANGED);
+    }
+
+    Transform transform_;
+    Vector3 rotation_degrees_;
+    Vector3 scale_ = Vector3(1, 1, 1);
+    bool visible_ = true;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_SPATIAL_HPP
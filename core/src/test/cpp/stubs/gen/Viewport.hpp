@@ -0,0 +1,18 @@
+#ifndef GAST_TEST_STUBS_VIEWPORT_HPP
+#define GAST_TEST_STUBS_VIEWPORT_HPP
+
+#include <gen/Camera.hpp>
+#include <gen/Node.hpp>
+
+namespace godot {
+
+/// Host stand-in for godot::Viewport.
+class Viewport : public Node {
+public:
+    /// The first camera in the viewport, in tree order.
+    Camera *get_camera() const;
+};
+
+}  // namespace godot
+
+#endif // GAST_TEST_STUBS_VIEWPORT_HPP
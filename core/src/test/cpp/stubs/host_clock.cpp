@@ -0,0 +1,17 @@
+#include "host_clock.h"
+
+namespace gast {
+
+namespace {
+int64_t host_clock_nanos = 1000000000LL;
+}  // namespace
+
+int64_t get_monotonic_time_nanos() {
+    return host_clock_nanos;
+}
+
+void advance_host_clock(int64_t nanos) {
+    host_clock_nanos += nanos;
+}
+
+}  // namespace gast
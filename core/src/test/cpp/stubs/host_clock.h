@@ -0,0 +1,16 @@
+#ifndef GAST_TEST_STUBS_HOST_CLOCK_H
+#define GAST_TEST_STUBS_HOST_CLOCK_H
+
+#include <cstdint>
+
+namespace gast {
+
+/// Host clock returned by get_monotonic_time_nanos() (see utils.h), which only moves when
+/// advanced by the tests. It starts past 0, which the native code uses as "no timestamp".
+int64_t get_monotonic_time_nanos();
+
+void advance_host_clock(int64_t nanos);
+
+}  // namespace gast
+
+#endif // GAST_TEST_STUBS_HOST_CLOCK_H
@@ -0,0 +1,441 @@
+#include "jni.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+_JNIEnv::_JNIEnv() : local_frames_(1) {}
+
+_JNIEnv::~_JNIEnv() {
+    while (!local_frames_.empty()) {
+        for (jobject object : local_frames_.back()) {
+            release(object);
+        }
+        local_frames_.pop_back();
+    }
+    for (auto &global_reference : global_references_) {
+        for (int i = 0; i < global_reference.second; i++) {
+            release(global_reference.first);
+        }
+    }
+}
+
+jint _JNIEnv::PushLocalFrame(jint capacity) {
+    local_frames_.emplace_back();
+    return JNI_OK;
+}
+
+jobject _JNIEnv::PopLocalFrame(jobject result) {
+    if (local_frames_.size() <= 1) {
+        report_error("PopLocalFrame: no frame to pop");
+        return nullptr;
+    }
+
+    // Keep the result alive while the frame's references are released.
+    if (result) {
+        acquire(result);
+    }
+    for (jobject object : local_frames_.back()) {
+        release(object);
+    }
+    local_frames_.pop_back();
+
+    if (!result) {
+        return nullptr;
+    }
+    add_local_reference(result);
+    release(result);
+    return result;
+}
+
+jobject _JNIEnv::NewLocalRef(jobject object) {
+    if (!object || !check_reference(object, "NewLocalRef")) {
+        return nullptr;
+    }
+    add_local_reference(object);
+    return object;
+}
+
+void _JNIEnv::DeleteLocalRef(jobject object) {
+    if (!object) {
+        return;
+    }
+
+    for (auto frame = local_frames_.rbegin(); frame != local_frames_.rend(); frame++) {
+        auto it = std::find(frame->begin(), frame->end(), object);
+        if (it != frame->end()) {
+            frame->erase(it);
+            release(object);
+            return;
+        }
+    }
+    report_error("DeleteLocalRef: invalid local reference %p", object);
+}
+
+jobject _JNIEnv::NewGlobalRef(jobject object) {
+    if (!object || !check_reference(object, "NewGlobalRef")) {
+        return nullptr;
+    }
+    global_references_[object]++;
+    acquire(object);
+    return object;
+}
+
+void _JNIEnv::DeleteGlobalRef(jobject object) {
+    if (!object) {
+        return;
+    }
+
+    auto it = global_references_.find(object);
+    if (it == global_references_.end()) {
+        report_error("DeleteGlobalRef: invalid global reference %p", object);
+        return;
+    }
+    if (--it->second == 0) {
+        global_references_.erase(it);
+    }
+    release(object);
+}
+
+jclass _JNIEnv::FindClass(const char *name) {
+    jclass clazz = new_object<_jclass>("java/lang/Class");
+    clazz->class_name = name;
+    return clazz;
+}
+
+jclass _JNIEnv::GetObjectClass(jobject object) {
+    if (!object || !check_reference(object, "GetObjectClass")) {
+        return nullptr;
+    }
+    return FindClass(object->class_name.c_str());
+}
+
+jobject _JNIEnv::AllocObject(jclass clazz) {
+    if (!clazz || !check_reference(clazz, "AllocObject")) {
+        return nullptr;
+    }
+    return new_object<_jobject>(clazz->class_name.c_str());
+}
+
+jmethodID _JNIEnv::GetMethodID(jclass clazz, const char *name, const char *signature) {
+    if (!clazz || !check_reference(clazz, "GetMethodID")) {
+        return nullptr;
+    }
+
+    for (const auto &method_id : method_ids_) {
+        if (method_id->class_name == clazz->class_name && method_id->name == name &&
+            method_id->signature == signature) {
+            return method_id.get();
+        }
+    }
+    method_ids_.push_back(std::make_unique<_jmethodID>(
+            _jmethodID{clazz->class_name, name, signature}));
+    return method_ids_.back().get();
+}
+
+void _JNIEnv::CallVoidMethod(jobject object, jmethodID method, ...) {
+    if (!object || !method || !check_reference(object, "CallVoidMethod")) {
+        report_error("CallVoidMethod: invalid receiver or method");
+        return;
+    }
+
+    // Unpack the arguments according to the method signature, e.g: "(Ljava/lang/String;IFJ)V".
+    std::vector<jvalue> arguments;
+    va_list args;
+    va_start(args, method);
+    const std::string &signature = method->signature;
+    for (size_t i = 1; i < signature.size() && signature[i] != ')'; i++) {
+        jvalue value;
+        switch (signature[i]) {
+            case 'Z':
+            case 'B':
+            case 'C':
+            case 'S':
+            case 'I':
+                value.i = va_arg(args, jint);
+                break;
+            case 'J':
+                value.j = va_arg(args, jlong);
+                break;
+            case 'F':
+                value.f = static_cast<jfloat>(va_arg(args, jdouble));
+                break;
+            case 'D':
+                value.d = va_arg(args, jdouble);
+                break;
+            default:
+                // Object or array: skip to the end of the type.
+                while (signature[i] == '[') {
+                    i++;
+                }
+                if (signature[i] == 'L') {
+                    i = signature.find(';', i);
+                }
+                value.l = va_arg(args, jobject);
+                check_reference(value.l, method->name.c_str());
+                break;
+        }
+        arguments.push_back(value);
+    }
+    va_end(args);
+
+    if (call_listener_) {
+        call_listener_(*method, arguments);
+    }
+}
+
+jstring _JNIEnv::NewStringUTF(const char *utf_chars) {
+    if (!utf_chars) {
+        return nullptr;
+    }
+    jstring string = new_object<_jstring>("java/lang/String");
+    string->utf_chars = utf_chars;
+    return string;
+}
+
+const char *_JNIEnv::GetStringUTFChars(jstring string, jboolean *is_copy) {
+    if (!string || !check_reference(string, "GetStringUTFChars")) {
+        return nullptr;
+    }
+    if (is_copy) {
+        *is_copy = JNI_FALSE;
+    }
+    pinned_elements_count_++;
+    return string->utf_chars.c_str();
+}
+
+void _JNIEnv::ReleaseStringUTFChars(jstring string, const char *utf_chars) {
+    if (check_reference(string, "ReleaseStringUTFChars") && utf_chars) {
+        pinned_elements_count_--;
+    }
+}
+
+jsize _JNIEnv::GetArrayLength(jarray array) {
+    if (!array || !check_reference(array, "GetArrayLength")) {
+        return 0;
+    }
+    if (auto *object_array = dynamic_cast<_jobjectArray *>(array)) {
+        return static_cast<jsize>(object_array->elements.size());
+    }
+    if (auto *int_array = dynamic_cast<_jintArray *>(array)) {
+        return static_cast<jsize>(int_array->elements.size());
+    }
+    if (auto *long_array = dynamic_cast<_jlongArray *>(array)) {
+        return static_cast<jsize>(long_array->elements.size());
+    }
+    if (auto *float_array = dynamic_cast<_jfloatArray *>(array)) {
+        return static_cast<jsize>(float_array->elements.size());
+    }
+    return 0;
+}
+
+jobjectArray _JNIEnv::NewObjectArray(jsize length, jclass element_class,
+                                     jobject initial_element) {
+    if (!element_class || !check_reference(element_class, "NewObjectArray")) {
+        return nullptr;
+    }
+    jobjectArray array = new_object<_jobjectArray>("[Ljava/lang/Object;");
+    array->elements.assign(length, nullptr);
+    for (jsize i = 0; i < length; i++) {
+        SetObjectArrayElement(array, i, initial_element);
+    }
+    return array;
+}
+
+jobject _JNIEnv::GetObjectArrayElement(jobjectArray array, jsize index) {
+    if (!array || !check_reference(array, "GetObjectArrayElement") || index < 0 ||
+        index >= static_cast<jsize>(array->elements.size())) {
+        return nullptr;
+    }
+    jobject element = array->elements[index];
+    if (element) {
+        add_local_reference(element);
+    }
+    return element;
+}
+
+void _JNIEnv::SetObjectArrayElement(jobjectArray array, jsize index, jobject value) {
+    if (!array || !check_reference(array, "SetObjectArrayElement") ||
+        !check_reference(value, "SetObjectArrayElement") || index < 0 ||
+        index >= static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    if (value) {
+        acquire(value);
+    }
+    if (array->elements[index]) {
+        release(array->elements[index]);
+    }
+    array->elements[index] = value;
+}
+
+jintArray _JNIEnv::NewIntArray(jsize length) {
+    jintArray array = new_object<_jintArray>("[I");
+    array->elements.assign(length, 0);
+    return array;
+}
+
+void _JNIEnv::GetIntArrayRegion(jintArray array, jsize start, jsize length, jint *buffer) {
+    if (!array || !check_reference(array, "GetIntArrayRegion") || start < 0 ||
+        start + length > static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    std::copy(array->elements.begin() + start, array->elements.begin() + start + length,
+              buffer);
+}
+
+void _JNIEnv::SetIntArrayRegion(jintArray array, jsize start, jsize length, const jint *buffer) {
+    if (!array || !check_reference(array, "SetIntArrayRegion") || start < 0 ||
+        start + length > static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    std::copy(buffer, buffer + length, array->elements.begin() + start);
+}
+
+jlongArray _JNIEnv::NewLongArray(jsize length) {
+    jlongArray array = new_object<_jlongArray>("[J");
+    array->elements.assign(length, 0);
+    return array;
+}
+
+jlong *_JNIEnv::GetLongArrayElements(jlongArray array, jboolean *is_copy) {
+    if (!array || !check_reference(array, "GetLongArrayElements")) {
+        return nullptr;
+    }
+    if (is_copy) {
+        *is_copy = JNI_FALSE;
+    }
+    pinned_elements_count_++;
+    return array->elements.data();
+}
+
+void _JNIEnv::ReleaseLongArrayElements(jlongArray array, jlong *elements, jint mode) {
+    if (check_reference(array, "ReleaseLongArrayElements") && elements && mode != JNI_COMMIT) {
+        pinned_elements_count_--;
+    }
+}
+
+void _JNIEnv::SetLongArrayRegion(jlongArray array, jsize start, jsize length,
+                                 const jlong *buffer) {
+    if (!array || !check_reference(array, "SetLongArrayRegion") || start < 0 ||
+        start + length > static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    std::copy(buffer, buffer + length, array->elements.begin() + start);
+}
+
+jfloatArray _JNIEnv::NewFloatArray(jsize length) {
+    jfloatArray array = new_object<_jfloatArray>("[F");
+    array->elements.assign(length, 0);
+    return array;
+}
+
+void _JNIEnv::GetFloatArrayRegion(jfloatArray array, jsize start, jsize length,
+                                  jfloat *buffer) {
+    if (!array || !check_reference(array, "GetFloatArrayRegion") || start < 0 ||
+        start + length > static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    std::copy(array->elements.begin() + start, array->elements.begin() + start + length,
+              buffer);
+}
+
+void _JNIEnv::SetFloatArrayRegion(jfloatArray array, jsize start, jsize length,
+                                  const jfloat *buffer) {
+    if (!array || !check_reference(array, "SetFloatArrayRegion") || start < 0 ||
+        start + length > static_cast<jsize>(array->elements.size())) {
+        return;
+    }
+    std::copy(buffer, buffer + length, array->elements.begin() + start);
+}
+
+jobject _JNIEnv::NewDirectByteBuffer(void *address, jlong capacity) {
+    DirectBuffer *buffer = new_object<DirectBuffer>("java/nio/DirectByteBuffer");
+    buffer->address = address;
+    buffer->capacity = capacity;
+    return buffer;
+}
+
+void *_JNIEnv::GetDirectBufferAddress(jobject buffer) {
+    auto *direct_buffer = dynamic_cast<DirectBuffer *>(buffer);
+    if (!direct_buffer || !check_reference(buffer, "GetDirectBufferAddress")) {
+        return nullptr;
+    }
+    return direct_buffer->address;
+}
+
+jlong _JNIEnv::GetDirectBufferCapacity(jobject buffer) {
+    auto *direct_buffer = dynamic_cast<DirectBuffer *>(buffer);
+    if (!direct_buffer || !check_reference(buffer, "GetDirectBufferCapacity")) {
+        return -1;
+    }
+    return direct_buffer->capacity;
+}
+
+int _JNIEnv::get_local_reference_count() const {
+    int count = 0;
+    for (const auto &frame : local_frames_) {
+        count += static_cast<int>(frame.size());
+    }
+    return count;
+}
+
+int _JNIEnv::get_global_reference_count() const {
+    int count = 0;
+    for (const auto &global_reference : global_references_) {
+        count += global_reference.second;
+    }
+    return count;
+}
+
+void _JNIEnv::add_local_reference(jobject object) {
+    int count = get_local_reference_count() + 1;
+    if (count > kMaxLocalReferences) {
+        report_error("Local reference table overflow (max=%d)", kMaxLocalReferences);
+    }
+    peak_local_reference_count_ = std::max(peak_local_reference_count_, count);
+    local_frames_.back().push_back(object);
+    acquire(object);
+}
+
+void _JNIEnv::acquire(jobject object) {
+    object->reference_count++;
+}
+
+void _JNIEnv::release(jobject object) {
+    if (--object->reference_count > 0) {
+        return;
+    }
+
+    if (auto *array = dynamic_cast<_jobjectArray *>(object)) {
+        for (jobject element : array->elements) {
+            if (element) {
+                release(element);
+            }
+        }
+    }
+    delete object;
+}
+
+bool _JNIEnv::check_reference(jobject object, const char *function) {
+    if (!object || global_references_.count(object) != 0) {
+        return true;
+    }
+    for (const auto &frame : local_frames_) {
+        if (std::find(frame.begin(), frame.end(), object) != frame.end()) {
+            return true;
+        }
+    }
+    report_error("%s: use of invalid reference %p", function, object);
+    return false;
+}
+
+void _JNIEnv::report_error(const char *format, ...) {
+    error_count_++;
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "JNI ERROR: ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
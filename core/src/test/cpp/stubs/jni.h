@@ -0,0 +1,268 @@
+#ifndef GAST_TEST_STUBS_JNI_H
+#define GAST_TEST_STUBS_JNI_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Host stand-in for the JNI API, covering the functions invoked by the native code.
+///
+/// The Java objects are plain host objects, and the references to them are tracked like the
+/// JVM does: the local references live in the frames pushed by PushLocalFrame() (one per call
+/// from Java, see the tests), on top of the thread's own frame which is never popped. The
+/// references created from the render thread, outside of a call from Java, are only released by
+/// DeleteLocalRef(), so they pile up unless the native code deletes them.
+///
+/// Like the JVM, at most kMaxLocalReferences local references can be live at once. Overflowing
+/// the table, or using a reference that was deleted, is reported as an error (see
+/// get_error_count()) rather than aborting the process.
+
+typedef uint8_t jboolean;
+typedef int8_t jbyte;
+typedef uint16_t jchar;
+typedef int16_t jshort;
+typedef int32_t jint;
+typedef int64_t jlong;
+typedef float jfloat;
+typedef double jdouble;
+typedef jint jsize;
+
+class _jobject {
+public:
+    virtual ~_jobject() = default;
+
+    // Name of the object's class, in the slash separated form, e.g: "java/lang/String".
+    std::string class_name;
+    // Number of references (local, global and from arrays) to the object. It's freed when the
+    // count drops to 0.
+    int reference_count = 0;
+};
+
+class _jclass : public _jobject {};
+
+class _jstring : public _jobject {
+public:
+    std::string utf_chars;
+};
+
+class _jarray : public _jobject {};
+
+class _jobjectArray : public _jarray {
+public:
+    std::vector<_jobject *> elements;
+};
+
+class _jintArray : public _jarray {
+public:
+    std::vector<jint> elements;
+};
+
+class _jlongArray : public _jarray {
+public:
+    std::vector<jlong> elements;
+};
+
+class _jfloatArray : public _jarray {
+public:
+    std::vector<jfloat> elements;
+};
+
+typedef _jobject *jobject;
+typedef _jclass *jclass;
+typedef _jstring *jstring;
+typedef _jarray *jarray;
+typedef _jobjectArray *jobjectArray;
+typedef _jintArray *jintArray;
+typedef _jlongArray *jlongArray;
+typedef _jfloatArray *jfloatArray;
+
+struct _jmethodID {
+    std::string class_name;
+    std::string name;
+    std::string signature;
+};
+typedef _jmethodID *jmethodID;
+
+union jvalue {
+    jboolean z;
+    jbyte b;
+    jchar c;
+    jshort s;
+    jint i;
+    jlong j;
+    jfloat f;
+    jdouble d;
+    jobject l;
+};
+
+#define JNIEXPORT __attribute__ ((visibility ("default")))
+#define JNICALL
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+#define JNI_OK 0
+#define JNI_ERR (-1)
+
+#define JNI_COMMIT 1
+#define JNI_ABORT 2
+
+struct _JNIEnv {
+public:
+    /// Invoked on each call of a Java method, with the method and its arguments.
+    using CallListener = std::function<void(const _jmethodID &method,
+                                            const std::vector<jvalue> &arguments)>;
+
+    static constexpr int kMaxLocalReferences = 512;
+
+    _JNIEnv();
+
+    ~_JNIEnv();
+
+    _JNIEnv(const _JNIEnv &) = delete;
+
+    _JNIEnv &operator=(const _JNIEnv &) = delete;
+
+    // References
+
+    jint PushLocalFrame(jint capacity);
+
+    jobject PopLocalFrame(jobject result);
+
+    jobject NewLocalRef(jobject object);
+
+    void DeleteLocalRef(jobject object);
+
+    jobject NewGlobalRef(jobject object);
+
+    void DeleteGlobalRef(jobject object);
+
+    // Classes, objects and methods
+
+    jclass FindClass(const char *name);
+
+    jclass GetObjectClass(jobject object);
+
+    jobject AllocObject(jclass clazz);
+
+    jmethodID GetMethodID(jclass clazz, const char *name, const char *signature);
+
+    void CallVoidMethod(jobject object, jmethodID method, ...);
+
+    // Strings
+
+    jstring NewStringUTF(const char *utf_chars);
+
+    const char *GetStringUTFChars(jstring string, jboolean *is_copy);
+
+    void ReleaseStringUTFChars(jstring string, const char *utf_chars);
+
+    // Arrays
+
+    jsize GetArrayLength(jarray array);
+
+    jobjectArray NewObjectArray(jsize length, jclass element_class, jobject initial_element);
+
+    jobject GetObjectArrayElement(jobjectArray array, jsize index);
+
+    void SetObjectArrayElement(jobjectArray array, jsize index, jobject value);
+
+    jintArray NewIntArray(jsize length);
+
+    void GetIntArrayRegion(jintArray array, jsize start, jsize length, jint *buffer);
+
+    void SetIntArrayRegion(jintArray array, jsize start, jsize length, const jint *buffer);
+
+    jlongArray NewLongArray(jsize length);
+
+    jlong *GetLongArrayElements(jlongArray array, jboolean *is_copy);
+
+    void ReleaseLongArrayElements(jlongArray array, jlong *elements, jint mode);
+
+    void SetLongArrayRegion(jlongArray array, jsize start, jsize length, const jlong *buffer);
+
+    jfloatArray NewFloatArray(jsize length);
+
+    void GetFloatArrayRegion(jfloatArray array, jsize start, jsize length, jfloat *buffer);
+
+    void SetFloatArrayRegion(jfloatArray array, jsize start, jsize length, const jfloat *buffer);
+
+    // Direct buffers
+
+    jobject NewDirectByteBuffer(void *address, jlong capacity);
+
+    void *GetDirectBufferAddress(jobject buffer);
+
+    jlong GetDirectBufferCapacity(jobject buffer);
+
+    // Host only
+
+    void set_call_listener(CallListener listener) {
+        call_listener_ = std::move(listener);
+    }
+
+    /// Number of live local references, in all the frames.
+    int get_local_reference_count() const;
+
+    /// Highest number of live local references since the last reset.
+    int get_peak_local_reference_count() const {
+        return peak_local_reference_count_;
+    }
+
+    void reset_peak_local_reference_count() {
+        peak_local_reference_count_ = get_local_reference_count();
+    }
+
+    int get_global_reference_count() const;
+
+    /// Number of string and array elements acquired and not released yet.
+    int get_pinned_elements_count() const {
+        return pinned_elements_count_;
+    }
+
+    /// Number of local reference table overflows and invalid references used.
+    int get_error_count() const {
+        return error_count_;
+    }
+
+private:
+    class DirectBuffer : public _jobject {
+    public:
+        void *address = nullptr;
+        jlong capacity = 0;
+    };
+
+    template<typename T>
+    T *new_object(const char *class_name) {
+        T *object = new T();
+        object->class_name = class_name;
+        add_local_reference(object);
+        return object;
+    }
+
+    void add_local_reference(jobject object);
+
+    void acquire(jobject object);
+
+    void release(jobject object);
+
+    // Whether `object` is null or a live local or global reference. Reports an error otherwise.
+    bool check_reference(jobject object, const char *function);
+
+    void report_error(const char *format, ...);
+
+    std::vector<std::vector<jobject>> local_frames_;
+    std::map<jobject, int> global_references_;
+    std::vector<std::unique_ptr<_jmethodID>> method_ids_;
+    int peak_local_reference_count_ = 0;
+    int pinned_elements_count_ = 0;
+    int error_count_ = 0;
+    CallListener call_listener_;
+};
+
+typedef _JNIEnv JNIEnv;
+
+#endif // GAST_TEST_STUBS_JNI_H
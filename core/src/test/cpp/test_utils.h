@@ -0,0 +1,60 @@
+#ifndef GAST_TEST_UTILS_H
+#define GAST_TEST_UTILS_H
+
+#include <cmath>
+#include <cstdio>
+
+/// Minimal assertion helpers for the host tests. The failures are reported to stderr, and
+/// GAST_TEST_RESULT() turns them into the process exit status.
+
+namespace gast_test {
+
+inline int &failure_count() {
+    static int count = 0;
+    return count;
+}
+
+}  // namespace gast_test
+
+#define EXPECT_TRUE(_cond)                                                                  \
+    do {                                                                                    \
+        if (!(_cond)) {                                                                     \
+            fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, #_cond);            \
+            gast_test::failure_count()++;                                                   \
+        }                                                                                   \
+    } while (0)
+
+#define EXPECT_FALSE(_cond) EXPECT_TRUE(!(_cond))
+
+#define EXPECT_EQ(_expected, _actual)                                                       \
+    do {                                                                                    \
+        if (!((_expected) == (_actual))) {                                                  \
+            fprintf(stderr, "%s:%d: expected %s == %s\n", __FILE__, __LINE__, #_expected,   \
+                    #_actual);                                                              \
+            gast_test::failure_count()++;                                                   \
+        }                                                                                   \
+    } while (0)
+
+#define EXPECT_NEAR(_expected, _actual, _tolerance)                                         \
+    do {                                                                                    \
+        double _expected_value = (_expected);                                               \
+        double _actual_value = (_actual);                                                   \
+        if (std::abs(_expected_value - _actual_value) > (_tolerance)) {                     \
+            fprintf(stderr, "%s:%d: expected %s == %s (%f vs %f)\n", __FILE__, __LINE__,    \
+                    #_expected, #_actual, _expected_value, _actual_value);                  \
+            gast_test::failure_count()++;                                                   \
+        }                                                                                   \
+    } while (0)
+
+/// Runs the given test function, reporting its name.
+#define RUN_TEST(_test)                                                                     \
+    do {                                                                                    \
+        int _failures_before = gast_test::failure_count();                                  \
+        _test();                                                                            \
+        fprintf(stderr, "[%s] %s\n",                                                        \
+                gast_test::failure_count() == _failures_before ? "  OK  " : "FAILED", #_test); \
+    } while (0)
+
+#define GAST_TEST_RESULT() (gast_test::failure_count() == 0 ? 0 : 1)
+
+#endif // GAST_TEST_UTILS_H